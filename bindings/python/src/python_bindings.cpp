@@ -146,6 +146,17 @@ PYBIND11_MODULE(PYSVS_MODULE_NAME, m) {
         []() { return svs::lib::svs_version.str(); },
         "Obtain the version string of the backing C++ library."
     );
+    m.def(
+        "distance_isa",
+        []() { return std::string(svs::distance::name(svs::distance::active_isa())); },
+        R"(
+Obtain the instruction set used by the distance kernels. One of "generic", "avx2",
+"avx512f" or "avx512vnni".
+
+The instruction set is selected at load time based on the host CPU and may be lowered by
+setting the environment variable ``SVS_DISTANCE_ISA`` to one of the values above.
+        )"
+    );
 
     py::enum_<svs::DistanceType>(m, "DistanceType", "Select which distance function to use")
         .value("L2", svs::DistanceType::L2, "Euclidean Distance (minimize)")
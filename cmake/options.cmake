@@ -71,6 +71,8 @@ if (SVS_NO_AVX512)
     # AVX512F is the base for the AVX512 instruction set.
     # Adding the `-mno-avx512f` flag will disable all AVX512 dependent instructions.
     target_compile_options(${SVS_LIB} INTERFACE -mno-avx512f)
+    # Also exclude the AVX512 distance kernels from runtime dispatch.
+    target_compile_definitions(${SVS_LIB} INTERFACE -DSVS_NO_AVX512)
 endif()
 
 if (SVS_CHECK_BOUNDS)
@@ -32,6 +32,8 @@
 #include "svs/lib/narrow.h"
 
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <fcntl.h>
 #include <filesystem>
 #include <linux/mman.h>
@@ -342,6 +344,41 @@ class MemoryMapper {
     /// @brief Permissions for the memory map.
     enum Permission { ReadOnly, ReadWrite };
 
+    /// @brief Access pattern hints forwarded to ``madvise`` after mapping.
+    enum Advice {
+        /// Do not call ``madvise``.
+        NoAdvice,
+        /// Expect random page references (e.g., graph search).
+        Random,
+        /// Expect sequential page references.
+        Sequential,
+        /// Start reading the whole file into the page cache asynchronously.
+        WillNeed,
+        /// Request transparent huge pages for the mapping where the kernel supports it.
+        Hugepage
+    };
+
+    static constexpr int madvise_flags(Advice advice) {
+        switch (advice) {
+            case NoAdvice: {
+                return MADV_NORMAL;
+            }
+            case Random: {
+                return MADV_RANDOM;
+            }
+            case Sequential: {
+                return MADV_SEQUENTIAL;
+            }
+            case WillNeed: {
+                return MADV_WILLNEED;
+            }
+            case Hugepage: {
+                return MADV_HUGEPAGE;
+            }
+        }
+        throw ANNEXCEPTION("Unreachable");
+    }
+
     static constexpr int open_permissions(Permission permission) {
         switch (permission) {
             case ReadOnly: {
@@ -369,6 +406,34 @@ class MemoryMapper {
   private:
     Permission permission_{ReadOnly};
     Policy policy_{MustUseExisting};
+    bool populate_{true};
+    Advice advice_{NoAdvice};
+    size_t alignment_{0};
+
+    // Reserve an address range of ``bytes`` aligned to ``alignment_``.
+    // Returns ``nullptr`` if no alignment is requested.
+    void* reserve_aligned(size_t bytes) const {
+        if (alignment_ == 0) {
+            return nullptr;
+        }
+        size_t reserved = bytes + alignment_;
+        void* base =
+            ::mmap(nullptr, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            throw ANNEXCEPTION("Could not reserve ", reserved, " bytes of address space!");
+        }
+        auto start = reinterpret_cast<uintptr_t>(base);
+        auto aligned = lib::round_up_to_multiple_of(start, alignment_);
+        // Release the unused head and tail of the reservation.
+        if (aligned != start) {
+            munmap(base, aligned - start);
+        }
+        size_t tail = start + reserved - (aligned + bytes);
+        if (tail != 0) {
+            munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
 
   public:
     ///
@@ -390,6 +455,37 @@ class MemoryMapper {
     Permission permission() const { return permission_; }
     void setpermission(Permission permission) { permission_ = permission; }
 
+    ///
+    /// @brief Control whether page tables are populated eagerly with ``MAP_POPULATE``.
+    ///
+    /// Populating blocks until the whole file is resident but avoids page faults later.
+    /// Disable to make mapping return immediately and fault pages in on first access.
+    ///
+    bool populate() const { return populate_; }
+    void setpopulate(bool populate) { populate_ = populate; }
+
+    /// @brief Access pattern hint passed to ``madvise`` after the mapping is established.
+    Advice advice() const { return advice_; }
+    void setadvice(Advice advice) { advice_ = advice; }
+
+    ///
+    /// @brief Alignment in bytes of the virtual address at which files are mapped.
+    ///
+    /// The kernel can only back file mappings with huge pages if the file offsets and the
+    /// virtual addresses are congruent modulo the huge page size. Setting this to the huge
+    /// page size (e.g., 2 MiB) makes the mapping eligible. A value of zero leaves the
+    /// choice of address to the kernel. Must be zero or a power of two multiple of the
+    /// page size.
+    ///
+    size_t alignment() const { return alignment_; }
+    void setalignment(size_t alignment) {
+        auto pagesize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        if (alignment != 0 && (!std::has_single_bit(alignment) || alignment < pagesize)) {
+            throw ANNEXCEPTION("Invalid memory map alignment ", alignment, '!');
+        }
+        alignment_ = alignment;
+    }
+
     // Allocation
     MMapPtr<void> mmap(const std::filesystem::path& filename, lib::Bytes bytes) const {
         bool exists = std::filesystem::exists(filename);
@@ -450,22 +546,38 @@ class MemoryMapper {
             }
         }
         lseek(fd, 0, SEEK_SET);
-        void* base = ::mmap(
-            nullptr,
-            value(bytes),
-            mmap_permissions(permission_),
-            MAP_NORESERVE       // Don't reserve space in DRAM for this until used
-                | MAP_SHARED    // Accessible from all processes
-                | MAP_POPULATE, // Populate page table entries in the DRAM
-            fd,
-            0
-        );
+        void* hint = nullptr;
+        try {
+            hint = reserve_aligned(value(bytes));
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        int flags = MAP_NORESERVE // Don't reserve space in DRAM for this until used
+                    | MAP_SHARED; // Accessible from all processes
+        if (populate_) {
+            flags |= MAP_POPULATE; // Populate page table entries in the DRAM
+        }
+        if (hint != nullptr) {
+            flags |= MAP_FIXED; // Replace the aligned reservation
+        }
+        void* base =
+            ::mmap(hint, value(bytes), mmap_permissions(permission_), flags, fd, 0);
         close(fd);
 
         if (base == nullptr || base == MAP_FAILED) {
+            if (hint != nullptr) {
+                munmap(hint, value(bytes));
+            }
             throw ANNEXCEPTION("Memory Map Failed!");
         }
-        return MMapPtr<void>(base, value(bytes));
+        auto ptr = MMapPtr<void>(base, value(bytes));
+        // Advice is only a hint. Failure (e.g., huge pages unsupported for this file
+        // system) leaves the mapping fully functional.
+        if (advice_ != NoAdvice) {
+            madvise(base, value(bytes), madvise_flags(advice_));
+        }
+        return ptr;
     }
 };
 
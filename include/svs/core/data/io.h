@@ -14,6 +14,7 @@
 #include "svs/core/data/abstract_io.h"
 #include "svs/core/data/block.h"
 #include "svs/core/data/simple.h"
+#include "svs/core/data/view.h"
 #include "svs/core/io.h"
 
 #include "svs/lib/array.h"
@@ -22,6 +23,9 @@
 #include "svs/lib/meta.h"
 #include "svs/lib/misc.h"
 
+// stl
+#include <algorithm>
+
 namespace svs::io {
 
 namespace detail {
@@ -43,19 +47,25 @@ inline void static_size_check(size_t expected, size_t actual) {
 /////
 
 // Generic dataset loading.
+// Builders that can construct a dataset directly from the file (e.g., by memory mapping)
+// are given the opportunity to do so. Otherwise, the dataset is allocated and populated.
 template <typename T, size_t Extent, typename File, typename Builder>
 typename Builder::template return_type<T, Extent>
 load_impl(const File& file, const Builder& builder) {
-    auto [vectors_to_read, ndims] = file.get_dims();
+    if constexpr (requires { builder.template load<T, Extent>(file); }) {
+        return builder.template load<T, Extent>(file);
+    } else {
+        auto [vectors_to_read, ndims] = file.get_dims();
 
-    // Size check to throw an error early.
-    if constexpr (Extent != Dynamic) {
-        detail::static_size_check(Extent, ndims);
-    }
+        // Size check to throw an error early.
+        if constexpr (Extent != Dynamic) {
+            detail::static_size_check(Extent, ndims);
+        }
 
-    auto data = data::build<T, Extent>(builder, vectors_to_read, ndims);
-    populate(data, file);
-    return data;
+        auto data = data::build<T, Extent>(builder, vectors_to_read, ndims);
+        populate(data, file);
+        return data;
+    }
 }
 
 namespace detail {
@@ -109,4 +119,93 @@ auto auto_load(
     }
 }
 
+/////
+///// Chunked Dataset Streaming
+/////
+
+namespace detail {
+template <typename T, size_t Extent, typename File, typename F>
+void for_each_chunk_impl(
+    const File& file, size_t chunk_size, F& f, lib::PriorityTag<0> SVS_UNUSED(tag)
+) {
+    auto [num_vectors, ndims] = file.get_dims();
+    if constexpr (Extent != Dynamic) {
+        static_size_check(Extent, ndims);
+    }
+
+    auto buffer = data::SimpleData<T, Extent>(std::min(chunk_size, num_vectors), ndims);
+    size_t start = 0;
+    size_t count = 0;
+    auto flush = [&]() {
+        f(data::make_const_view(buffer, threads::UnitRange<size_t>(0, count)), start);
+        start += count;
+        count = 0;
+    };
+
+    auto reader = file.reader(lib::meta::Type<T>());
+    for (auto v : reader) {
+        buffer.set_datum(count, v);
+        ++count;
+        if (count == buffer.size()) {
+            flush();
+        }
+    }
+    if (count != 0) {
+        flush();
+    }
+}
+
+// Intercept the native file to perform dispatch on the actual file type.
+template <typename T, size_t Extent, typename F>
+void for_each_chunk_impl(
+    const NativeFile& file, size_t chunk_size, F& f, lib::PriorityTag<1> tag
+) {
+    file.resolve([&](const auto& resolved_file) {
+        for_each_chunk_impl<T, Extent>(resolved_file, chunk_size, f, tag.next());
+    });
+}
+} // namespace detail
+
+///
+/// @brief Stream the contents of ``file`` in consecutive chunks.
+///
+/// @tparam T The element type of the vector components in the file.
+/// @tparam Extent The compile-time dimensionality of the dataset.
+///
+/// @param file The file to read.
+/// @param chunk_size The maximum number of vectors held in memory at a time.
+/// @param f Callable invoked as ``f(chunk, start)`` for each chunk where ``chunk`` is an
+///     immutable dataset containing the vectors ``[start, start + chunk.size())`` of the
+///     file. The chunk is only valid for the duration of the call.
+///
+template <typename T, size_t Extent = Dynamic, typename File, typename F>
+void for_each_chunk(const File& file, size_t chunk_size, F&& f) {
+    if (chunk_size == 0) {
+        throw ANNEXCEPTION("Chunk size must be non-zero!");
+    }
+    detail::for_each_chunk_impl<T, Extent>(
+        detail::to_native(file), chunk_size, f, lib::PriorityTag<1>()
+    );
+}
+
+///
+/// @brief Stream the contents of a file in consecutive chunks. Automatically detect the
+///     file type based on extension.
+///
+/// See ``svs::io::auto_load`` for the recognized file extensions and
+/// ``svs::io::for_each_chunk`` for a description of the arguments.
+///
+template <typename T, size_t Extent = Dynamic, typename F>
+void auto_for_each_chunk(const std::string& filename, size_t chunk_size, F&& f) {
+    if (filename.ends_with("svs")) {
+        for_each_chunk<T, Extent>(io::NativeFile(filename), chunk_size, f);
+    } else if (filename.ends_with("vecs")) {
+        for_each_chunk<T, Extent>(io::vecs::VecsFile<T>(filename), chunk_size, f);
+    } else if (filename.ends_with("bin")) {
+        for_each_chunk<T, Extent>(io::binary::BinaryFile(filename), chunk_size, f);
+    } else {
+        throw ANNEXCEPTION("Unknown file extension for input file: ", filename, ".");
+    }
+}
+
 } // namespace svs::io
@@ -532,6 +532,76 @@ template <typename Allocator = lib::DefaultAllocator> class PolymorphicBuilder {
     Allocator allocator_{};
 };
 
+///
+/// @brief Builder that memory maps datasets directly from files on disk.
+///
+/// Datasets loaded from memory-map compatible files (the native SVS file format) are not
+/// copied. Instead, the file is mapped with ``MAP_SHARED`` using the configured
+/// ``svs::MemoryMapper``. Multiple processes mapping the same file share a single copy in
+/// the page cache, and loading a file that is already cached completes almost instantly.
+///
+/// By default, files are mapped read-only. Mutating a dataset obtained in this way is
+/// undefined behavior. Datasets that are not loaded from a compatible file (including
+/// those created with ``build``) are allocated using the ``HugepageAllocator``.
+///
+class MemoryMapBuilder {
+  public:
+    MemoryMapBuilder() = default;
+    explicit MemoryMapBuilder(const MemoryMapper& mapper)
+        : mapper_{mapper} {}
+
+    template <typename T, size_t Extent = Dynamic>
+    using return_type = data::SimplePolymorphicData<T, Extent>;
+
+    // Allocate a ``data::SimplePolymorphicData`` of an appropriate size.
+    template <typename T, size_t Extent = Dynamic>
+    return_type<T, Extent> build(size_t size, size_t dimensions) const {
+        return data::SimplePolymorphicData<T, Extent>(
+            HugepageAllocator(), size, dimensions
+        );
+    }
+
+    ///
+    /// @brief Memory map the dataset contained in ``file``.
+    ///
+    /// Only participates for files providing an ``mmap`` method.
+    ///
+    template <typename T, size_t Extent = Dynamic, typename File>
+        requires requires(const File& file, lib::Bytes bytes, const MemoryMapper& mapper) {
+            file.mmap(lib::meta::Type<T>(), bytes, mapper);
+        }
+    return_type<T, Extent> load(const File& file) const {
+        auto [num_vectors, dimensions] = file.get_dims();
+        if constexpr (Extent != Dynamic) {
+            if (dimensions != Extent) {
+                throw ANNEXCEPTION(
+                    "Trying to memory map a dataset with dimension ",
+                    dimensions,
+                    " into a dataset with static extent ",
+                    Extent,
+                    '!'
+                );
+            }
+        }
+        auto bytes = lib::Bytes(sizeof(T) * num_vectors * dimensions);
+        auto ptr = file.mmap(lib::meta::Type<T>(), bytes, mapper_);
+        using dim_type = typename return_type<T, Extent>::dim_type;
+        return return_type<T, Extent>(DenseArray<T, dim_type, decltype(ptr)>(
+            std::move(ptr), num_vectors, meta::forward_extent<Extent>(dimensions)
+        ));
+    }
+
+    // Pre-processing hook during reloading.
+    // Nothing to do for the MemoryMapBuilder.
+    void load_hook(const toml::table&) const {}
+
+    /// @brief Return the memory mapper used for loading.
+    const MemoryMapper& mapper() const { return mapper_; }
+
+  private:
+    MemoryMapper mapper_{};
+};
+
 template <typename Builder, typename T, size_t Extent>
 using builder_return_type = typename Builder::template return_type<T, Extent>;
 
@@ -12,6 +12,7 @@
 #pragma once
 
 // svs
+#include "svs/core/distance/dispatch.h"
 #include "svs/core/distance/distance_core.h"
 #include "svs/core/distance/simd_utils.h"
 #include "svs/lib/saveload.h"
@@ -170,6 +171,19 @@ float generic_cosine_similarity(
     return result / (a_norm * std::sqrt(accum));
 };
 
+// Kernel family for runtime dispatch. The primary template is intentionally empty.
+// Each instruction set with an accelerated implementation for a type pair provides a
+// partial specialization. See "svs/core/distance/dispatch.h".
+template <ISA Arch, size_t N, typename Ea, typename Eb> struct CosineSimilarityKernel {};
+
+template <size_t N, typename Ea, typename Eb>
+struct CosineSimilarityKernel<ISA::generic, N, Ea, Eb> {
+    static float
+    compute(const Ea* a, const Eb* b, float a_norm, lib::MaybeStatic<N> length) {
+        return generic_cosine_similarity(a, b, a_norm, length);
+    }
+};
+
 template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
     static float compute(
         const Ea* a,
@@ -177,7 +191,7 @@ template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
         float a_norm,
         lib::MaybeStatic<N> length = lib::MaybeStatic<N>()
     ) {
-        return generic_cosine_similarity(a, b, a_norm, length);
+        return dispatch<CosineSimilarityKernel, N, Ea, Eb>(a, b, a_norm, length);
     }
 };
 
@@ -185,12 +199,10 @@ template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
 ///// AVX512 Implementations
 /////
 
-#if defined(__AVX512F__)
 
 // Small Integers
-#if defined(__AVX512VNNI__)
-template <size_t N> struct CosineSimilarityImpl<N, int8_t, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512vnni, N, int8_t, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512VNNI static float
     compute(const int8_t* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
         auto bnorm_accum = _mm512_setzero_epi32();
@@ -215,8 +227,8 @@ template <size_t N> struct CosineSimilarityImpl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, uint8_t, uint8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512vnni, N, uint8_t, uint8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512VNNI static float
     compute(const uint8_t* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
         auto bnorm_accum = _mm512_setzero_epi32();
@@ -239,56 +251,10 @@ template <size_t N> struct CosineSimilarityImpl<N, uint8_t, uint8_t> {
         return lib::narrow_cast<float>(_mm512_reduce_add_epi32(sum)) / (a_norm * b_norm);
     }
 };
-#elif defined(__AVX512BW__) && defined(__KNCNI__)
-template <size_t N> struct CosineSimilarityImpl<N, int8_t, int8_t> {
-    SVS_NOINLINE static float
-    compute(const int8_t* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto sum = _mm512_setzero_epi32();
-        auto bnorm_accum = _mm512_setzero_epi32();
-        auto mask = create_mask<16>(length);
-        auto all = no_mask<16>();
-
-        for (size_t j = 0; j < length.size(); j += 16) {
-            auto temp_a1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, a + j);
-            auto va = _mm512_cvtepi8_epi32(temp_a1);
-
-            auto temp_b1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, b + j);
-            auto vb = _mm512_cvtepi8_epi32(temp_b1);
-
-            bnorm_accum = _mm512_fmadd_epi32(vb, vb, bnorm_accum);
-            sum = _mm512_fmadd_epi32(va, vb, sum);
-        }
-        float b_norm = std::sqrt(static_cast<float>(_mm512_reduce_add_epi32(bnorm_accum)));
-        return _mm512_reduce_add_epi32(sum) / (a_norm * b_norm);
-    }
-};
-
-template <size_t N> struct CosineSimilarityImpl<N, uint8_t, uint8_t> {
-    SVS_NOINLINE static float
-    compute(const uint8_t* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto sum = _mm512_setzero_epi32();
-        auto bnorm_accum = _mm512_setzero_epi32();
-        auto mask = create_mask<16>(length);
-        auto all = no_mask<16>();
-
-        for (size_t j = 0; j < length.size(); j += 16) {
-            auto temp_a1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, a + j);
-            auto va = _mm512_cvtepu8_epi32(temp_a1);
-
-            auto temp_b1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, b + j);
-            auto vb = _mm512_cvtepu8_epi32(temp_b1);
-            bnorm_accum = _mm512_fmadd_epi32(vb, vb, bnorm_accum);
-            sum = _mm512_fmadd_epi32(va, vb, sum);
-        }
-        float b_norm = std::sqrt(static_cast<float>(_mm512_reduce_add_epi32(bnorm_accum)));
-        return _mm512_reduce_add_epi32(sum) / (a_norm * b_norm);
-    }
-};
-#endif
 
 // Floating and Mixed Types
-template <size_t N> struct CosineSimilarityImpl<N, float, float> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512f, N, float, float> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const float* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto bnorm_accum = _mm512_setzero_ps();
@@ -305,8 +271,8 @@ template <size_t N> struct CosineSimilarityImpl<N, float, float> {
     }
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, float, uint8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512f, N, float, uint8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto bnorm_accum = _mm512_setzero_ps();
@@ -325,8 +291,8 @@ template <size_t N> struct CosineSimilarityImpl<N, float, uint8_t> {
     };
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, float, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512f, N, float, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto bnorm_accum = _mm512_setzero_ps();
@@ -345,8 +311,8 @@ template <size_t N> struct CosineSimilarityImpl<N, float, int8_t> {
     };
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, float, Float16> {
-    SVS_NOINLINE static float
+template <size_t N> struct CosineSimilarityKernel<ISA::avx512f, N, float, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const Float16* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto bnorm_accum = _mm512_setzero_ps();
@@ -365,5 +331,4 @@ template <size_t N> struct CosineSimilarityImpl<N, float, Float16> {
         return _mm512_reduce_add_ps(sum) / (a_norm * b_norm);
     }
 };
-#endif
 } // namespace svs::distance
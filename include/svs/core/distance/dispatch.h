@@ -0,0 +1,188 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+///
+/// Runtime dispatch for the distance kernels.
+///
+/// Each accelerated kernel is compiled with a function-level ``target`` attribute rather
+/// than relying on the global ``-march`` flags. This allows a single generic x86-64 build
+/// to carry the AVX2, AVX512F and AVX512VNNI implementations side-by-side. The fastest
+/// implementation supported by the host is selected once at load time.
+///
+/// The selection can be lowered (but never raised beyond what the host supports) by
+/// setting the environment variable ``SVS_DISTANCE_ISA`` to one of ``generic``, ``avx2``,
+/// ``avx512f`` or ``avx512vnni`` before the first distance computation, or at any time
+/// using ``svs::distance::set_active_isa``.
+///
+
+namespace svs::distance {
+
+///
+/// @brief The instruction set extensions for which accelerated kernels are provided.
+///
+/// Levels are strictly ordered. Each level implies support for all lower levels.
+///
+enum class ISA : uint8_t { generic = 0, avx2 = 1, avx512f = 2, avx512vnni = 3 };
+
+///
+/// @brief Return the canonical name of the instruction set level.
+///
+inline constexpr std::string_view name(ISA isa) {
+    switch (isa) {
+        case ISA::generic: {
+            return "generic";
+        }
+        case ISA::avx2: {
+            return "avx2";
+        }
+        case ISA::avx512f: {
+            return "avx512f";
+        }
+        case ISA::avx512vnni: {
+            return "avx512vnni";
+        }
+    }
+    throw ANNEXCEPTION("Unhandled ISA!");
+}
+
+///
+/// @brief Parse the instruction set level from its canonical name.
+///
+/// Returns an empty optional if ``str`` is not recognized.
+///
+inline std::optional<ISA> parse_isa(std::string_view str) {
+    for (auto isa : {ISA::generic, ISA::avx2, ISA::avx512f, ISA::avx512vnni}) {
+        if (str == name(isa)) {
+            return isa;
+        }
+    }
+    return std::nullopt;
+}
+
+///
+/// @brief Return the highest instruction set level supported by the host CPU.
+///
+inline ISA detect_isa() {
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (!avx2) {
+        return ISA::generic;
+    }
+#if !defined(SVS_NO_AVX512)
+    bool avx512f = __builtin_cpu_supports("avx512f") &&
+                   __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+    if (avx512f) {
+        return __builtin_cpu_supports("avx512vnni") ? ISA::avx512vnni : ISA::avx512f;
+    }
+#endif
+    return ISA::avx2;
+}
+
+namespace detail {
+inline ISA initial_isa() {
+    auto isa = detect_isa();
+    const char* requested = std::getenv("SVS_DISTANCE_ISA");
+    if (requested != nullptr) {
+        if (auto parsed = parse_isa(requested); parsed.has_value()) {
+            isa = std::min(isa, *parsed);
+        }
+    }
+    return isa;
+}
+
+// Initialized during static initialization of the first translation unit including this
+// header, so reads in the distance kernels never race with the detection.
+inline std::atomic<ISA> active_isa_{initial_isa()};
+} // namespace detail
+
+///
+/// @brief Return the instruction set level used by the distance kernels.
+///
+inline ISA active_isa() { return detail::active_isa_.load(std::memory_order_relaxed); }
+
+///
+/// @brief Change the instruction set level used by the distance kernels.
+///
+/// The requested level is clamped to the highest level supported by the host.
+///
+/// @returns The instruction set level that is now active.
+///
+inline ISA set_active_isa(ISA isa) {
+    isa = std::min(isa, detect_isa());
+    detail::active_isa_.store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+///
+/// @brief Return ``true`` if ``Kernel`` provides an implementation.
+///
+/// Kernel families are defined as an empty primary template which is partially
+/// specialized with a static ``compute`` method for each instruction set level and type
+/// combination that has an accelerated implementation.
+///
+template <typename Kernel>
+inline constexpr bool has_kernel_v = requires { &Kernel::compute; };
+
+///
+/// @brief Invoke the best kernel available for the active instruction set level.
+///
+/// @tparam Kernel Template for the kernel family ``Kernel<ISA, N, Ea, Eb>``.
+///     The ``ISA::generic`` instantiation must always be defined.
+///
+/// Levels without an accelerated implementation for the given type pair fall through to
+/// the next lower level.
+///
+template <
+    template <ISA, size_t, typename, typename>
+    typename Kernel,
+    size_t N,
+    typename Ea,
+    typename Eb,
+    typename... Args>
+auto dispatch(const Args&... args) {
+    switch (active_isa()) {
+        case ISA::avx512vnni:
+            if constexpr (has_kernel_v<Kernel<ISA::avx512vnni, N, Ea, Eb>>) {
+                return Kernel<ISA::avx512vnni, N, Ea, Eb>::compute(args...);
+            }
+            [[fallthrough]];
+        case ISA::avx512f:
+            if constexpr (has_kernel_v<Kernel<ISA::avx512f, N, Ea, Eb>>) {
+                return Kernel<ISA::avx512f, N, Ea, Eb>::compute(args...);
+            }
+            [[fallthrough]];
+        case ISA::avx2:
+            if constexpr (has_kernel_v<Kernel<ISA::avx2, N, Ea, Eb>>) {
+                return Kernel<ISA::avx2, N, Ea, Eb>::compute(args...);
+            }
+            [[fallthrough]];
+        case ISA::generic:
+            break;
+    }
+    return Kernel<ISA::generic, N, Ea, Eb>::compute(args...);
+}
+
+} // namespace svs::distance
@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/data.h"
+#include "svs/concepts/distance.h"
+#include "svs/core/distance/euclidean.h"
+#include "svs/core/distance/inner_product.h"
+#include "svs/lib/static.h"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+namespace svs::distance {
+
+///
+/// @brief The number of dataset elements gathered for each call to a batched kernel.
+///
+/// Callers collecting IDs on the stack before calling ``compute_gathered`` may use this
+/// as their block size.
+///
+inline constexpr size_t gather_block_size = 16;
+
+namespace detail {
+
+// Map distance functors to the entry points of their batched kernels.
+template <typename Dist> struct BatchedKernelFor {
+    using type = void;
+};
+template <> struct BatchedKernelFor<DistanceL2> {
+    using type = L2;
+};
+template <> struct BatchedKernelFor<DistanceIP> {
+    using type = IP;
+};
+
+template <typename T> struct GatherSpan {
+    static constexpr bool value = false;
+};
+template <typename T, size_t Extent> struct GatherSpan<std::span<T, Extent>> {
+    static constexpr bool value = true;
+    using element_type = std::remove_const_t<T>;
+    static constexpr size_t extent = Extent;
+};
+
+// Batched kernels require spans on both sides with a statically compatible extent.
+template <typename Dist, typename Query, typename Datum>
+inline constexpr bool use_batched_kernel = [] {
+    using A = GatherSpan<Query>;
+    using B = GatherSpan<Datum>;
+    if constexpr (
+        std::is_void_v<typename BatchedKernelFor<Dist>::type> || !A::value || !B::value
+    ) {
+        return false;
+    } else {
+        return A::extent == Dynamic || B::extent == Dynamic || A::extent == B::extent;
+    }
+}();
+
+} // namespace detail
+
+///
+/// @brief Compute the distances between ``query`` and the dataset elements ``ids``.
+///
+/// @param f The distance functor. Must already be fixed for ``query`` if required.
+/// @param query The query.
+/// @param data The dataset.
+/// @param ids The IDs of the dataset elements to compare with ``query``.
+/// @param result Destination for the distances. Must be at least as long as ``ids``.
+/// @param mode The access mode used to retrieve dataset elements.
+///
+/// Equivalent to calling ``distance::compute(f, query, data.get_datum(id, mode))`` for
+/// each ID. When ``f`` is ``DistanceL2`` or ``DistanceIP`` and the elements of ``data``
+/// are spans (such as for ``SimpleData``), the elements are gathered into blocks and
+/// scored by a batched kernel, which computes the distances of several elements together
+/// and shares each load of the query between them. Other combinations are scored one at
+/// a time.
+///
+template <
+    typename Dist,
+    typename Query,
+    data::ImmutableMemoryDataset Data,
+    std::integral I,
+    data::AccessMode Mode>
+void compute_gathered(
+    Dist& f,
+    const Query& query,
+    const Data& data,
+    std::span<const I> ids,
+    std::span<float> result,
+    Mode mode
+) {
+    assert(result.size() >= ids.size());
+    using datum_type = std::remove_cvref_t<decltype(data.get_datum(ids[0], mode))>;
+    using dist_type = std::remove_cvref_t<Dist>;
+    if constexpr (detail::use_batched_kernel<dist_type, Query, datum_type>) {
+        using kernel = typename detail::BatchedKernelFor<dist_type>::type;
+        using Eb = typename detail::GatherSpan<datum_type>::element_type;
+        constexpr size_t extent = lib::extract_extent(
+            detail::GatherSpan<Query>::extent, detail::GatherSpan<datum_type>::extent
+        );
+
+        auto pointers = std::array<const Eb*, gather_block_size>();
+        for (size_t start = 0, stop = ids.size(); start < stop;
+             start += gather_block_size) {
+            size_t count = std::min(gather_block_size, stop - start);
+            for (size_t i = 0; i < count; ++i) {
+                auto datum = data.get_datum(ids[start + i], mode);
+                assert(datum.size() == query.size());
+                pointers[i] = datum.data();
+            }
+
+            float* dst = result.data() + start;
+            if constexpr (extent == Dynamic) {
+                kernel::compute_batch(
+                    query.data(), pointers.data(), dst, count, query.size()
+                );
+            } else {
+                kernel::template compute_batch<extent>(
+                    query.data(), pointers.data(), dst, count
+                );
+            }
+        }
+    } else {
+        for (size_t i = 0, imax = ids.size(); i < imax; ++i) {
+            result[i] = distance::compute(f, query, data.get_datum(ids[i], mode));
+        }
+    }
+}
+
+} // namespace svs::distance
@@ -12,6 +12,7 @@
 #pragma once
 
 // svs
+#include "svs/core/distance/dispatch.h"
 #include "svs/core/distance/simd_utils.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/preprocessor.h"
@@ -28,6 +29,7 @@
 namespace svs::distance {
 // Forward declare implementation to allow entry point to be near the top.
 template <size_t N, typename Ea, typename Eb> struct IPImpl;
+template <size_t N, typename Ea, typename Eb> struct IPBatchImpl;
 
 // Generic Entry Point
 // Call as one of either:
@@ -47,6 +49,21 @@ class IP {
     static constexpr float compute(const Ea* a, const Eb* b) {
         return IPImpl<N, Ea, Eb>::compute(a, b, lib::MaybeStatic<N>());
     }
+
+    // Compute the distances between ``a`` and each of the ``count`` vectors in ``b``,
+    // writing them to ``result``. Equivalent to calling ``compute`` for each vector.
+    template <typename Ea, typename Eb>
+    static void compute_batch(
+        const Ea* a, const Eb* const* b, float* result, size_t count, size_t N
+    ) {
+        IPBatchImpl<Dynamic, Ea, Eb>::compute(a, b, result, count, lib::MaybeStatic(N));
+    }
+
+    template <size_t N, typename Ea, typename Eb>
+    static void
+    compute_batch(const Ea* a, const Eb* const* b, float* result, size_t count) {
+        IPBatchImpl<N, Ea, Eb>::compute(a, b, result, count, lib::MaybeStatic<N>());
+    }
 };
 
 ///
@@ -144,10 +161,21 @@ float generic_ip(
     return result;
 }
 
+// Kernel family for runtime dispatch. The primary template is intentionally empty.
+// Each instruction set with an accelerated implementation for a type pair provides a
+// partial specialization. See "svs/core/distance/dispatch.h".
+template <ISA Arch, size_t N, typename Ea, typename Eb> struct IPKernel {};
+
+template <size_t N, typename Ea, typename Eb> struct IPKernel<ISA::generic, N, Ea, Eb> {
+    static float compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length) {
+        return generic_ip(a, b, length);
+    }
+};
+
 template <size_t N, typename Ea, typename Eb> struct IPImpl {
     static float
     compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length = lib::MaybeStatic<N>()) {
-        return generic_ip(a, b, length);
+        return dispatch<IPKernel, N, Ea, Eb>(a, b, length);
     }
 };
 
@@ -155,12 +183,10 @@ template <size_t N, typename Ea, typename Eb> struct IPImpl {
 ///// AVX512 Implementations
 /////
 
-#if defined(__AVX512F__)
 
 // Small Integers
-#if defined(__AVX512VNNI__)
-template <size_t N> struct IPImpl<N, int8_t, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512vnni, N, int8_t, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512VNNI static float
     compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
         auto mask = create_mask<32>(length);
@@ -180,8 +206,8 @@ template <size_t N> struct IPImpl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512vnni, N, uint8_t, uint8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512VNNI static float
     compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
         auto mask = create_mask<32>(length);
@@ -201,50 +227,10 @@ template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
         return lib::narrow_cast<float>(_mm512_reduce_add_epi32(sum));
     }
 };
-#elif defined(__AVX512BW__) && defined(__KNCNI__)
-template <size_t N> struct IPImpl<N, int8_t, int8_t> {
-    SVS_NOINLINE static float
-    compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
-        auto sum = _mm512_setzero_epi32();
-        auto mask = create_mask<16>(length);
-        auto all = no_mask<16>();
-
-        for (size_t j = 0; j < length.size(); j += 16) {
-            auto temp_a1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, a + j);
-            auto va = _mm512_cvtepi8_epi32(temp_a1);
-
-            auto temp_b1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, b + j);
-            auto vb = _mm512_cvtepi8_epi32(temp_b1);
-
-            sum = _mm512_fmadd_epi32(va, vb, sum);
-        }
-        return _mm512_reduce_add_epi32(sum);
-    }
-};
-
-template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
-    SVS_NOINLINE static float
-    compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
-        auto sum = _mm512_setzero_epi32();
-        auto mask = create_mask<16>(length);
-        auto all = no_mask<16>();
-
-        for (size_t j = 0; j < length.size(); j += 16) {
-            auto temp_a1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, a + j);
-            auto va = _mm512_cvtepu8_epi32(temp_a1);
-
-            auto temp_b1 = _mm_maskz_loadu_epi8(islast<16>(length, j) ? mask : all, b + j);
-            auto vb = _mm512_cvtepu8_epi32(temp_b1);
-            sum = _mm512_fmadd_epi32(va, vb, sum);
-        }
-        return _mm512_reduce_add_epi32(sum);
-    }
-};
-#endif
 
 // Floating and Mixed Types
-template <size_t N> struct IPImpl<N, float, float> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512f, N, float, float> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto mask = create_mask<16>(length);
@@ -258,8 +244,8 @@ template <size_t N> struct IPImpl<N, float, float> {
     }
 };
 
-template <size_t N> struct IPImpl<N, float, uint8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512f, N, float, uint8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto mask = create_mask<16>(length);
@@ -275,8 +261,8 @@ template <size_t N> struct IPImpl<N, float, uint8_t> {
     };
 };
 
-template <size_t N> struct IPImpl<N, float, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512f, N, float, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_ps();
         auto mask = create_mask<16>(length);
@@ -292,8 +278,8 @@ template <size_t N> struct IPImpl<N, float, int8_t> {
     };
 };
 
-template <size_t N> struct IPImpl<N, float, Float16> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512f, N, float, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
         auto sum = _mm256_setzero_ps();
         auto mask = create_mask<8>(length);
@@ -310,8 +296,8 @@ template <size_t N> struct IPImpl<N, float, Float16> {
     }
 };
 
-template <size_t N> struct IPImpl<N, Float16, Float16> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx512f, N, Float16, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static float
     compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
         auto sum = _mm256_setzero_ps();
         auto mask = create_mask<8>(length);
@@ -328,15 +314,13 @@ template <size_t N> struct IPImpl<N, Float16, Float16> {
         return simd::_mm256_reduce_add_ps(sum);
     };
 };
-#endif
 
 /////
 ///// AVX 2 Implementations
 /////
 
-#if !defined(__AVX512F__) && defined(__AVX2__)
-template <size_t N> struct IPImpl<N, float, float> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, float, float> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -354,8 +338,8 @@ template <size_t N> struct IPImpl<N, float, float> {
     }
 };
 
-template <size_t N> struct IPImpl<N, Float16, Float16> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, Float16, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -375,8 +359,8 @@ template <size_t N> struct IPImpl<N, Float16, Float16> {
     }
 };
 
-template <size_t N> struct IPImpl<N, float, Float16> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, float, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -395,8 +379,8 @@ template <size_t N> struct IPImpl<N, float, Float16> {
     }
 };
 
-template <size_t N> struct IPImpl<N, float, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, float, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -418,8 +402,8 @@ template <size_t N> struct IPImpl<N, float, int8_t> {
     }
 };
 
-template <size_t N> struct IPImpl<N, int8_t, int8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, int8_t, int8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -444,8 +428,8 @@ template <size_t N> struct IPImpl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
-    SVS_NOINLINE static float
+template <size_t N> struct IPKernel<ISA::avx2, N, uint8_t, uint8_t> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static float
     compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
 
@@ -470,5 +454,174 @@ template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
     }
 };
 
-#endif
+/////
+///// Batched Implementations
+/////
+
+// Kernel family computing the distances between one vector ``a`` and several vectors
+// ``b[i]``, as is done when scoring the adjacency list of a graph vertex.
+//
+// Accelerated kernels score four vectors at a time with independent accumulators. Each
+// load of ``a`` is shared by the four vectors and the four dependency chains overlap,
+// rather than waiting on a single chain of fused multiply-adds. Each accumulator sees the
+// same sequence of operations as the single-vector kernel, so results are identical.
+//
+// The generic kernel falls back to the best single-vector kernel for each vector.
+template <ISA Arch, size_t N, typename Ea, typename Eb> struct IPBatchKernel {};
+
+template <size_t N, typename Ea, typename Eb>
+struct IPBatchKernel<ISA::generic, N, Ea, Eb> {
+    static void compute(
+        const Ea* a,
+        const Eb* const* b,
+        float* result,
+        size_t count,
+        lib::MaybeStatic<N> length
+    ) {
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = IPImpl<N, Ea, Eb>::compute(a, b[i], length);
+        }
+    }
+};
+
+template <size_t N, typename Ea, typename Eb> struct IPBatchImpl {
+    static void compute(
+        const Ea* a,
+        const Eb* const* b,
+        float* result,
+        size_t count,
+        lib::MaybeStatic<N> length = lib::MaybeStatic<N>()
+    ) {
+        dispatch<IPBatchKernel, N, Ea, Eb>(a, b, result, count, length);
+    }
+};
+
+template <size_t N> struct IPBatchKernel<ISA::avx512f, N, float, float> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static void compute(
+        const float* a,
+        const float* const* b,
+        float* result,
+        size_t count,
+        lib::MaybeStatic<N> length
+    ) {
+        auto mask = create_mask<16>(length);
+        auto all = no_mask<16>();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float* b0 = b[i];
+            const float* b1 = b[i + 1];
+            const float* b2 = b[i + 2];
+            const float* b3 = b[i + 3];
+            auto s0 = _mm512_setzero_ps();
+            auto s1 = _mm512_setzero_ps();
+            auto s2 = _mm512_setzero_ps();
+            auto s3 = _mm512_setzero_ps();
+            for (size_t j = 0; j < length.size(); j += 16) {
+                auto m = islast<16>(length, j) ? mask : all;
+                auto va = _mm512_maskz_loadu_ps(m, a + j);
+                s0 = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, b0 + j), s0);
+                s1 = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, b1 + j), s1);
+                s2 = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, b2 + j), s2);
+                s3 = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, b3 + j), s3);
+            }
+            result[i] = _mm512_reduce_add_ps(s0);
+            result[i + 1] = _mm512_reduce_add_ps(s1);
+            result[i + 2] = _mm512_reduce_add_ps(s2);
+            result[i + 3] = _mm512_reduce_add_ps(s3);
+        }
+        for (; i < count; ++i) {
+            result[i] = IPKernel<ISA::avx512f, N, float, float>::compute(a, b[i], length);
+        }
+    }
+};
+
+// Use the same vector width of 8 as the single-vector kernel.
+template <size_t N> struct IPBatchKernel<ISA::avx512f, N, float, Float16> {
+    SVS_NOINLINE SVS_TARGET_AVX512F static void compute(
+        const float* a,
+        const Float16* const* b,
+        float* result,
+        size_t count,
+        lib::MaybeStatic<N> length
+    ) {
+        auto mask = create_mask<8>(length);
+        auto all = no_mask<8>();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const Float16* b0 = b[i];
+            const Float16* b1 = b[i + 1];
+            const Float16* b2 = b[i + 2];
+            const Float16* b3 = b[i + 3];
+            auto s0 = _mm256_setzero_ps();
+            auto s1 = _mm256_setzero_ps();
+            auto s2 = _mm256_setzero_ps();
+            auto s3 = _mm256_setzero_ps();
+            for (size_t j = 0; j < length.size(); j += 8) {
+                auto m = islast<8>(length, j) ? mask : all;
+                auto va = _mm256_maskz_loadu_ps(m, a + j);
+                auto v0 = _mm256_cvtph_ps(_mm_maskz_loadu_epi16(m, b0 + j));
+                auto v1 = _mm256_cvtph_ps(_mm_maskz_loadu_epi16(m, b1 + j));
+                auto v2 = _mm256_cvtph_ps(_mm_maskz_loadu_epi16(m, b2 + j));
+                auto v3 = _mm256_cvtph_ps(_mm_maskz_loadu_epi16(m, b3 + j));
+                s0 = _mm256_fmadd_ps(va, v0, s0);
+                s1 = _mm256_fmadd_ps(va, v1, s1);
+                s2 = _mm256_fmadd_ps(va, v2, s2);
+                s3 = _mm256_fmadd_ps(va, v3, s3);
+            }
+            result[i] = simd::_mm256_reduce_add_ps(s0);
+            result[i + 1] = simd::_mm256_reduce_add_ps(s1);
+            result[i + 2] = simd::_mm256_reduce_add_ps(s2);
+            result[i + 3] = simd::_mm256_reduce_add_ps(s3);
+        }
+        for (; i < count; ++i) {
+            result[i] =
+                IPKernel<ISA::avx512f, N, float, Float16>::compute(a, b[i], length);
+        }
+    }
+};
+
+template <size_t N> struct IPBatchKernel<ISA::avx2, N, float, float> {
+    SVS_NOINLINE SVS_TARGET_AVX2 static void compute(
+        const float* a,
+        const float* const* b,
+        float* result,
+        size_t count,
+        lib::MaybeStatic<N> length
+    ) {
+        constexpr size_t vector_size = 8;
+        size_t upper = lib::upper<vector_size>(length);
+        auto rest = lib::rest<vector_size>(length);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float* b0 = b[i];
+            const float* b1 = b[i + 1];
+            const float* b2 = b[i + 2];
+            const float* b3 = b[i + 3];
+            auto s0 = _mm256_setzero_ps();
+            auto s1 = _mm256_setzero_ps();
+            auto s2 = _mm256_setzero_ps();
+            auto s3 = _mm256_setzero_ps();
+            for (size_t j = 0; j < upper; j += vector_size) {
+                auto va = _mm256_loadu_ps(a + j);
+                s0 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b0 + j), s0);
+                s1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b1 + j), s1);
+                s2 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b2 + j), s2);
+                s3 = _mm256_fmadd_ps(va, _mm256_loadu_ps(b3 + j), s3);
+            }
+            const float* ta = a + upper;
+            result[i] =
+                simd::_mm256_reduce_add_ps(s0) + generic_ip(ta, b0 + upper, rest);
+            result[i + 1] =
+                simd::_mm256_reduce_add_ps(s1) + generic_ip(ta, b1 + upper, rest);
+            result[i + 2] =
+                simd::_mm256_reduce_add_ps(s2) + generic_ip(ta, b2 + upper, rest);
+            result[i + 3] =
+                simd::_mm256_reduce_add_ps(s3) + generic_ip(ta, b3 + upper, rest);
+        }
+        for (; i < count; ++i) {
+            result[i] = IPKernel<ISA::avx2, N, float, float>::compute(a, b[i], length);
+        }
+    }
+};
+
 } // namespace svs::distance
@@ -18,12 +18,13 @@
 #include "x86intrin.h"
 
 #include "svs/lib/float16.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/static.h"
 
 namespace svs {
 namespace simd {
 
-inline float _mm256_reduce_add_ps(__m256 x) {
+SVS_TARGET_AVX2 inline float _mm256_reduce_add_ps(__m256 x) {
     const float* base = reinterpret_cast<float*>(&x);
     float sum{0};
     for (size_t i = 0; i < 8; ++i) {
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "svs/core/graph/graph.h"
+#include "svs/core/graph/fused.h"
 #include "svs/core/graph/io.h"
 #include "svs/lib/saveload.h"
 
@@ -32,6 +33,11 @@ struct GraphMapping<Idx, data::PolymorphicBuilder<Allocator>> {
     using type = graphs::SimpleGraph<Idx>;
 };
 
+// Define for the MemoryMapBuilder
+template <typename Idx> struct GraphMapping<Idx, data::MemoryMapBuilder> {
+    using type = graphs::SimpleGraph<Idx>;
+};
+
 // Define for the BlockedBuilder
 template <typename Idx> struct GraphMapping<Idx, data::BlockedBuilder> {
     using type = graphs::SimpleBlockedGraph<Idx>;
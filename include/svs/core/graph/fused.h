@@ -0,0 +1,480 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/data.h"
+#include "svs/concepts/graph.h"
+#include "svs/core/allocator.h"
+#include "svs/core/data.h"
+#include "svs/core/data/simple.h"
+#include "svs/core/graph/graph.h"
+#include "svs/lib/datatype.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/prefetch.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/threads.h"
+
+// stl
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+///
+/// Co-located storage for a graph and the dataset it indexes.
+///
+/// Each vertex is stored as a single cache line aligned record holding the adjacency list
+/// (using the same inline-length layout as ``SimpleGraph``) followed by the vector:
+///
+/// Record 0  :  Len N0 N1 ... Nm [pad] V0 V1 ... Vd [pad]
+/// Record 1  :  Len N0 N1 ... Nm [pad] V0 V1 ... Vd [pad]
+/// ...
+///
+/// A search hop then touches one region of memory per visited vertex rather than one
+/// region in the graph and another in the dataset, reducing the number of distinct pages
+/// (and TLB entries) per hop. This is most beneficial when the records are memory mapped
+/// from disk.
+///
+/// The graph and dataset views share ownership of the records, so they can be passed
+/// separately to the index implementations.
+///
+
+namespace svs::graphs {
+
+///
+/// @brief Byte layout of the records in a fused graph and dataset.
+///
+struct FusedLayout {
+    /// @brief Compute the layout for the given index and element types.
+    ///
+    /// @param max_degree The maximum degree of the graph.
+    /// @param dimensions The number of elements in each vector.
+    /// @param index_size The size in bytes of the graph index type.
+    /// @param element_size The size in bytes of the vector element type.
+    /// @param element_alignment The alignment in bytes of the vector element type.
+    ///
+    static FusedLayout make(
+        size_t max_degree,
+        size_t dimensions,
+        size_t index_size,
+        size_t element_size,
+        size_t element_alignment
+    ) {
+        auto layout = FusedLayout{};
+        layout.max_degree = max_degree;
+        layout.dimensions = dimensions;
+        layout.data_offset =
+            lib::round_up_to_multiple_of((max_degree + 1) * index_size, element_alignment);
+        layout.record_bytes = lib::round_up_to_multiple_of(
+            layout.data_offset + dimensions * element_size, lib::CACHELINE_BYTES
+        );
+        return layout;
+    }
+
+    template <typename Idx, typename T>
+    static FusedLayout make(size_t max_degree, size_t dimensions) {
+        return make(max_degree, dimensions, sizeof(Idx), sizeof(T), alignof(T));
+    }
+
+    friend bool operator==(const FusedLayout&, const FusedLayout&) = default;
+
+    ///// Members
+    /// The maximum degree of the graph.
+    size_t max_degree = 0;
+    /// The number of elements in each vector.
+    size_t dimensions = 0;
+    /// The offset in bytes of the vector from the start of each record.
+    size_t data_offset = 0;
+    /// The size of each record in bytes. Always a multiple of the cache line size.
+    size_t record_bytes = 0;
+};
+
+///
+/// @brief The records backing a fused graph and dataset.
+///
+class FusedRecords {
+  public:
+    using records_type = data::SimplePolymorphicData<std::byte>;
+
+    FusedRecords(records_type records, const FusedLayout& layout)
+        : records_{std::move(records)}
+        , layout_{layout} {
+        if (records_.dimensions() != layout_.record_bytes) {
+            throw ANNEXCEPTION(
+                "Fused records have ",
+                records_.dimensions(),
+                " bytes while the layout requires ",
+                layout_.record_bytes,
+                '!'
+            );
+        }
+    }
+
+    size_t size() const { return records_.size(); }
+    const FusedLayout& layout() const { return layout_; }
+    const records_type& records() const { return records_; }
+
+    std::byte* record(size_t i) { return records_.get_datum(i).data(); }
+    const std::byte* record(size_t i) const { return records_.get_datum(i).data(); }
+
+  private:
+    records_type records_;
+    FusedLayout layout_;
+};
+
+///
+/// @brief The adjacency lists of fused records viewed as a dataset.
+///
+/// Used as the backing storage of ``FusedGraph``.
+///
+template <std::unsigned_integral Idx> class FusedAdjacency {
+  public:
+    static constexpr size_t extent = Dynamic;
+    using element_type = Idx;
+    using value_type = std::span<Idx>;
+    using const_value_type = std::span<const Idx>;
+
+    explicit FusedAdjacency(std::shared_ptr<FusedRecords> records)
+        : records_{std::move(records)} {}
+
+    size_t size() const { return records_->size(); }
+    size_t dimensions() const { return records_->layout().max_degree + 1; }
+
+    const_value_type get_datum(size_t i) const {
+        return {reinterpret_cast<const Idx*>(records_->record(i)), dimensions()};
+    }
+    value_type get_datum(size_t i) {
+        return {reinterpret_cast<Idx*>(records_->record(i)), dimensions()};
+    }
+
+    void prefetch(size_t i) const { lib::prefetch(get_datum(i)); }
+
+    template <typename U, size_t N> void set_datum(size_t i, std::span<U, N> datum) {
+        assert(datum.size() == dimensions());
+        std::copy(datum.begin(), datum.end(), get_datum(i).begin());
+    }
+
+  private:
+    std::shared_ptr<FusedRecords> records_;
+};
+
+///
+/// @brief The graph view of fused records.
+///
+/// Shares ownership of the records with the corresponding ``FusedData``. Saving uses the
+/// same format as ``SimpleGraph``.
+///
+template <std::unsigned_integral Idx>
+class FusedGraph : public SimpleGraphBase<Idx, FusedAdjacency<Idx>> {
+  public:
+    using parent_type = SimpleGraphBase<Idx, FusedAdjacency<Idx>>;
+
+    explicit FusedGraph(std::shared_ptr<FusedRecords> records)
+        : parent_type{FusedAdjacency<Idx>{std::move(records)}} {}
+};
+
+///
+/// @brief The dataset view of fused records.
+///
+/// Shares ownership of the records with the corresponding ``FusedGraph``. Saving uses the
+/// same format as ``SimpleData``.
+///
+template <typename T, size_t Extent = Dynamic> class FusedData {
+  public:
+    static constexpr size_t extent = Extent;
+    static constexpr bool supports_saving = true;
+
+    using element_type = T;
+    using value_type = std::span<T, Extent>;
+    using const_value_type = std::span<const T, Extent>;
+
+    ///// Access Compatibility
+    template <data::AccessMode = data::DefaultAccess> using mode_value_type = value_type;
+    template <data::AccessMode = data::DefaultAccess>
+    using mode_const_value_type = const_value_type;
+
+    template <typename Distance> static Distance adapt_distance(const Distance& distance) {
+        return threads::shallow_copy(distance);
+    }
+
+    template <typename Distance> static Distance self_distance(const Distance& distance) {
+        return threads::shallow_copy(distance);
+    }
+
+    explicit FusedData(std::shared_ptr<FusedRecords> records)
+        : records_{std::move(records)}
+        , offset_{records_->layout().data_offset}
+        , dimensions_{records_->layout().dimensions} {
+        if constexpr (Extent != Dynamic) {
+            if (dimensions_ != Extent) {
+                throw ANNEXCEPTION(
+                    "Fused records with ",
+                    dimensions_,
+                    " dimensions can't be viewed with static extent ",
+                    Extent,
+                    '!'
+                );
+            }
+        }
+    }
+
+    /// Return the number of entries in the dataset.
+    size_t size() const { return records_->size(); }
+    /// Return the number of dimensions for each entry in the dataset.
+    size_t dimensions() const { return dimensions_; }
+
+    template <data::AccessMode Mode = data::DefaultAccess>
+    const_value_type get_datum(size_t i, Mode SVS_UNUSED(mode) = {}) const {
+        auto* ptr = reinterpret_cast<const T*>(records_->record(i) + offset_);
+        return const_value_type{ptr, dimensions_};
+    }
+
+    template <data::AccessMode Mode = data::DefaultAccess>
+    value_type get_datum(size_t i, Mode SVS_UNUSED(mode) = {}) {
+        auto* ptr = reinterpret_cast<T*>(records_->record(i) + offset_);
+        return value_type{ptr, dimensions_};
+    }
+
+    /// Prefetch the vector at position ``i`` into the L1 cache.
+    template <data::AccessMode Mode = data::DefaultAccess>
+    void prefetch(size_t i, Mode SVS_UNUSED(mode) = {}) const {
+        lib::prefetch(get_datum(i));
+    }
+
+    ///
+    /// @brief Overwrite the contents of the vector at position ``i``.
+    ///
+    /// Elements are converted using ``lib::relaxed_narrow``.
+    ///
+    template <typename U, size_t N, data::AccessMode Mode = data::DefaultAccess>
+    void set_datum(size_t i, std::span<U, N> datum, Mode SVS_UNUSED(mode) = {}) {
+        if (datum.size() != dimensions()) {
+            throw ANNEXCEPTION(
+                "Trying to assign vector of size ",
+                datum.size(),
+                " to a dataset with dimensionality ",
+                dimensions(),
+                '!'
+            );
+        }
+        std::transform(
+            datum.begin(),
+            datum.end(),
+            get_datum(i).begin(),
+            [](const U& u) { return lib::relaxed_narrow<T>(u); }
+        );
+    }
+
+    template <typename U, data::AccessMode Mode = data::DefaultAccess>
+    void set_datum(size_t i, const std::vector<U>& datum, Mode mode = {}) {
+        set_datum(i, lib::as_span(datum), mode);
+    }
+
+    threads::UnitRange<size_t> eachindex() const {
+        return threads::UnitRange<size_t>{0, size()};
+    }
+
+    ///// IO
+    lib::SaveType save(const lib::SaveContext& ctx) const {
+        return data::GenericSaver(*this).save(ctx);
+    }
+
+  private:
+    std::shared_ptr<FusedRecords> records_;
+    size_t offset_;
+    size_t dimensions_;
+};
+
+///
+/// @brief Owner of fused graph and vector records.
+///
+/// @tparam Idx The integer type used to encode vertices in the graph.
+/// @tparam T The element type of the vectors.
+/// @tparam Extent The compile-time dimensionality of the vectors.
+///
+/// Use ``graph()`` and ``data()`` to obtain the views passed to the index. Both views
+/// share ownership of the records with this class.
+///
+template <std::unsigned_integral Idx, typename T, size_t Extent = Dynamic>
+class FusedStore {
+  public:
+    using graph_type = FusedGraph<Idx>;
+    using data_type = FusedData<T, Extent>;
+
+    ///
+    /// @brief Allocate records with empty adjacency lists and uninitialized vectors.
+    ///
+    /// @param num_nodes The number of vertices.
+    /// @param max_degree The maximum degree of the graph.
+    /// @param dimensions The number of elements in each vector.
+    /// @param allocator The allocator used for the records.
+    ///
+    template <typename Allocator = HugepageAllocator>
+    FusedStore(
+        size_t num_nodes,
+        size_t max_degree,
+        size_t dimensions,
+        const Allocator& allocator = HugepageAllocator()
+    ) {
+        auto layout = FusedLayout::make<Idx, T>(max_degree, dimensions);
+        auto records =
+            FusedRecords::records_type(allocator, num_nodes, layout.record_bytes);
+        records_ = std::make_shared<FusedRecords>(std::move(records), layout);
+        graph().reset();
+    }
+
+    ///
+    /// @brief Take ownership of previously populated records.
+    ///
+    FusedStore(FusedRecords::records_type records, const FusedLayout& layout)
+        : records_{std::make_shared<FusedRecords>(std::move(records), layout)} {}
+
+    ///
+    /// @brief Copy ``data`` into new records with empty adjacency lists.
+    ///
+    /// The result is ready to be used to build a graph index.
+    ///
+    template <data::ImmutableMemoryDataset Data, typename Allocator = HugepageAllocator>
+    static FusedStore
+    build(const Data& data, size_t max_degree, const Allocator& allocator = {}) {
+        auto store = FusedStore(data.size(), max_degree, data.dimensions(), allocator);
+        auto dst = store.data();
+        for (size_t i = 0, imax = data.size(); i < imax; ++i) {
+            dst.set_datum(i, data.get_datum(i));
+        }
+        return store;
+    }
+
+    ///
+    /// @brief Interleave an existing graph and dataset into new records.
+    ///
+    template <
+        ImmutableMemoryGraph Graph,
+        data::ImmutableMemoryDataset Data,
+        typename Allocator = HugepageAllocator>
+    static FusedStore
+    convert(const Graph& graph, const Data& data, const Allocator& allocator = {}) {
+        if (graph.n_nodes() != data.size()) {
+            throw ANNEXCEPTION(
+                "Graph has ",
+                graph.n_nodes(),
+                " nodes while the dataset has ",
+                data.size(),
+                " elements!"
+            );
+        }
+        auto store = build(data, graph.max_degree(), allocator);
+        auto dst = store.graph();
+        for (size_t i = 0, imax = graph.n_nodes(); i < imax; ++i) {
+            const auto& neighbors = graph.get_node(i);
+            auto adjacency_list = std::vector<Idx>(neighbors.begin(), neighbors.end());
+            dst.replace_node(i, adjacency_list);
+        }
+        return store;
+    }
+
+    /// @brief Return the graph view of the records.
+    graph_type graph() const { return graph_type{records_}; }
+    /// @brief Return the dataset view of the records.
+    data_type data() const { return data_type{records_}; }
+
+    /// @brief Return the number of vertices.
+    size_t size() const { return records_->size(); }
+    /// @brief Return the maximum degree of the graph.
+    size_t max_degree() const { return layout().max_degree; }
+    /// @brief Return the number of elements in each vector.
+    size_t dimensions() const { return layout().dimensions; }
+    /// @brief Return the byte layout of each record.
+    const FusedLayout& layout() const { return records_->layout(); }
+
+    ///// Saving
+
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+    static constexpr std::string_view kind = "fused_graph_data";
+
+    ///
+    /// @brief Save the records in a single file.
+    ///
+    /// Unlike saving the graph and data views separately, the records are written in their
+    /// in-memory layout so they can be memory mapped directly on reload.
+    ///
+    lib::SaveType save(const lib::SaveContext& ctx) const {
+        const auto& l = layout();
+        return lib::SaveType(
+            toml::table({
+                {"name", kind},
+                {"records", lib::recursive_save(records_->records(), ctx)},
+                {"num_nodes", prepare(size())},
+                {"max_degree", prepare(l.max_degree)},
+                {"dims", prepare(l.dimensions)},
+                {"data_offset", prepare(l.data_offset)},
+                {"record_bytes", prepare(l.record_bytes)},
+                {"index_eltype", name<datatype_v<Idx>>()},
+                {"eltype", name<datatype_v<T>>()},
+            }),
+            save_version
+        );
+    }
+
+    ///
+    /// @brief Reload previously saved records.
+    ///
+    /// Passing a ``data::MemoryMapBuilder`` maps the records from disk without copying.
+    ///
+    template <typename Builder = data::PolymorphicBuilder<HugepageAllocator>>
+    static FusedStore load(
+        const toml::table& table,
+        const lib::LoadContext& ctx,
+        const lib::Version& version,
+        const Builder& builder = {}
+    ) {
+        if (version != save_version) {
+            throw ANNEXCEPTION("Unhandled version!");
+        }
+        auto check = [&](std::string_view key, std::string_view expected) {
+            auto value = get(table, key).value();
+            if (value != expected) {
+                throw ANNEXCEPTION(
+                    "Expected ", key, " to be ", expected, " but got ", value, '!'
+                );
+            }
+        };
+        check("name", kind);
+        check("index_eltype", name<datatype_v<Idx>>());
+        check("eltype", name<datatype_v<T>>());
+
+        auto max_degree = get<size_t>(table, "max_degree");
+        auto dims = get<size_t>(table, "dims");
+        auto layout = FusedLayout::make<Idx, T>(max_degree, dims);
+        if (get<size_t>(table, "data_offset") != layout.data_offset ||
+            get<size_t>(table, "record_bytes") != layout.record_bytes) {
+            throw ANNEXCEPTION("Saved fused record layout is incompatible!");
+        }
+
+        using loader_type = VectorDataLoader<std::byte, Dynamic, Builder>;
+        auto records = lib::recursive_load(
+            loader_type(lib::InferPath(), builder), subtable(table, "records"), ctx
+        );
+        if (records.size() != get<size_t>(table, "num_nodes")) {
+            throw ANNEXCEPTION("Fused records have an unexpected number of entries!");
+        }
+        return FusedStore(FusedRecords::records_type(std::move(records)), layout);
+    }
+
+  private:
+    std::shared_ptr<FusedRecords> records_;
+};
+
+} // namespace svs::graphs
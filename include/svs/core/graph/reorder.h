@@ -0,0 +1,461 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/data.h"
+#include "svs/concepts/graph.h"
+#include "svs/core/data/simple.h"
+#include "svs/core/graph/graph.h"
+#include "svs/core/translation.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/threads.h"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+///
+/// Vertex reordering to improve the memory locality of graph traversal.
+///
+/// Vertex IDs normally follow the order of the input dataset, so the neighbors of a vertex
+/// are scattered uniformly over the graph and the dataset. Renumbering the vertices so
+/// neighbors receive nearby IDs means consecutive hops of a search tend to fall into the
+/// same pages and cache lines.
+///
+
+namespace svs::graphs {
+
+///
+/// @brief Strategies for computing a locality improving vertex order.
+///
+enum class VertexOrder {
+    /// Breadth-first order starting at the entry point.
+    BFS,
+    /// Reverse Cuthill-McKee: breadth-first order visiting low-degree neighbors first,
+    /// then reversed.
+    RCM
+};
+
+inline constexpr std::string_view vertex_order_name(VertexOrder order) {
+    switch (order) {
+        case VertexOrder::BFS: {
+            return "bfs";
+        }
+        case VertexOrder::RCM: {
+            return "rcm";
+        }
+    }
+    throw ANNEXCEPTION("Unhandled vertex order!");
+}
+
+inline VertexOrder parse_vertex_order(std::string_view order) {
+    if (order == "bfs") {
+        return VertexOrder::BFS;
+    }
+    if (order == "rcm") {
+        return VertexOrder::RCM;
+    }
+    throw ANNEXCEPTION("Unknown vertex order ", order, '!');
+}
+
+///
+/// @brief A permutation of vertex IDs.
+///
+/// The vertex with ID ``old_id(i)`` in the original graph receives ID ``i`` after
+/// reordering.
+///
+template <std::unsigned_integral Idx> class Reordering {
+  public:
+    ///
+    /// @brief Construct a reordering from the list of original IDs in their new order.
+    ///
+    /// Throws an ``ANNException`` if ``new_to_old`` is not a permutation.
+    ///
+    explicit Reordering(std::vector<Idx> new_to_old)
+        : new_to_old_{std::move(new_to_old)}
+        , old_to_new_(new_to_old_.size(), std::numeric_limits<Idx>::max()) {
+        for (size_t i = 0, imax = new_to_old_.size(); i < imax; ++i) {
+            size_t old = new_to_old_[i];
+            if (old >= imax || old_to_new_[old] != std::numeric_limits<Idx>::max()) {
+                throw ANNEXCEPTION("Vertex order is not a permutation!");
+            }
+            old_to_new_[old] = lib::narrow<Idx>(i);
+        }
+    }
+
+    /// @brief Return the identity reordering of ``size`` vertices.
+    static Reordering identity(size_t size) {
+        auto ids = std::vector<Idx>(size);
+        std::iota(ids.begin(), ids.end(), Idx{0});
+        return Reordering{std::move(ids)};
+    }
+
+    /// @brief Return the number of vertices in the permutation.
+    size_t size() const { return new_to_old_.size(); }
+
+    /// @brief Return the new ID of the vertex with original ID ``i``.
+    Idx new_id(size_t i) const { return old_to_new_.at(i); }
+    /// @brief Return the original ID of the vertex with new ID ``i``.
+    Idx old_id(size_t i) const { return new_to_old_.at(i); }
+
+    const std::vector<Idx>& new_to_old() const { return new_to_old_; }
+    const std::vector<Idx>& old_to_new() const { return old_to_new_; }
+
+    ///
+    /// @brief Return a translator mapping original IDs (external) to new IDs (internal).
+    ///
+    IDTranslator translator() const {
+        auto translator = IDTranslator();
+        translator.insert(new_to_old_, threads::UnitRange<size_t>(0, size()));
+        return translator;
+    }
+
+    ///
+    /// @brief Compose an existing translation with this reordering.
+    ///
+    /// The internal IDs of ``previous`` are interpreted as original IDs of this reordering.
+    ///
+    IDTranslator translator(const IDTranslator& previous) const {
+        auto external = std::vector<IDTranslator::external_id_type>();
+        auto internal = std::vector<IDTranslator::internal_id_type>();
+        external.reserve(previous.size());
+        internal.reserve(previous.size());
+        for (auto [e, i] : previous) {
+            external.push_back(e);
+            internal.push_back(new_id(i));
+        }
+        auto translator = IDTranslator();
+        translator.insert(external, internal);
+        return translator;
+    }
+
+  private:
+    std::vector<Idx> new_to_old_;
+    std::vector<Idx> old_to_new_;
+};
+
+namespace detail {
+
+// Breadth-first traversal appending vertices to ``order`` in the order they are
+// discovered. Unreachable vertices start new traversals in increasing ID order.
+template <ImmutableMemoryGraph Graph, typename Visit>
+std::vector<typename Graph::index_type>
+breadth_first(const Graph& graph, typename Graph::index_type start, Visit&& visit) {
+    using I = typename Graph::index_type;
+    const size_t num_nodes = graph.n_nodes();
+    if (start >= num_nodes && num_nodes != 0) {
+        throw ANNEXCEPTION("Start vertex ", start, " is out of bounds!");
+    }
+
+    auto order = std::vector<I>();
+    order.reserve(num_nodes);
+    auto discovered = std::vector<bool>(num_nodes, false);
+    auto enqueue = [&](I i) {
+        if (!discovered[i]) {
+            discovered[i] = true;
+            order.push_back(i);
+        }
+    };
+
+    // ``order`` doubles as the queue: vertices ``[head, order.size())`` are pending.
+    size_t head = 0;
+    size_t next_root = 0;
+    if (num_nodes != 0) {
+        enqueue(start);
+    }
+    while (order.size() < num_nodes) {
+        if (head == order.size()) {
+            while (discovered[next_root]) {
+                ++next_root;
+            }
+            enqueue(lib::narrow_cast<I>(next_root));
+        }
+        visit(order[head++], enqueue);
+    }
+    return order;
+}
+
+} // namespace detail
+
+///
+/// @brief Return the vertices of ``graph`` in breadth-first order from ``start``.
+///
+template <ImmutableMemoryGraph Graph>
+std::vector<typename Graph::index_type>
+bfs_order(const Graph& graph, typename Graph::index_type start) {
+    using I = typename Graph::index_type;
+    return detail::breadth_first(graph, start, [&](I i, auto& enqueue) {
+        for (auto j : graph.get_node(i)) {
+            enqueue(j);
+        }
+    });
+}
+
+///
+/// @brief Return the vertices of ``graph`` in reverse Cuthill-McKee order.
+///
+/// Neighbors are discovered in order of increasing out-degree. The traversal starts at
+/// ``start`` so it is numbered last.
+///
+template <ImmutableMemoryGraph Graph>
+std::vector<typename Graph::index_type>
+rcm_order(const Graph& graph, typename Graph::index_type start) {
+    using I = typename Graph::index_type;
+    auto neighbors = std::vector<I>();
+    auto order = detail::breadth_first(graph, start, [&](I i, auto& enqueue) {
+        const auto& adjacency_list = graph.get_node(i);
+        neighbors.assign(adjacency_list.begin(), adjacency_list.end());
+        std::stable_sort(neighbors.begin(), neighbors.end(), [&](I a, I b) {
+            return graph.get_node_degree(a) < graph.get_node_degree(b);
+        });
+        for (auto j : neighbors) {
+            enqueue(j);
+        }
+    });
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+///
+/// @brief Compute a locality improving reordering of the vertices of ``graph``.
+///
+/// @param graph The graph to reorder.
+/// @param start The vertex to begin traversal from. Usually the search entry point.
+/// @param strategy The ordering strategy.
+///
+template <ImmutableMemoryGraph Graph>
+Reordering<typename Graph::index_type> compute_reordering(
+    const Graph& graph, typename Graph::index_type start, VertexOrder strategy
+) {
+    switch (strategy) {
+        case VertexOrder::BFS: {
+            return Reordering{bfs_order(graph, start)};
+        }
+        case VertexOrder::RCM: {
+            return Reordering{rcm_order(graph, start)};
+        }
+    }
+    throw ANNEXCEPTION("Unhandled vertex order!");
+}
+
+///
+/// @brief Write the reordered ``src`` into ``dst``.
+///
+/// @param src The original graph.
+/// @param dst Destination graph with the same number of vertices and at least the same
+///     maximum degree as ``src``.
+/// @param reordering The permutation to apply.
+/// @param threadpool The threadpool to use.
+///
+/// Adjacency lists are renumbered and sorted by increasing ID so each hop visits its
+/// neighbors in memory order.
+///
+template <
+    ImmutableMemoryGraph Src,
+    MemoryGraph Dst,
+    std::unsigned_integral Idx,
+    threads::ThreadPool Pool>
+void permute_graph(
+    const Src& src, Dst& dst, const Reordering<Idx>& reordering, Pool& threadpool
+) {
+    using I = typename Dst::index_type;
+    if (src.n_nodes() != reordering.size() || dst.n_nodes() != reordering.size()) {
+        throw ANNEXCEPTION("Graph sizes do not match the reordering!");
+    }
+    if (dst.max_degree() < src.max_degree()) {
+        throw ANNEXCEPTION("Destination graph has a smaller maximum degree!");
+    }
+
+    threads::run(
+        threadpool,
+        threads::StaticPartition(reordering.size()),
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto neighbors = std::vector<I>();
+            for (auto i : is) {
+                const auto& adjacency_list = src.get_node(reordering.old_id(i));
+                neighbors.clear();
+                for (auto j : adjacency_list) {
+                    neighbors.push_back(lib::narrow_cast<I>(reordering.new_id(j)));
+                }
+                std::sort(neighbors.begin(), neighbors.end());
+                dst.replace_node(lib::narrow_cast<I>(i), neighbors);
+            }
+        }
+    );
+}
+
+///
+/// @brief Write the reordered ``src`` into ``dst``.
+///
+/// @param src The original dataset.
+/// @param dst Destination dataset with the same size and dimensions as ``src``.
+/// @param reordering The permutation to apply.
+/// @param threadpool The threadpool to use.
+///
+template <
+    data::ImmutableMemoryDataset Src,
+    data::MemoryDataset Dst,
+    std::unsigned_integral Idx,
+    threads::ThreadPool Pool>
+void permute_data(
+    const Src& src, Dst& dst, const Reordering<Idx>& reordering, Pool& threadpool
+) {
+    if (src.size() != reordering.size() || dst.size() != reordering.size()) {
+        throw ANNEXCEPTION("Dataset sizes do not match the reordering!");
+    }
+    threads::run(
+        threadpool,
+        threads::StaticPartition(reordering.size()),
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                dst.set_datum(i, src.get_datum(reordering.old_id(i)));
+            }
+        }
+    );
+}
+
+///
+/// @brief The graph, dataset and entry points of an index after vertex reordering.
+///
+template <typename Graph, typename Data> struct ReorderedIndex {
+    using index_type = typename Graph::index_type;
+
+    /// The reordered graph.
+    Graph graph;
+    /// The reordered dataset.
+    Data data;
+    /// The entry points in terms of the new IDs, in their original order.
+    std::vector<index_type> entry_points;
+    /// Maps the original IDs (external) to the new IDs (internal).
+    IDTranslator translator;
+};
+
+///
+/// @brief Reorder the graph, dataset and entry points of an index together.
+///
+/// @param graph The original graph.
+/// @param data The original dataset.
+/// @param entry_points The original entry points. Must be non-empty. Traversal starts at
+///     the first entry point.
+/// @param strategy The ordering strategy.
+/// @param dst_graph Destination graph with the same number of vertices and at least the
+///     same maximum degree as ``graph``.
+/// @param dst_data Destination dataset with the same size and dimensions as ``data``.
+/// @param threadpool The threadpool to use.
+///
+/// Searching the reordered index returns new IDs. Use the returned translator to map
+/// them back to the original IDs.
+///
+template <
+    ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Data,
+    MemoryGraph DstGraph,
+    data::MemoryDataset DstData,
+    std::integral I,
+    threads::ThreadPool Pool>
+ReorderedIndex<DstGraph, DstData> reorder(
+    const Graph& graph,
+    const Data& data,
+    const std::vector<I>& entry_points,
+    VertexOrder strategy,
+    DstGraph dst_graph,
+    DstData dst_data,
+    Pool& threadpool
+) {
+    using Idx = typename Graph::index_type;
+    using DstIdx = typename DstGraph::index_type;
+    if (graph.n_nodes() != data.size()) {
+        throw ANNEXCEPTION(
+            "Graph has ", graph.n_nodes(), " nodes while the data has ", data.size(), '!'
+        );
+    }
+    if (entry_points.empty()) {
+        throw ANNEXCEPTION("At least one entry point is required!");
+    }
+
+    auto reordering =
+        compute_reordering(graph, lib::narrow<Idx>(entry_points.front()), strategy);
+    permute_graph(graph, dst_graph, reordering, threadpool);
+    permute_data(data, dst_data, reordering, threadpool);
+
+    auto new_entry_points = std::vector<DstIdx>();
+    new_entry_points.reserve(entry_points.size());
+    for (auto id : entry_points) {
+        new_entry_points.push_back(
+            lib::narrow<DstIdx>(reordering.new_id(lib::narrow<size_t>(id)))
+        );
+    }
+    return ReorderedIndex<DstGraph, DstData>{
+        std::move(dst_graph),
+        std::move(dst_data),
+        std::move(new_entry_points),
+        reordering.translator()};
+}
+
+///
+/// @brief Reorder the graph, dataset and entry points of an index together.
+///
+/// Behaves like the overload above, writing the result into a newly allocated
+/// ``SimpleGraph`` and ``SimpleData``.
+///
+template <
+    ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Data,
+    std::integral I,
+    threads::ThreadPool Pool>
+auto reorder(
+    const Graph& graph,
+    const Data& data,
+    const std::vector<I>& entry_points,
+    VertexOrder strategy,
+    Pool& threadpool
+) {
+    using Idx = typename Graph::index_type;
+    return reorder(
+        graph,
+        data,
+        entry_points,
+        strategy,
+        SimpleGraph<Idx>(graph.n_nodes(), graph.max_degree()),
+        data::SimpleData<typename Data::element_type, Data::extent>(
+            data.size(), data.dimensions()
+        ),
+        threadpool
+    );
+}
+
+///
+/// @brief Return the mean absolute difference between the IDs of adjacent vertices.
+///
+/// Smaller values indicate better locality of graph traversal.
+///
+template <ImmutableMemoryGraph Graph> double mean_edge_span(const Graph& graph) {
+    double total = 0;
+    size_t num_edges = 0;
+    for (size_t i = 0, imax = graph.n_nodes(); i < imax; ++i) {
+        for (auto j : graph.get_node(i)) {
+            total += static_cast<double>(i > j ? i - j : j - i);
+        }
+        num_edges += graph.get_node_degree(i);
+    }
+    return num_edges == 0 ? 0.0 : total / static_cast<double>(num_edges);
+}
+
+} // namespace svs::graphs
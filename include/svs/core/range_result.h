@@ -0,0 +1,194 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/threads/threadlocal.h"
+
+// stl
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace svs {
+
+///
+/// @brief Return whether ``distance`` lies within ``radius`` for the comparator ``Cmp``.
+///
+/// For distances where smaller is better (``std::less``), this is ``distance <= radius``.
+/// For similarities where larger is better (``std::greater``), this is
+/// ``distance >= radius``.
+///
+template <typename Cmp> bool within_radius(float distance, float radius) {
+    return !Cmp{}(radius, distance);
+}
+
+///
+/// @brief Results of a range search in compressed sparse row (CSR) form.
+///
+/// Each query may have a different number of neighbors. The neighbors of all queries are
+/// stored back to back, sorted from best to worst within each query, and
+/// ``offsets()[i]`` is the position of the first neighbor of query ``i``.
+///
+/// Searches fill the result through one ``Partial`` per worker thread. All storage,
+/// including the per-thread staging, is kept when the result is reused, so repeated
+/// searches into the same result do not allocate once it has grown large enough.
+///
+template <typename Idx = size_t> class RangeSearchResult {
+  public:
+    using neighbor_type = Neighbor<Idx>;
+
+    ///
+    /// @brief Per-thread staging area for results.
+    ///
+    /// Neighbors may be appended for queries in any order. Neighbors of the same query
+    /// may also be split across several partials. Each neighbor is staged together with
+    /// the index of its query, so interleaving queries does not add any overhead.
+    ///
+    class Partial {
+      public:
+        Partial() = default;
+
+        /// @brief Record ``neighbor`` as a result of query ``query``.
+        void push_back(size_t query, neighbor_type neighbor) {
+            queries_.push_back(query);
+            neighbors_.push_back(neighbor);
+        }
+
+        /// @brief Remove all staged results, retaining allocated memory.
+        void clear() {
+            queries_.clear();
+            neighbors_.clear();
+        }
+
+        /// @brief Return the number of staged neighbors.
+        size_t size() const { return neighbors_.size(); }
+
+      private:
+        friend class RangeSearchResult;
+
+        // ``queries_[i]`` is the query that ``neighbors_[i]`` belongs to.
+        std::vector<size_t> queries_{};
+        std::vector<neighbor_type> neighbors_{};
+    };
+
+    RangeSearchResult() = default;
+
+    ///
+    /// @brief Reset the result to receive results for ``n_queries`` queries.
+    ///
+    /// @param n_queries The number of queries.
+    /// @param n_partials The number of partials (usually one per thread) to provide.
+    ///
+    /// Clears any previous results.
+    ///
+    void prepare(size_t n_queries, size_t n_partials) {
+        n_queries_ = n_queries;
+        if (partials_.size() < n_partials) {
+            partials_.resize(n_partials);
+        }
+        for (auto& partial : partials_) {
+            partial.unwrap().clear();
+        }
+        offsets_.assign(n_queries + 1, 0);
+        neighbors_.clear();
+    }
+
+    /// @brief Return partial ``i``. Requires ``i`` less than ``n_partials`` in ``prepare``.
+    Partial& partial(size_t i) { return partials_.at(i).unwrap(); }
+
+    ///
+    /// @brief Gather the staged results of all partials into the final CSR layout.
+    ///
+    /// Neighbors of each query are sorted from best to worst using ``Cmp``. The staging
+    /// areas are cleared afterwards.
+    ///
+    template <typename Cmp> void finish(Cmp compare) {
+        // Counting sort of the staged neighbors by query.
+        std::fill(offsets_.begin(), offsets_.end(), 0);
+        for (const auto& padded : partials_) {
+            for (auto query : padded.unwrap().queries_) {
+                if (query >= n_queries_) {
+                    throw ANNEXCEPTION(
+                        "Query ", query, " is out of bounds for ", n_queries_, '!'
+                    );
+                }
+                ++offsets_[query + 1];
+            }
+        }
+        for (size_t i = 0; i < n_queries_; ++i) {
+            offsets_[i + 1] += offsets_[i];
+        }
+
+        // Scatter the staged neighbors into place. ``cursor_[i]`` is the next free
+        // position for query ``i``.
+        neighbors_.resize(offsets_.back());
+        cursor_.assign(offsets_.begin(), offsets_.end() - 1);
+        for (auto& padded : partials_) {
+            auto& partial = padded.unwrap();
+            for (size_t i = 0, imax = partial.size(); i < imax; ++i) {
+                neighbors_[cursor_[partial.queries_[i]]++] = partial.neighbors_[i];
+            }
+            partial.clear();
+        }
+
+        auto by_distance = [&](const neighbor_type& a, const neighbor_type& b) {
+            return compare(a.distance(), b.distance());
+        };
+        for (size_t i = 0; i < n_queries_; ++i) {
+            auto first = neighbors_.begin() + offsets_[i];
+            auto last = neighbors_.begin() + offsets_[i + 1];
+            if (!std::is_sorted(first, last, by_distance)) {
+                std::sort(first, last, by_distance);
+            }
+        }
+    }
+
+    /// @brief Return the number of queries.
+    size_t n_queries() const { return n_queries_; }
+
+    /// @brief Return the number of neighbors found for query ``i``.
+    size_t n_neighbors(size_t i) const { return offsets_.at(i + 1) - offsets_.at(i); }
+
+    /// @brief Return the total number of neighbors across all queries.
+    size_t size() const { return neighbors_.size(); }
+
+    /// @brief Return the neighbors of query ``i`` sorted from best to worst.
+    std::span<const neighbor_type> neighbors(size_t i) const {
+        return {neighbors_.data() + offsets_.at(i), n_neighbors(i)};
+    }
+
+    /// @brief Return the ID of the ``j``th neighbor of query ``i``.
+    Idx index(size_t i, size_t j) const { return neighbors(i)[j].id(); }
+
+    /// @brief Return the distance of the ``j``th neighbor of query ``i``.
+    float distance(size_t i, size_t j) const { return neighbors(i)[j].distance(); }
+
+    /// @brief Return the offsets of each query into ``neighbors()``. Has
+    /// ``n_queries() + 1`` entries.
+    const std::vector<size_t>& offsets() const { return offsets_; }
+
+    /// @brief Return the neighbors of all queries.
+    const std::vector<neighbor_type>& neighbors() const { return neighbors_; }
+
+  private:
+    size_t n_queries_ = 0;
+    std::vector<size_t> offsets_ = std::vector<size_t>(1, 0);
+    std::vector<neighbor_type> neighbors_{};
+    std::vector<threads::Padded<Partial>> partials_{};
+    std::vector<size_t> cursor_{};
+};
+
+} // namespace svs
@@ -13,19 +13,24 @@
 
 // Flat index utilities
 #include "svs/index/flat/inserters.h"
+#include "svs/index/flat/tiled.h"
 
 // svs
 #include "svs/concepts/distance.h"
 #include "svs/core/data.h"
 #include "svs/core/distance.h"
 #include "svs/core/query_result.h"
+#include "svs/core/range_result.h"
 #include "svs/lib/neighbor.h"
 #include "svs/lib/threads.h"
 #include "svs/lib/traits.h"
 #include "svs/quantization/lvq/lvq.h"
 
 // stdlib
+#include <span>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace svs::index::flat {
 
@@ -80,8 +85,16 @@ class FlatIndex {
     using thread_pool_type = threads::NativeThreadPool;
     using compare = distance::compare_t<Dist>;
     using sorter_type = BulkInserter<Neighbor<size_t>, compare>;
+    /// The distance functor specialized for the dataset.
+    using adapted_distance_type = std::remove_cvref_t<
+        decltype(std::declval<const Data&>().adapt_distance(std::declval<const Dist&>()))>;
+    using broadcast_distance_type = distance::BroadcastDistance<adapted_distance_type>;
 
     static const size_t default_data_batch_size = 100'000;
+    /// The largest ``queries.size() * num_neighbors`` for which ``search`` keeps its result
+    /// buffers for reuse by the next call. Larger buffers are released when ``search``
+    /// returns.
+    static constexpr size_t max_cached_neighbors = 1 << 20;
 
     // Compute data and threadpool storage types.
     using data_storage_type = storage_type_t<Ownership, Data>;
@@ -95,25 +108,48 @@ class FlatIndex {
     // Constructs controlling the iteration strategy over the data and queries.
     size_t data_batch_size_ = 0;
     size_t query_batch_size_ = 0;
+    // Strategy for maintaining the nearest neighbors of each query.
+    InserterKind inserter_kind_ = InserterKind::heap;
+
+    // Scratch space reused across calls to search.
+    threads::ScratchPool<sorter_type> sorter_scratch_{};
+    threads::ScratchPool<broadcast_distance_type> distance_scratch_{};
+    // Used only by the tiled kernel.
+    threads::ScratchPool<TiledScratch> tiled_scratch_{};
+    threads::ScratchPool<std::vector<float>> norm_scratch_{};
 
     // Helpers methods to obtain automatic batch sizing.
 
     // Automatic behavior: Use the default batch size.
-    size_t compute_data_batch_size() const {
-        if (data_batch_size_ == 0) {
-            return default_data_batch_size;
-        } else {
+    // When the blocked kernel is used, size the batch so the dataset elements of a batch
+    // fit in roughly half of the last level cache, rounded to a whole number of tiles.
+    template <typename QueryType> size_t compute_data_batch_size() const {
+        if (data_batch_size_ != 0) {
             return std::min(data_batch_size_, data_.size());
         }
+        if constexpr (use_tiled_search_v<Data, QueryType, Dist>) {
+            size_t dims = std::max(data_.dimensions(), size_t{1});
+            size_t tile = data_tile_size(dims);
+            size_t batch = (l3_cache_bytes() / 2) / (dims * sizeof(float));
+            return std::max(tile, batch - batch % tile);
+        } else {
+            return default_data_batch_size;
+        }
     }
 
     // Automatic behavior: Evenly divide queries over the threads.
+    // When the blocked kernel is used, additionally cap the batch so the queries of a
+    // batch remain resident in the L2 cache.
+    template <typename QueryType>
     size_t compute_query_batch_size(size_t num_queries) const {
-        if (query_batch_size_ == 0) {
-            return lib::div_round_up(num_queries, threadpool_.size());
-        } else {
+        if (query_batch_size_ != 0) {
             return query_batch_size_;
         }
+        size_t batch = lib::div_round_up(num_queries, threadpool_.size());
+        if constexpr (use_tiled_search_v<Data, QueryType, Dist>) {
+            batch = std::min(batch, query_tile_size(data_.dimensions()));
+        }
+        return std::max(batch, size_t{1});
     }
 
   public:
@@ -217,6 +253,10 @@ class FlatIndex {
     /// - The value type of ``queries`` is compatible with the value type of the index
     ///     dataset with respect to the stored distance functor.
     ///
+    /// The buffers holding the neighbors of each query are kept for reuse by the next
+    /// call unless they hold more than ``max_cached_neighbors`` entries.
+    /// See ``clear_scratch`` to release them explicitly.
+    ///
     /// **Implementation Details**
     ///
     /// The internal call stack looks something like this.
@@ -245,16 +285,30 @@ class FlatIndex {
         // Partition the data into `data_batch_size_` chunks.
         // This will keep all threads at least working on the same sub-region of the dataset
         // to provide somewhat better locality.
-        auto data_batch_size = compute_data_batch_size();
+        auto data_batch_size = compute_data_batch_size<QueryType>();
 
         // Allocate query processing space.
-        sorter_type scratch{queries.size(), num_neighbors, compare()};
+        // Reuse the space of a previous search if possible. It is only reallocated when
+        // the number of queries or neighbors changes and is not kept after large searches.
+        auto cached = sorter_scratch_.acquire(1);
+        auto& slot = cached[0];
+        if (slot.has_value() && slot->kind() == inserter_kind_) {
+            slot->resize(queries.size(), num_neighbors);
+        } else {
+            slot.emplace(queries.size(), num_neighbors, compare(), inserter_kind_);
+        }
+        sorter_type& scratch = *slot;
         scratch.prepare();
 
         size_t start = 0;
         while (start < data_.size()) {
             size_t stop = std::min(data_max_size, start + data_batch_size);
-            search_subset(queries, threads::UnitRange(start, stop), scratch, predicate);
+            search_subset(
+                queries,
+                threads::UnitRange(start, stop),
+                [&](uint64_t /*tid*/) -> sorter_type& { return scratch; },
+                predicate
+            );
             start = stop;
         }
 
@@ -276,34 +330,152 @@ class FlatIndex {
                 }
             }
         );
+        if (queries.size() * num_neighbors > max_cached_neighbors) {
+            slot.reset();
+        }
     }
 
+    ///
+    /// @brief Find all dataset elements within ``radius`` of each query.
+    ///
+    /// @param queries The queries. Each entry will be processed.
+    /// @param radius The search radius. For distances where smaller is better, elements
+    ///     with a distance of at most ``radius`` are returned. For similarities where
+    ///     larger is better, elements with a similarity of at least ``radius`` are
+    ///     returned.
+    /// @param result The result to populate. Reusing the same result across calls avoids
+    ///     reallocating its storage.
+    /// @param predicate Dataset elements for which the predicate returns ``false`` are
+    ///     skipped. See \ref flat_class_search_mutating "search" for details.
+    ///
+    /// Distances are computed by the same kernels as ``search`` and compared against the
+    /// radius as each block of distances is produced. The neighbors of each query are
+    /// sorted from best to worst.
+    ///
     template <typename QueryType, typename Pred = lib::Returns<lib::Const<true>>>
+    void range_search(
+        const data::ConstSimpleDataView<QueryType>& queries,
+        float radius,
+        RangeSearchResult<size_t>& result,
+        Pred predicate = lib::Returns(lib::Const<true>())
+    ) {
+        const size_t data_max_size = data_.size();
+        auto data_batch_size = compute_data_batch_size<QueryType>();
+        result.prepare(queries.size(), threadpool_.size());
+
+        size_t start = 0;
+        while (start < data_.size()) {
+            size_t stop = std::min(data_max_size, start + data_batch_size);
+            search_subset(
+                queries,
+                threads::UnitRange(start, stop),
+                [&](uint64_t tid) {
+                    return RangeInserter<compare>{result.partial(tid), radius};
+                },
+                predicate
+            );
+            start = stop;
+        }
+        result.finish(compare());
+    }
+
+    /// @copydoc range_search
+    template <
+        data::ImmutableMemoryDataset Queries,
+        typename Pred = lib::Returns<lib::Const<true>>>
+    void range_search(
+        const Queries& queries,
+        float radius,
+        RangeSearchResult<size_t>& result,
+        Pred predicate = lib::Returns(lib::Const<true>())
+    ) {
+        range_search(queries.cview(), radius, result, predicate);
+    }
+
+    // Compare all queries with the dataset elements in ``data_indices``.
+    //
+    // ``get_inserter(tid)`` returns the inserter receiving the distances computed by
+    // thread ``tid``, either by reference or by value.
+    template <
+        typename QueryType,
+        typename GetInserter,
+        typename Pred = lib::Returns<lib::Const<true>>>
     void search_subset(
         const data::ConstSimpleDataView<QueryType>& queries,
         const threads::UnitRange<size_t>& data_indices,
-        sorter_type& scratch,
+        const GetInserter& get_inserter,
         Pred predicate = lib::Returns(lib::Const<true>())
     ) {
+        // The tiled kernel needs the squared norms of the dataset elements for L2.
+        // Compute them once for the whole subset rather than once per query batch.
+        constexpr bool needs_norms = use_tiled_search_v<Data, QueryType, Dist> &&
+                                     std::is_same_v<Dist, distance::DistanceL2>;
+        auto norms = norm_scratch_.acquire(needs_norms ? 1 : 0);
+        auto data_norms = std::span<const float>();
+        if constexpr (needs_norms) {
+            auto& buffer = norms[0].has_value() ? *norms[0] : norms[0].emplace();
+            buffer.resize(data_indices.size());
+            threads::run(
+                threadpool_,
+                threads::StaticPartition(data_indices.size()),
+                [&](const auto& is, uint64_t /*tid*/) {
+                    auto range = threads::UnitRange(is);
+                    compute_data_norms(
+                        data_,
+                        threads::UnitRange(
+                            data_indices.start() + range.start(),
+                            data_indices.start() + range.stop()
+                        ),
+                        std::span<float>(buffer.data() + range.start(), range.size())
+                    );
+                }
+            );
+            data_norms = std::span<const float>(buffer);
+        }
+
         // Process all queries.
+        auto distances = distance_scratch_.acquire(threadpool_.size());
+        auto tiled = tiled_scratch_.acquire(
+            use_tiled_search_v<Data, QueryType, Dist> ? threadpool_.size() : 0
+        );
         threads::run(
             threadpool_,
             threads::DynamicPartition{
-                queries.size(), compute_query_batch_size(queries.size())},
-            [&](const auto& query_indices, uint64_t /*tid*/) {
+                queries.size(), compute_query_batch_size<QueryType>(queries.size())},
+            [&](const auto& query_indices, uint64_t tid) {
                 // Broadcast the distance functor so each thread can process all queries
-                // in its current batch.
-                distance::BroadcastDistance distances{
-                    data_.adapt_distance(distance_), query_indices.size()};
-
-                search_patch(
-                    queries,
-                    data_indices,
-                    threads::UnitRange(query_indices),
-                    scratch,
-                    distances,
-                    predicate
-                );
+                // in its current batch. The functors are kept for later batches.
+                auto& slot = distances.at(tid);
+                if (!slot.has_value()) {
+                    slot.emplace(data_.adapt_distance(distance_), query_indices.size());
+                } else if (slot->size() < query_indices.size()) {
+                    slot->resize(query_indices.size());
+                }
+
+                decltype(auto) inserter = get_inserter(tid);
+                if constexpr (use_tiled_search_v<Data, QueryType, Dist>) {
+                    auto& tls = tiled.at(tid);
+                    tiled_search_patch(
+                        queries,
+                        data_,
+                        (*slot)[0],
+                        data_indices,
+                        threads::UnitRange(query_indices),
+                        data_norms,
+                        tls.has_value() ? *tls : tls.emplace(),
+                        inserter,
+                        predicate
+                    );
+                } else {
+                    search_patch(
+                        queries,
+                        data_indices,
+                        threads::UnitRange(query_indices),
+                        inserter,
+                        *slot,
+                        predicate
+                    );
+                }
             }
         );
     }
@@ -313,15 +485,19 @@ class FlatIndex {
     //
     // Insert the computed distance for each query/distance pair into `scratch`, which
     // will maintain the correct number of nearest neighbors.
+    //
+    // Combinations supported by the tiled kernel are dispatched directly to
+    // ``tiled_search_patch`` by ``search_subset`` instead.
     template <
         typename QueryType,
+        typename Inserter,
         typename DistFull,
         typename Pred = lib::Returns<lib::Const<true>>>
     void search_patch(
         const data::ConstSimpleDataView<QueryType>& queries,
         const threads::UnitRange<size_t>& data_indices,
         const threads::UnitRange<size_t>& query_indices,
-        sorter_type& scratch,
+        Inserter& scratch,
         distance::BroadcastDistance<DistFull>& distance_functors,
         Pred predicate = lib::Returns(lib::Const<true>())
     ) {
@@ -391,6 +567,38 @@ class FlatIndex {
     void set_query_batch_size(size_t query_batch_size) {
         query_batch_size_ = query_batch_size;
     }
+
+    ///
+    /// @brief Return the strategy used to maintain the nearest neighbors during search.
+    ///
+    /// @sa set_inserter_kind
+    ///
+    InserterKind get_inserter_kind() const { return inserter_kind_; }
+
+    ///
+    /// @brief Set the strategy used to maintain the nearest neighbors during search.
+    ///
+    /// Defaults to ``InserterKind::heap``. The buffered strategy is opt-in: it can be
+    /// faster when many neighbors are requested, but allocates candidate storage of at
+    /// least twice the number of requested neighbors for each query.
+    ///
+    void set_inserter_kind(InserterKind kind) { inserter_kind_ = kind; }
+
+    ///
+    /// @brief Release the scratch space kept for reuse across searches.
+    ///
+    /// Search keeps per-query result buffers and per-thread distance buffers so that
+    /// repeated calls do not reallocate them. This frees that memory, for example after
+    /// a one-off large batch. The next search reallocates what it needs.
+    ///
+    /// Must not be called concurrently with a search.
+    ///
+    void clear_scratch() {
+        sorter_scratch_.clear();
+        distance_scratch_.clear();
+        tiled_scratch_.clear();
+        norm_scratch_.clear();
+    }
 };
 
 /// @brief Forward an existing dataset.
@@ -13,13 +13,25 @@
 
 // stdlib
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 // svs
+#include "svs/core/distance/dispatch.h"
+#include "svs/core/range_result.h"
 #include "svs/lib/array.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/type_traits.h"
 
+// intrinsics
+#include <x86intrin.h>
+
 namespace svs::index::flat {
 template <std::random_access_iterator T, typename Cmp> struct LinearInserter {
     // Members
@@ -49,6 +61,9 @@ template <std::random_access_iterator T, typename Cmp> struct LinearInserter {
         (*pos) = x;
     }
 
+    // Candidates comparing worse than the threshold are rejected by ``insert``.
+    const value_type& threshold() const { return *(end_ - 1); }
+
     // Fill the range with sentinel types.
     void prepare() { std::fill(begin_, end_, type_traits::sentinel_v<value_type, Cmp>); }
 
@@ -90,6 +105,9 @@ template <std::random_access_iterator T, typename Cmp> struct HeapInserter {
         std::push_heap(begin_, end_, compare_);
     }
 
+    // Candidates comparing worse than the threshold are rejected by ``insert``.
+    const value_type& threshold() const { return *begin_; }
+
     // Fill the range with sentinel types.
     void prepare() {
         auto sentinel = type_traits::sentinel_v<value_type, Cmp>;
@@ -104,6 +122,178 @@ template <std::random_access_iterator T, typename Cmp> struct HeapInserter {
 template <typename T, typename Cmp>
 HeapInserter(T begin, T end, Cmp compare_) -> HeapInserter<T, Cmp>;
 
+///
+/// @brief Buffered top-k selection.
+///
+/// The range ``[begin, end)`` is split into the current best ``num_neighbors`` results
+/// followed by a candidate buffer. Candidates that compare better than the current
+/// threshold are appended to the buffer without any ordering work. When the buffer fills,
+/// ``std::nth_element`` selects the best ``num_neighbors`` elements of the whole range
+/// and the threshold tightens to the worst of these.
+///
+/// Compared to the ``HeapInserter``, this replaces a ``pop_heap``/``push_heap`` pair for
+/// each accepted candidate with an amortized constant number of comparisons. It works best
+/// when most candidates are rejected by the threshold.
+///
+template <std::random_access_iterator T, typename Cmp> struct BufferedInserter {
+    // Members
+    T begin_;
+    T end_;
+    size_t num_neighbors_;
+    // The number of occupied elements in ``[begin_, end_)``.
+    // Always at least ``num_neighbors_``.
+    size_t& size_;
+    [[no_unique_address]] Cmp compare_;
+
+    // Constructor
+    BufferedInserter(T begin, T end, size_t num_neighbors, size_t& size, Cmp compare)
+        : begin_{begin}
+        , end_{end}
+        , num_neighbors_{num_neighbors}
+        , size_{size}
+        , compare_{compare} {}
+
+    // Type aliases.
+    using value_type = std::remove_cvref_t<decltype(*begin_)>;
+
+    // Insert
+    void insert(value_type x) {
+        if (!compare_(x, threshold())) {
+            return;
+        }
+        *(begin_ + size_) = x;
+        ++size_;
+        if (begin_ + size_ == end_) {
+            flush();
+        }
+    }
+
+    // Candidates comparing worse than the threshold are rejected by ``insert``.
+    // Until the first flush, the threshold is the sentinel.
+    const value_type& threshold() const { return *(begin_ + (num_neighbors_ - 1)); }
+
+    // Move the best `num_neighbors_` elements to the front and empty the buffer.
+    void flush() {
+        auto nth = begin_ + (num_neighbors_ - 1);
+        std::nth_element(begin_, nth, begin_ + size_, compare_);
+        size_ = num_neighbors_;
+    }
+
+    // Fill the range with sentinel types.
+    void prepare() {
+        std::fill(begin_, end_, type_traits::sentinel_v<value_type, Cmp>);
+        size_ = num_neighbors_;
+    }
+
+    // Sort the results into the first `num_neighbors_` elements.
+    void cleanup() {
+        flush();
+        std::sort(begin_, begin_ + num_neighbors_, compare_);
+    }
+};
+
+// Deduction guide
+template <typename T, typename Cmp>
+BufferedInserter(T begin, T end, size_t num_neighbors, size_t& size, Cmp compare_)
+    -> BufferedInserter<T, Cmp>;
+
+///
+/// @brief The strategy used to maintain the nearest neighbors of each query.
+///
+enum class InserterKind {
+    /// Keep each set of neighbors sorted. Suitable for very small neighbor counts.
+    linear,
+    /// Keep each set of neighbors as a binary heap.
+    heap,
+    /// Buffer candidates passing the current threshold and periodically select the best.
+    buffered
+};
+
+namespace detail {
+
+// Comparisons with a float threshold that can be vectorized.
+// Candidates equal to the threshold are forwarded as the inserters break ties themselves.
+template <typename Cmp> inline constexpr bool is_vectorizable_compare_v = false;
+template <> inline constexpr bool is_vectorizable_compare_v<std::less<>> = true;
+template <> inline constexpr bool is_vectorizable_compare_v<std::greater<>> = true;
+
+template <typename Cmp> constexpr int avx_predicate() {
+    return std::is_same_v<Cmp, std::less<>> ? _CMP_LE_OQ : _CMP_GE_OQ;
+}
+
+template <typename Inserter, typename I>
+void insert_batch_generic(
+    Inserter& inserter, std::span<const I> ids, std::span<const float> distances
+) {
+    for (size_t j = 0, jmax = ids.size(); j < jmax; ++j) {
+        inserter.insert({ids[j], distances[j]});
+    }
+}
+
+template <typename Cmp, typename Inserter, typename I>
+SVS_TARGET_AVX2 void insert_batch_avx2(
+    Inserter& inserter, std::span<const I> ids, std::span<const float> distances
+) {
+    const size_t n = ids.size();
+    const size_t upper = n - n % 8;
+    const float* d = distances.data();
+    for (size_t j = 0; j < upper; j += 8) {
+        auto threshold = _mm256_set1_ps(inserter.threshold().distance());
+        auto cmp = _mm256_cmp_ps(_mm256_loadu_ps(d + j), threshold, avx_predicate<Cmp>());
+        auto mask = static_cast<uint32_t>(_mm256_movemask_ps(cmp));
+        while (mask != 0) {
+            size_t k = j + static_cast<size_t>(__builtin_ctz(mask));
+            inserter.insert({ids[k], d[k]});
+            mask &= mask - 1;
+        }
+    }
+    insert_batch_generic(inserter, ids.subspan(upper), distances.subspan(upper));
+}
+
+template <typename Cmp, typename Inserter, typename I>
+SVS_TARGET_AVX512F void insert_batch_avx512(
+    Inserter& inserter, std::span<const I> ids, std::span<const float> distances
+) {
+    const size_t n = ids.size();
+    const float* d = distances.data();
+    for (size_t j = 0; j < n; j += 16) {
+        auto lanes = std::min(n - j, size_t{16});
+        auto load_mask = static_cast<__mmask16>((uint32_t{1} << lanes) - 1);
+        auto threshold = _mm512_set1_ps(inserter.threshold().distance());
+        auto values = _mm512_maskz_loadu_ps(load_mask, d + j);
+        uint32_t mask = _mm512_mask_cmp_ps_mask(
+            load_mask, values, threshold, avx_predicate<Cmp>()
+        );
+        while (mask != 0) {
+            size_t k = j + static_cast<size_t>(__builtin_ctz(mask));
+            inserter.insert({ids[k], d[k]});
+            mask &= mask - 1;
+        }
+    }
+}
+
+// Insert the candidates ``{ids[j], distances[j]}``, using SIMD comparisons against the
+// inserter's threshold to skip rejected candidates in bulk.
+template <typename Cmp, typename Inserter, typename I>
+void insert_batch(
+    Inserter& inserter, std::span<const I> ids, std::span<const float> distances
+) {
+    if constexpr (is_vectorizable_compare_v<Cmp>) {
+        switch (distance::active_isa()) {
+            case distance::ISA::avx512vnni:
+            case distance::ISA::avx512f:
+                return insert_batch_avx512<Cmp>(inserter, ids, distances);
+            case distance::ISA::avx2:
+                return insert_batch_avx2<Cmp>(inserter, ids, distances);
+            case distance::ISA::generic:
+                break;
+        }
+    }
+    insert_batch_generic(inserter, ids, distances);
+}
+
+} // namespace detail
+
 ///
 /// Bulk inserter managing mulitple sets of nearest neighbors.
 ///
@@ -113,9 +303,21 @@ template <typename T, typename Cmp> class BulkInserter {
     using value_type = T;
 
     // Constructor
-    BulkInserter(size_t batch_size, size_t num_neighbors, Cmp compare)
-        : data_{batch_size, num_neighbors}
-        , compare_{compare} {}
+    BulkInserter(
+        size_t batch_size,
+        size_t num_neighbors,
+        Cmp compare,
+        InserterKind kind = InserterKind::heap
+    )
+        : data_{batch_size, row_length(kind, num_neighbors)}
+        , sizes_(kind == InserterKind::buffered ? batch_size : 0)
+        , num_neighbors_{num_neighbors}
+        , kind_{kind}
+        , compare_{compare} {
+        if (num_neighbors == 0) {
+            throw ANNEXCEPTION("Number of neighbors must be at least 1!");
+        }
+    }
 
     BulkInserter()
         : data_{1, 1}
@@ -125,15 +327,31 @@ template <typename T, typename Cmp> class BulkInserter {
     /// Prepare for bulk insertion.
     ///
     void prepare() {
-        for (size_t i = 0; i < getsize<0>(data_); ++i) {
-            inserter(i).prepare();
-        }
+        visit_all([](auto inserter) { inserter.prepare(); });
     }
 
     ///
     /// Insert an element into batch `i`.
     ///
-    void insert(size_t i, T x) { inserter(i).insert(x); }
+    void insert(size_t i, T x) {
+        visit(i, [&](auto inserter) { inserter.insert(x); });
+    }
+
+    ///
+    /// @brief Insert the elements ``{ids[j], distances[j]}`` into batch ``i``.
+    ///
+    /// Candidates are compared against the current threshold of the batch several at a
+    /// time using SIMD instructions when possible, making this considerably faster than
+    /// calling ``insert`` for each element when most candidates are rejected.
+    ///
+    template <typename I>
+        requires std::is_constructible_v<T, I, float>
+    void insert(size_t i, std::span<const I> ids, std::span<const float> distances) {
+        assert(ids.size() == distances.size());
+        visit(i, [&](auto inserter) {
+            detail::insert_batch<Cmp>(inserter, ids, distances);
+        });
+    }
 
     // TODO: When using the linear inserter - there's nothing to do when cleaning up.
     // When using a heap based inserter, however, we will indeed need to perform a final
@@ -142,20 +360,23 @@ template <typename T, typename Cmp> class BulkInserter {
     // We might be able to propagate a trait to avoid doing this loop if no work actually
     // needs to be done (that is, if the compiler is unable to remove the loop itself).
     void cleanup() {
-        for (size_t i = 0; i < getsize<0>(data_); ++i) {
-            inserter(i).cleanup();
-        }
+        visit_all([](auto inserter) { inserter.cleanup(); });
     }
 
     ///
     /// Return a view of the underlying data.
     ///
+    /// After ``cleanup``, the results for each batch are the first ``num_neighbors()``
+    /// elements of the corresponding row.
+    ///
     ConstMatrixView<T> view() const { return data_.view(); }
 
     ///
     /// Return the results for batch `i`.
     ///
-    std::span<const T, Dynamic> result(size_t i) const { return data_.slice(i); }
+    std::span<const T, Dynamic> result(size_t i) const {
+        return data_.slice(i).first(num_neighbors_);
+    }
 
     ///
     /// Return the currently configured batch size.
@@ -165,14 +386,23 @@ template <typename T, typename Cmp> class BulkInserter {
     ///
     /// Return the currently configured number of neighbors.
     ///
-    size_t num_neighbors() const { return getsize<1>(data_); }
+    size_t num_neighbors() const { return num_neighbors_; }
+
+    ///
+    /// Return the strategy used to maintain the nearest neighbors.
+    ///
+    InserterKind kind() const { return kind_; }
 
     ///
     /// Resize the underlying data buffer.
     ///
     void resize(size_t new_batch_size, size_t new_num_neighbors) {
         if (batch_size() != new_batch_size || num_neighbors() != new_num_neighbors) {
-            data_ = make_dense_array<T>(new_batch_size, new_num_neighbors);
+            data_ = make_dense_array<T>(
+                new_batch_size, row_length(kind_, new_num_neighbors)
+            );
+            sizes_.resize(kind_ == InserterKind::buffered ? new_batch_size : 0);
+            num_neighbors_ = new_num_neighbors;
         }
     }
 
@@ -190,14 +420,86 @@ template <typename T, typename Cmp> class BulkInserter {
 
   private:
     // Helper methods
-    auto inserter(size_t i) {
+
+    // The buffer holds at least 64 candidates to amortize the cost of each selection.
+    static size_t row_length(InserterKind kind, size_t num_neighbors) {
+        if (kind == InserterKind::buffered) {
+            return num_neighbors + std::max(num_neighbors, size_t{64});
+        }
+        return num_neighbors;
+    }
+
+    // Invoke `f` with the inserter for batch `i`.
+    template <typename F> void visit(size_t i, F&& f) {
         auto slice = data_.slice(i);
-        return HeapInserter{slice.begin(), slice.end(), compare_};
+        switch (kind_) {
+            case InserterKind::linear: {
+                f(LinearInserter{slice.begin(), slice.end(), compare_});
+                break;
+            }
+            case InserterKind::heap: {
+                f(HeapInserter{slice.begin(), slice.end(), compare_});
+                break;
+            }
+            case InserterKind::buffered: {
+                f(BufferedInserter{
+                    slice.begin(), slice.end(), num_neighbors_, sizes_[i], compare_});
+                break;
+            }
+        }
+    }
+
+    template <typename F> void visit_all(F&& f) {
+        for (size_t i = 0; i < batch_size(); ++i) {
+            visit(i, f);
+        }
     }
 
     // Members
     Matrix<T> data_;
+    // Number of occupied elements in each row of `data_` for the buffered inserter.
+    std::vector<size_t> sizes_ = {};
+    size_t num_neighbors_ = 1;
+    InserterKind kind_ = InserterKind::heap;
     [[no_unique_address]] Cmp compare_;
 };
 
+///
+/// @brief Inserter for range search keeping every candidate within a radius.
+///
+/// Implements the same insertion interface as ``BulkInserter`` so the exhaustive search
+/// kernels apply the radius threshold directly to each freshly computed block of
+/// distances.
+///
+template <typename Cmp> class RangeInserter {
+  public:
+    using partial_type = RangeSearchResult<size_t>::Partial;
+
+    RangeInserter(partial_type& partial, float radius)
+        : partial_{partial}
+        , radius_{radius} {}
+
+    /// @brief Keep ``x`` as a result of query ``i`` if it lies within the radius.
+    void insert(size_t i, Neighbor<size_t> x) {
+        if (within_radius<Cmp>(x.distance(), radius_)) {
+            partial_.push_back(i, x);
+        }
+    }
+
+    /// @brief Keep each ``{ids[j], distances[j]}`` that lies within the radius.
+    template <typename I>
+    void insert(size_t i, std::span<const I> ids, std::span<const float> distances) {
+        assert(ids.size() == distances.size());
+        for (size_t j = 0, jmax = ids.size(); j < jmax; ++j) {
+            if (within_radius<Cmp>(distances[j], radius_)) {
+                partial_.push_back(i, Neighbor<size_t>{ids[j], distances[j]});
+            }
+        }
+    }
+
+  private:
+    partial_type& partial_;
+    float radius_;
+};
+
 } // namespace svs::index::flat
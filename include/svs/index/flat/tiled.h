@@ -0,0 +1,471 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data.h"
+#include "svs/core/distance.h"
+#include "svs/core/distance/dispatch.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/threads/types.h"
+
+// stl
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+#include <x86intrin.h>
+
+///
+/// Blocked (GEMM-style) distance computation between a block of queries and a block of
+/// dataset elements for the exhaustive search of uncompressed ``float`` datasets.
+///
+/// Rather than computing one vector-vector distance at a time, a register-blocked
+/// micro-kernel computes the inner products between several queries and several dataset
+/// elements at once, loading each dataset vector once per group of queries. Squared
+/// Euclidean distances are recovered using the precomputed norms:
+///
+///     ||q - x||^2 = ||q||^2 + ||x||^2 - 2 <q, x>
+///
+
+namespace svs::index::flat {
+
+/////
+///// Cache Sizes
+/////
+
+namespace detail {
+inline size_t cache_size_or(int name, size_t fallback) {
+    long bytes = sysconf(name);
+    return bytes > 0 ? static_cast<size_t>(bytes) : fallback;
+}
+} // namespace detail
+
+/// @brief Return the size in bytes of the per-core L1 data cache.
+inline size_t l1_cache_bytes() {
+    static const size_t bytes = detail::cache_size_or(_SC_LEVEL1_DCACHE_SIZE, 32 * 1024);
+    return bytes;
+}
+
+/// @brief Return the size in bytes of the per-core L2 cache.
+inline size_t l2_cache_bytes() {
+    static const size_t bytes = detail::cache_size_or(_SC_LEVEL2_CACHE_SIZE, 1024 * 1024);
+    return bytes;
+}
+
+/// @brief Return the size in bytes of the shared last level cache.
+inline size_t l3_cache_bytes() {
+    static const size_t bytes =
+        detail::cache_size_or(_SC_LEVEL3_CACHE_SIZE, 16 * 1024 * 1024);
+    return bytes;
+}
+
+/////
+///// Tiling Traits
+/////
+
+template <typename T> inline constexpr bool is_float_span_v = false;
+template <size_t Extent>
+inline constexpr bool is_float_span_v<std::span<const float, Extent>> = true;
+
+template <typename Dist> inline constexpr bool is_tiled_distance_v = false;
+template <> inline constexpr bool is_tiled_distance_v<distance::DistanceL2> = true;
+template <> inline constexpr bool is_tiled_distance_v<distance::DistanceIP> = true;
+
+///
+/// @brief Return ``true`` if the tiled kernel applies to the given combination.
+///
+/// Requires ``float`` queries, an uncompressed ``float`` dataset, and either the squared
+/// Euclidean distance or the inner product.
+///
+template <typename Data, typename QueryType, typename Dist>
+inline constexpr bool use_tiled_search_v = false;
+
+template <data::HasValueType Data, typename QueryType, typename Dist>
+inline constexpr bool use_tiled_search_v<Data, QueryType, Dist> =
+    std::is_same_v<QueryType, float> &&
+    is_float_span_v<data::const_value_type_t<Data>> && is_tiled_distance_v<Dist>;
+
+///
+/// @brief Return the number of dataset elements per tile for the given dimensionality.
+///
+/// Tiles are sized so the dataset vectors of a tile stay resident in half of the L1
+/// cache while all queries of the current batch are streamed past them.
+///
+inline size_t data_tile_size(size_t dimensions) {
+    size_t bytes = std::max(dimensions, size_t{1}) * sizeof(float);
+    size_t tile = (l1_cache_bytes() / 2) / bytes;
+    // Keep the tile a multiple of the widest micro-kernel.
+    return std::clamp<size_t>(tile - tile % 32, 32, 256);
+}
+
+///
+/// @brief Return the number of queries that fit in half of the L2 cache.
+///
+inline size_t query_tile_size(size_t dimensions) {
+    size_t bytes = std::max(dimensions, size_t{1}) * sizeof(float);
+    return std::max<size_t>((l2_cache_bytes() / 2) / bytes, 4);
+}
+
+/////
+///// Micro Kernels
+/////
+
+// The dataset vectors of a tile are first packed into panels of ``Block::data`` vectors
+// stored dimension-major: ``panel[k * Block::data + j] = x[j][k]``. A micro-kernel then
+// computes a ``Block::queries x Block::data`` block of inner products by broadcasting one
+// query component at a time against a full panel row. Each accumulator holds results for
+// distinct dataset elements, so no horizontal reductions are required.
+
+namespace detail {
+
+template <size_t Q, size_t D> struct GenericBlock {
+    static constexpr size_t queries = Q;
+    static constexpr size_t data = D;
+
+    static void compute(
+        const float* const* q, const float* panel, size_t dims, float* out, size_t ldo
+    ) {
+        float acc[Q][D] = {};
+        for (size_t k = 0; k < dims; ++k) {
+            const float* x = panel + k * D;
+            for (size_t i = 0; i < Q; ++i) {
+                float qk = q[i][k];
+                for (size_t j = 0; j < D; ++j) {
+                    acc[i][j] += qk * x[j];
+                }
+            }
+        }
+        for (size_t i = 0; i < Q; ++i) {
+            for (size_t j = 0; j < D; ++j) {
+                out[i * ldo + j] = acc[i][j];
+            }
+        }
+    }
+};
+
+// 4 x 16 block: 8 accumulators and 2 panel registers out of the 16 ymm registers.
+struct AVX2Block {
+    static constexpr size_t queries = 4;
+    static constexpr size_t data = 16;
+
+    SVS_NOINLINE SVS_TARGET_AVX2 static void compute(
+        const float* const* q, const float* panel, size_t dims, float* out, size_t ldo
+    ) {
+        const float* q0 = q[0];
+        const float* q1 = q[1];
+        const float* q2 = q[2];
+        const float* q3 = q[3];
+        __m256 acc[queries][2];
+        for (size_t i = 0; i < queries; ++i) {
+            acc[i][0] = _mm256_setzero_ps();
+            acc[i][1] = _mm256_setzero_ps();
+        }
+
+        for (size_t k = 0; k < dims; ++k) {
+            auto x0 = _mm256_loadu_ps(panel + k * data);
+            auto x1 = _mm256_loadu_ps(panel + k * data + 8);
+            const float* rows[queries] = {q0, q1, q2, q3};
+            for (size_t i = 0; i < queries; ++i) {
+                auto qk = _mm256_broadcast_ss(rows[i] + k);
+                acc[i][0] = _mm256_fmadd_ps(qk, x0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_ps(qk, x1, acc[i][1]);
+            }
+        }
+
+        for (size_t i = 0; i < queries; ++i) {
+            _mm256_storeu_ps(out + i * ldo, acc[i][0]);
+            _mm256_storeu_ps(out + i * ldo + 8, acc[i][1]);
+        }
+    }
+};
+
+// 8 x 32 block: 16 accumulators and 2 panel registers out of the 32 zmm registers.
+struct AVX512Block {
+    static constexpr size_t queries = 8;
+    static constexpr size_t data = 32;
+
+    SVS_NOINLINE SVS_TARGET_AVX512F static void compute(
+        const float* const* q, const float* panel, size_t dims, float* out, size_t ldo
+    ) {
+        const float* rows[queries];
+        __m512 acc[queries][2];
+        for (size_t i = 0; i < queries; ++i) {
+            rows[i] = q[i];
+            acc[i][0] = _mm512_setzero_ps();
+            acc[i][1] = _mm512_setzero_ps();
+        }
+
+        for (size_t k = 0; k < dims; ++k) {
+            auto x0 = _mm512_loadu_ps(panel + k * data);
+            auto x1 = _mm512_loadu_ps(panel + k * data + 16);
+            for (size_t i = 0; i < queries; ++i) {
+                auto qk = _mm512_set1_ps(rows[i][k]);
+                acc[i][0] = _mm512_fmadd_ps(qk, x0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_ps(qk, x1, acc[i][1]);
+            }
+        }
+
+        for (size_t i = 0; i < queries; ++i) {
+            _mm512_storeu_ps(out + i * ldo, acc[i][0]);
+            _mm512_storeu_ps(out + i * ldo + 16, acc[i][1]);
+        }
+    }
+};
+
+// Pack ``x`` into panels of ``D`` vectors, zero-padding the last panel.
+template <size_t D>
+void pack_panels(std::span<const float* const> x, size_t dims, std::vector<float>& packed) {
+    const size_t num_panels = lib::div_round_up(x.size(), D);
+    packed.resize(num_panels * dims * D);
+    for (size_t p = 0; p < num_panels; ++p) {
+        float* panel = packed.data() + p * dims * D;
+        for (size_t j = 0; j < D; ++j) {
+            size_t index = p * D + j;
+            if (index < x.size()) {
+                const float* src = x[index];
+                for (size_t k = 0; k < dims; ++k) {
+                    panel[k * D + j] = src[k];
+                }
+            } else {
+                for (size_t k = 0; k < dims; ++k) {
+                    panel[k * D + j] = 0;
+                }
+            }
+        }
+    }
+}
+
+template <typename Block>
+void inner_product_tile(
+    std::span<const float* const> q,
+    std::span<const float* const> x,
+    size_t dims,
+    float* out,
+    size_t ldo,
+    std::vector<float>& workspace
+) {
+    constexpr size_t Q = Block::queries;
+    constexpr size_t D = Block::data;
+    const size_t nq = q.size();
+    const size_t nx = x.size();
+    if (nq == 0 || nx == 0) {
+        return;
+    }
+    pack_panels<D>(x, dims, workspace);
+
+    // Partial blocks are staged through a local buffer. Missing queries are padded by
+    // repeating the last query.
+    float staging[Q * D];
+    const float* padded[Q];
+    for (size_t i = 0; i < nq; i += Q) {
+        const size_t rows = std::min(Q, nq - i);
+        for (size_t r = 0; r < Q; ++r) {
+            padded[r] = q[i + std::min(r, rows - 1)];
+        }
+        for (size_t j = 0; j < nx; j += D) {
+            const size_t cols = std::min(D, nx - j);
+            const float* panel = workspace.data() + (j / D) * dims * D;
+            if (rows == Q && cols == D) {
+                Block::compute(padded, panel, dims, out + i * ldo + j, ldo);
+                continue;
+            }
+            Block::compute(padded, panel, dims, staging, D);
+            for (size_t r = 0; r < rows; ++r) {
+                std::copy_n(staging + r * D, cols, out + (i + r) * ldo + j);
+            }
+        }
+    }
+}
+} // namespace detail
+
+///
+/// @brief Compute the inner products between all pairs of ``q`` and ``x``.
+///
+/// @param q Pointers to the query vectors.
+/// @param x Pointers to the dataset vectors.
+/// @param dims The number of dimensions of each vector.
+/// @param out Destination. Entry ``out[i * ldo + j]`` receives ``<q[i], x[j]>``.
+/// @param ldo The leading dimension of ``out``. Must be at least ``x.size()``.
+/// @param workspace Scratch space for packing ``x``. Resized as needed.
+///
+/// The micro-kernel is selected based on ``distance::active_isa()``.
+///
+inline void inner_product_tile(
+    std::span<const float* const> q,
+    std::span<const float* const> x,
+    size_t dims,
+    float* out,
+    size_t ldo,
+    std::vector<float>& workspace
+) {
+    switch (distance::active_isa()) {
+        case distance::ISA::avx512vnni:
+        case distance::ISA::avx512f:
+            detail::inner_product_tile<detail::AVX512Block>(
+                q, x, dims, out, ldo, workspace
+            );
+            break;
+        case distance::ISA::avx2:
+            detail::inner_product_tile<detail::AVX2Block>(q, x, dims, out, ldo, workspace);
+            break;
+        case distance::ISA::generic:
+            detail::inner_product_tile<detail::GenericBlock<4, 8>>(
+                q, x, dims, out, ldo, workspace
+            );
+            break;
+    }
+}
+
+///
+/// @brief Per-thread scratch space for ``tiled_search_patch``.
+///
+/// Reused across patches and searches so the steady state of the tiled kernel does not
+/// allocate.
+///
+struct TiledScratch {
+    std::vector<const float*> query_ptrs{};
+    std::vector<float> query_norms{};
+    std::vector<size_t> data_ids{};
+    std::vector<const float*> data_ptrs{};
+    std::vector<float> tile_norms{};
+    std::vector<float> products{};
+    std::vector<float> workspace{};
+};
+
+///
+/// @brief Compute the squared norms of the dataset elements in ``data_indices``.
+///
+/// Entry ``norms[i]`` receives the squared norm of ``data_indices[i]``.
+///
+template <typename Data>
+void compute_data_norms(
+    const Data& data, const threads::UnitRange<size_t>& data_indices, std::span<float> norms
+) {
+    assert(norms.size() >= data_indices.size());
+    const size_t dims = data.dimensions();
+    for (size_t i = 0, imax = data_indices.size(); i < imax; ++i) {
+        const float* ptr = data.get_datum(data_indices[i]).data();
+        norms[i] = distance::IP::compute(ptr, ptr, dims);
+    }
+}
+
+///
+/// @brief Exhaustive search of a patch of queries against a patch of the dataset.
+///
+/// @param queries The full set of queries.
+/// @param data The dataset.
+/// @param distance The distance functor. Must be ``DistanceL2`` or ``DistanceIP``.
+/// @param data_indices The range of dataset elements to process.
+/// @param query_indices The range of queries to process.
+/// @param data_norms For ``DistanceL2``, the squared norms of ``data_indices`` as computed
+///     by ``compute_data_norms``. Shared by all query patches of the same data range.
+///     Ignored for ``DistanceIP``.
+/// @param tls Scratch space owned by the calling thread.
+/// @param scratch The bulk inserter maintaining the nearest neighbors of each query.
+/// @param predicate Dataset elements for which the predicate returns ``false`` are skipped.
+///
+/// Processes the dataset in tiles sized by ``data_tile_size`` and computes the full
+/// ``queries x tile`` block of distances before inserting the results into ``scratch``.
+///
+template <typename Data, typename Dist, typename Sorter, typename Pred>
+void tiled_search_patch(
+    const data::ConstSimpleDataView<float>& queries,
+    const Data& data,
+    const Dist& SVS_UNUSED(distance),
+    const threads::UnitRange<size_t>& data_indices,
+    const threads::UnitRange<size_t>& query_indices,
+    std::span<const float> data_norms,
+    TiledScratch& tls,
+    Sorter& scratch,
+    const Pred& predicate
+) {
+    constexpr bool is_l2 = std::is_same_v<Dist, distance::DistanceL2>;
+    assert(!is_l2 || data_norms.size() >= data_indices.size());
+    const size_t dims = data.dimensions();
+    const size_t nq = query_indices.size();
+    const size_t tile = data_tile_size(dims);
+
+    auto& query_ptrs = tls.query_ptrs;
+    auto& query_norms = tls.query_norms;
+    query_ptrs.resize(nq);
+    query_norms.resize(nq);
+    for (size_t i = 0; i < nq; ++i) {
+        const float* ptr = queries.get_datum(query_indices[i]).data();
+        query_ptrs[i] = ptr;
+        if constexpr (is_l2) {
+            query_norms[i] = distance::IP::compute(ptr, ptr, dims);
+        }
+    }
+
+    auto& data_ids = tls.data_ids;
+    auto& data_ptrs = tls.data_ptrs;
+    auto& tile_norms = tls.tile_norms;
+    auto& products = tls.products;
+    data_ids.resize(tile);
+    data_ptrs.resize(tile);
+    tile_norms.resize(tile);
+    products.resize(nq * tile);
+
+    const size_t first = data_indices.start();
+    auto it = data_indices.begin();
+    const auto end = data_indices.end();
+    while (it != end) {
+        // Gather the next tile of dataset elements passing the predicate.
+        size_t count = 0;
+        for (; it != end && count < tile; ++it) {
+            size_t data_index = *it;
+            if (!predicate(data_index)) {
+                continue;
+            }
+            data_ids[count] = data_index;
+            data_ptrs[count] = data.get_datum(data_index).data();
+            if constexpr (is_l2) {
+                tile_norms[count] = data_norms[data_index - first];
+            }
+            ++count;
+        }
+        if (count == 0) {
+            break;
+        }
+
+        inner_product_tile(
+            std::span<const float* const>(query_ptrs),
+            std::span<const float* const>(data_ptrs.data(), count),
+            dims,
+            products.data(),
+            tile,
+            tls.workspace
+        );
+
+        // Fused top-k maintenance.
+        auto ids = std::span<const size_t>(data_ids.data(), count);
+        for (size_t i = 0; i < nq; ++i) {
+            float* row = products.data() + i * tile;
+            if constexpr (is_l2) {
+                for (size_t j = 0; j < count; ++j) {
+                    // Clamp tiny negative results caused by cancellation.
+                    row[j] = std::max(query_norms[i] + tile_norms[j] - 2.0f * row[j], 0.0f);
+                }
+            }
+            scratch.insert(query_indices[i], ids, std::span<const float>(row, count));
+        }
+    }
+}
+
+} // namespace svs::index::flat
@@ -27,14 +27,18 @@ struct VamanaBuildParameters {
         size_t window_size_,
         size_t max_candidate_pool_size_,
         size_t nthreads_,
-        bool use_full_search_history_ = true
+        bool use_full_search_history_ = true,
+        bool work_stealing_ = false,
+        bool use_visited_set_ = false
     )
         : alpha{alpha_}
         , graph_max_degree{graph_max_degree_}
         , window_size{window_size_}
         , max_candidate_pool_size{max_candidate_pool_size_}
         , nthreads{nthreads_}
-        , use_full_search_history{use_full_search_history_} {}
+        , use_full_search_history{use_full_search_history_}
+        , work_stealing{work_stealing_}
+        , use_visited_set{use_visited_set_} {}
 
     /// The pruning parameter.
     float alpha;
@@ -64,5 +68,16 @@ struct VamanaBuildParameters {
     ///
     /// The latter case may yield a slightly better graph as the cost of more search time.
     bool use_full_search_history = true;
+
+    /// Schedule vertices between threads with work stealing instead of dividing them
+    /// evenly up front. This helps when the cost of inserting vertices varies widely.
+    /// Scheduling does not affect the quality of the resulting graph.
+    bool work_stealing = false;
+
+    /// Use a visited set during the construction searches so that vertices reached
+    /// through several adjacency lists are only scored once. Each worker thread keeps a
+    /// table with one slot per vertex for the whole construction, which costs
+    /// ``2 * num_threads * num_vertices`` bytes of extra memory.
+    bool use_visited_set = false;
 };
 } // namespace svs::index::vamana
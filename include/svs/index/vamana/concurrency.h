@@ -0,0 +1,314 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/graph.h"
+#include "svs/lib/prefetch.h"
+#include "svs/lib/seqlock.h"
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///
+/// Synchronization helpers allowing graph search to run concurrently with the mutating
+/// operations of the ``MutableVamanaIndex``.
+///
+/// Adjacency lists are protected by sequence locks. Writers (the graph builder) take the
+/// lock for the vertex being modified, while searchers copy the adjacency list out
+/// optimistically and retry if a writer intervened. Locks are striped over vertex IDs so
+/// the lock table does not need to grow when the graph is resized.
+///
+
+namespace svs::index::vamana {
+
+///
+/// @brief A fixed size table of sequence locks striped over vertex IDs.
+///
+class VertexLocks {
+  private:
+    // Pad each lock to a full cache line so readers spinning on the lock of a frequently
+    // visited vertex are not disturbed by writes to unrelated vertices.
+    struct alignas(lib::CACHELINE_BYTES) PaddedLock {
+        SeqLock lock;
+    };
+
+  public:
+    static constexpr size_t default_num_locks = 1024;
+
+    ///
+    /// @brief Construct a lock table with ``num_locks`` locks.
+    ///
+    /// The number of locks is rounded up to the next power of two.
+    ///
+    explicit VertexLocks(size_t num_locks = default_num_locks)
+        : locks_(std::bit_ceil(std::max(num_locks, size_t{1})))
+        , mask_{locks_.size() - 1} {}
+
+    /// @brief Return the number of distinct locks in the table.
+    size_t size() const { return locks_.size(); }
+
+    /// @brief Return the lock guarding vertex ``i``.
+    SeqLock& at(size_t i) { return locks_[i & mask_].lock; }
+    /// @copydoc at(size_t)
+    const SeqLock& at(size_t i) const { return locks_[i & mask_].lock; }
+
+  private:
+    std::vector<PaddedLock> locks_;
+    size_t mask_;
+};
+
+///
+/// @brief A shared mutex that gives priority to exclusive owners.
+///
+/// New shared owners must first pass through a turnstile that a waiting exclusive owner
+/// holds, so a continuous stream of overlapping searches cannot starve structural
+/// changes to the index.
+///
+class WriterPriorityMutex {
+  public:
+    WriterPriorityMutex() = default;
+
+    void lock() {
+        std::lock_guard turnstile{turnstile_};
+        mutex_.lock();
+    }
+    void unlock() { mutex_.unlock(); }
+
+    void lock_shared() {
+        { std::lock_guard turnstile{turnstile_}; }
+        mutex_.lock_shared();
+    }
+    void unlock_shared() { mutex_.unlock_shared(); }
+
+  private:
+    std::mutex turnstile_{};
+    std::shared_mutex mutex_{};
+};
+
+///
+/// @brief The locks coordinating search with the mutating operations of an index.
+///
+/// * ``vertices``: Guards individual adjacency lists.
+/// * ``structure``: Held shared by searches and exclusively by operations that move or
+///   reallocate the graph and dataset (resizing, consolidation and compaction).
+/// * ``translation``: Held shared while translating search results and exclusively while
+///   modifying the external/internal ID translation.
+/// * ``mutation``: Serializes mutating operations with one another.
+///
+/// Locks must be acquired in the order: ``mutation``, ``structure``, ``translation``.
+///
+struct IndexLocks {
+    VertexLocks vertices{};
+    WriterPriorityMutex structure{};
+    WriterPriorityMutex translation{};
+    std::mutex mutation{};
+};
+
+///
+/// @brief Writer-side view of a graph that serializes adjacency list updates with
+///     concurrent readers.
+///
+/// All mutating operations take the sequence lock of the modified vertex. Reads are
+/// forwarded to the underlying graph without synchronization since they are only
+/// performed by the (already coordinated) graph builder.
+///
+template <graphs::MemoryGraph Graph> class LockedGraph {
+  public:
+    using index_type = typename Graph::index_type;
+    using value_type = typename Graph::value_type;
+    using const_value_type = typename Graph::const_value_type;
+    using reference = typename Graph::reference;
+    using const_reference = typename Graph::const_reference;
+
+    LockedGraph(Graph& graph, VertexLocks& locks)
+        : graph_{graph}
+        , locks_{locks} {}
+
+    size_t max_degree() const { return graph_.max_degree(); }
+    size_t n_nodes() const { return graph_.n_nodes(); }
+
+    const_reference get_node(index_type i) const { return graph_.get_node(i); }
+    size_t get_node_degree(index_type i) const { return graph_.get_node_degree(i); }
+    void prefetch_node(index_type i) const { graph_.prefetch_node(i); }
+
+    size_t add_edge(index_type src, index_type dst) {
+        std::lock_guard lock{locks_.at(src)};
+        return graph_.add_edge(src, dst);
+    }
+
+    void clear_node(index_type i) {
+        std::lock_guard lock{locks_.at(i)};
+        graph_.clear_node(i);
+    }
+
+    void replace_node(index_type i, const std::vector<index_type>& new_neighbors) {
+        replace_node(i, std::span{new_neighbors.data(), new_neighbors.size()});
+    }
+
+    void replace_node(index_type i, std::span<const index_type> new_neighbors) {
+        std::lock_guard lock{locks_.at(i)};
+        graph_.replace_node(i, new_neighbors);
+    }
+
+  private:
+    Graph& graph_;
+    VertexLocks& locks_;
+};
+
+///
+/// @brief Reader-side view of a graph returning consistent snapshots of adjacency lists
+///     while the graph is being modified through a ``LockedGraph``.
+///
+/// Each call to ``get_node`` invalidates the adjacency list returned by the previous call.
+/// As such, each search thread must use its own reader.
+///
+template <graphs::MemoryGraph Graph> class LockedGraphReader {
+  public:
+    using index_type = typename Graph::index_type;
+    using reference = std::span<const index_type>;
+    using const_reference = std::span<const index_type>;
+
+    LockedGraphReader(const Graph& graph, const VertexLocks& locks)
+        : graph_{graph}
+        , locks_{locks}
+        , buffer_(graph.max_degree()) {}
+
+    size_t max_degree() const { return graph_.max_degree(); }
+    size_t n_nodes() const { return graph_.n_nodes(); }
+
+    const_reference get_node(index_type i) const {
+        const auto& lock = locks_.at(i);
+        for (;;) {
+            auto sequence = lock.read_begin();
+            // The row may be modified under our feet. Clamp the length so a torn read
+            // never runs past the end of the row.
+            auto row = graph_.raw_row(i);
+            size_t degree = std::min<size_t>(row.front(), buffer_.size());
+            std::memcpy(buffer_.data(), row.data() + 1, degree * sizeof(index_type));
+            if (!lock.read_retry(sequence)) {
+                return const_reference{buffer_.data(), degree};
+            }
+        }
+    }
+
+    size_t get_node_degree(index_type i) const {
+        const auto& lock = locks_.at(i);
+        for (;;) {
+            auto sequence = lock.read_begin();
+            size_t degree = graph_.get_node_degree(i);
+            if (!lock.read_retry(sequence)) {
+                return degree;
+            }
+        }
+    }
+
+    void prefetch_node(index_type i) const { graph_.prefetch_node(i); }
+
+  private:
+    const Graph& graph_;
+    const VertexLocks& locks_;
+    mutable std::vector<index_type> buffer_;
+};
+
+///
+/// @brief Run a unit of work repeatedly on a dedicated thread.
+///
+/// The work function returns ``true`` when there is nothing left to do, in which case the
+/// worker sleeps for ``period`` before calling it again. Otherwise, it is called again
+/// immediately.
+///
+/// If the work function throws, the worker stops and the exception is rethrown by
+/// ``stop()``.
+///
+class BackgroundWorker {
+  public:
+    BackgroundWorker(std::function<bool()> work, std::chrono::nanoseconds period)
+        : work_{std::move(work)}
+        , period_{period}
+        , thread_{[this]() { loop(); }} {}
+
+    BackgroundWorker(const BackgroundWorker&) = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+    BackgroundWorker(BackgroundWorker&&) = delete;
+    BackgroundWorker& operator=(BackgroundWorker&&) = delete;
+
+    ~BackgroundWorker() { halt(); }
+
+    ///
+    /// @brief Stop the worker, waiting for the current unit of work to finish.
+    ///
+    /// Rethrows any exception raised by the work function.
+    ///
+    void stop() {
+        halt();
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+  private:
+    void halt() {
+        {
+            std::lock_guard lock{mutex_};
+            stop_requested_ = true;
+        }
+        condition_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    void loop() {
+        auto stopped = [this]() { return stop_requested_; };
+        for (;;) {
+            bool idle = false;
+            try {
+                idle = work_();
+            } catch (...) {
+                error_ = std::current_exception();
+                return;
+            }
+
+            std::unique_lock lock{mutex_};
+            if (idle) {
+                condition_.wait_for(lock, period_, stopped);
+            }
+            if (stop_requested_) {
+                return;
+            }
+        }
+    }
+
+    std::function<bool()> work_;
+    std::chrono::nanoseconds period_;
+    std::mutex mutex_{};
+    std::condition_variable condition_{};
+    bool stop_requested_ = false;
+    std::exception_ptr error_{};
+    // Declared last so all other members are initialized before the thread starts.
+    std::thread thread_;
+};
+
+} // namespace svs::index::vamana
@@ -13,6 +13,7 @@
 
 // local
 #include "svs/core/distance.h"
+#include "svs/core/distance/gather.h"
 #include "svs/core/graph.h"
 #include "svs/index/vamana/prune.h"
 #include "svs/lib/array.h"
@@ -23,8 +24,12 @@
 #include "tsl/robin_set.h"
 
 // stdlib
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <span>
 #include <unordered_set>
+#include <vector>
 
 namespace svs::index::vamana {
 
@@ -127,6 +132,10 @@ template <std::integral I> struct ConsolidateThreadLocal {
     set_type all_candidates{};
     neighbor_vector_type valid_candidates{};
     std::vector<I, allocator_type<I>> final_candidates{};
+    // Scratch space for scoring the valid candidates.
+    std::vector<I, allocator_type<I>> candidate_ids{};
+    std::vector<float, allocator_type<float>> candidate_distances{};
+    PruneScratch<I> prune{};
 };
 
 template <
@@ -199,30 +208,100 @@ class GraphConsolidator {
 
     template <typename SelfDistance, typename Deleted>
     void filter_candidates(
-        neighbor_vector_type& valid_candidates,
-        const set_type& all_candidates,
+        ConsolidateThreadLocal<I>& tls,
         const datum_type& src_data,
         SelfDistance& distance,
         const Deleted& is_deleted
     ) const {
+        auto& valid_candidates = tls.valid_candidates;
+        auto& ids = tls.candidate_ids;
+        auto& distances = tls.candidate_distances;
         distance::maybe_fix_argument(distance, src_data);
-        valid_candidates.clear();
-        for (auto dst : all_candidates) {
-            if (is_deleted(dst)) {
-                continue;
+        ids.clear();
+        for (auto dst : tls.all_candidates) {
+            if (!is_deleted(dst)) {
+                ids.push_back(dst);
             }
+        }
 
-            valid_candidates.push_back(
-                {dst,
-                 distance::compute(
-                     distance, src_data, data_.get_datum(dst, data::full_access)
-                 )}
-            );
+        distances.resize(ids.size());
+        distance::compute_gathered(
+            distance,
+            src_data,
+            data_,
+            std::span<const I>(ids),
+            std::span<float>(distances),
+            data::full_access
+        );
+        valid_candidates.clear();
+        for (size_t i = 0, imax = ids.size(); i < imax; ++i) {
+            valid_candidates.push_back({ids[i], distances[i]});
         }
 
         std::sort(valid_candidates.begin(), valid_candidates.end(), Compare{});
     }
 
+    ///
+    /// Compute a new adjacency list for `src` if any of its neighbors are deleted.
+    ///
+    /// Returns `true` if `src` needs an update, in which case the new adjacency list is
+    /// left in `tls.final_candidates`. Vertices for which `skip(src)` returns `true` are
+    /// never updated.
+    ///
+    template <typename SelfDistance, typename Deleted, typename Skip>
+    bool prepare_update(
+        size_t src,
+        ConsolidateThreadLocal<I>& tls,
+        SelfDistance& distance,
+        const Deleted& is_deleted,
+        const Skip& skip
+    ) const {
+        auto& all_candidates = tls.all_candidates;
+        if (skip(src)) {
+            return false;
+        }
+
+        // Determine if any of the neighbors of this node are deleted.
+        const auto& neighbors = graph_.get_node(src);
+        if (std::none_of(neighbors.begin(), neighbors.end(), is_deleted)) {
+            return false;
+        }
+
+        // Add all neighbors and neighbors-of-deleted-neighbors.
+        populate_candidates(all_candidates, neighbors, is_deleted);
+
+        // Insert non-deleted candidates into the vector to prepare for pruning.
+        filter_candidates(
+            tls, data_.get_datum(src, data::full_access), distance, is_deleted
+        );
+
+        heuristic_prune_neighbors(
+            params_.max_degree,
+            params_.alpha,
+            data_,
+            distance,
+            src,
+            lib::as_const_span(tls.valid_candidates),
+            tls.final_candidates,
+            tls.prune
+        );
+        return true;
+    }
+
+    ///
+    /// Compute a new adjacency list for `src` if any of its neighbors are deleted.
+    /// Deleted vertices are never updated.
+    ///
+    template <typename SelfDistance, typename Deleted>
+    bool prepare_update(
+        size_t src,
+        ConsolidateThreadLocal<I>& tls,
+        SelfDistance& distance,
+        const Deleted& is_deleted
+    ) const {
+        return prepare_update(src, tls, distance, is_deleted, is_deleted);
+    }
+
     template <typename Deleted>
     void generate_updates(
         const threads::UnitRange<size_t>& global_ids,
@@ -231,44 +310,11 @@ class GraphConsolidator {
         ConsolidateThreadLocal<I>& tls,
         const Deleted& is_deleted
     ) const {
-        auto& [all_candidates, valid_candidates, final_candidates] = tls;
         auto distance = data_.self_distance(distance_);
-
         for (auto i : local_ids) {
-            size_t src = global_ids[i];
-
-            if (is_deleted(src)) {
-                continue;
+            if (prepare_update(global_ids[i], tls, distance, is_deleted)) {
+                update_buffer.insert(i, tls.final_candidates);
             }
-
-            // Determine if any of the neighbors of this node are deleted.
-            const auto& neighbors = graph_.get_node(src);
-            if (std::none_of(neighbors.begin(), neighbors.end(), is_deleted)) {
-                continue;
-            }
-
-            // Add all neighbors and neighbors-of-deleted-neighbors.
-            populate_candidates(all_candidates, neighbors, is_deleted);
-
-            // Insert non-deleted candidates into the vector to prepare for pruning.
-            filter_candidates(
-                valid_candidates,
-                all_candidates,
-                data_.get_datum(src, data::full_access),
-                distance,
-                is_deleted
-            );
-
-            heuristic_prune_neighbors(
-                params_.max_degree,
-                params_.alpha,
-                data_,
-                distance,
-                src,
-                lib::as_const_span(valid_candidates),
-                final_candidates
-            );
-            update_buffer.insert(i, final_candidates);
         }
     }
 
@@ -353,4 +399,224 @@ void consolidate(
     consolidator(is_deleted);
 }
 
+/////
+///// Incremental Consolidation
+/////
+
+///
+/// Limits on the work performed by a single step of incremental consolidation.
+/// A step ends as soon as any of the limits is reached.
+///
+/// * `max_visited`: The maximum number of vertices whose adjacency lists are checked for
+///   deleted neighbors.
+/// * `max_distance_computations`: The maximum number of distance computations spent
+///   repairing adjacency lists. Distance computations made while pruning are not
+///   counted, so this limit is approximate.
+/// * `max_time`: The maximum wall-clock duration of the step.
+///
+struct ConsolidationBudget {
+    size_t max_visited = 10'000;
+    size_t max_distance_computations = std::numeric_limits<size_t>::max();
+    std::chrono::nanoseconds max_time = std::chrono::nanoseconds::max();
+};
+
+///
+/// The work performed by a single step of incremental consolidation.
+///
+/// * `visited`: The number of vertices checked for deleted neighbors.
+/// * `repaired`: The number of vertices whose adjacency lists were rewritten.
+/// * `distance_computations`: The number of distance computations (excluding pruning).
+/// * `pass_complete`: Whether the current pass finished during this step, meaning no
+///   vertex points at the targets of the pass any more.
+///
+struct ConsolidationProgress {
+    size_t visited = 0;
+    size_t repaired = 0;
+    size_t distance_computations = 0;
+    bool pass_complete = false;
+};
+
+///
+/// State for consolidating deleted vertices a bounded amount of work at a time.
+///
+/// Consolidation proceeds in passes. Each pass is started with a set of deleted "target"
+/// vertices and sweeps over every vertex of the graph, rewriting adjacency lists that
+/// contain deleted vertices. Once the sweep is complete (and vertices added during the
+/// sweep have been rechecked), no vertex can reach the targets and their slots may be
+/// reclaimed.
+///
+/// Checking a vertex only requires looking at its adjacency list, so vertices without
+/// deleted neighbors are skipped without any distance computations. Additionally,
+/// vertices that are likely to point at deleted vertices may be "hinted" (for example,
+/// the out-neighbors of a deleted vertex, since Vamana adds back edges). Hinted vertices
+/// are repaired before the sweep continues, removing most dangling edges well before the
+/// pass finishes. At most ``max_hints()`` hints are kept. Further hints are dropped
+/// since the sweep of the next pass checks every vertex anyway, so the memory used by
+/// an index that deletes often without consolidating stays bounded.
+///
+/// Only the targets themselves are exempt from repair. Vertices deleted after the pass
+/// started remain reachable by searches until a later pass, so their adjacency lists must
+/// not keep edges into the targets either.
+///
+/// This class does not synchronize access to the graph. Callers are expected to serialize
+/// steps with other mutations of the graph.
+///
+template <std::integral I> class IncrementalConsolidator {
+  public:
+    /// The default maximum number of pending hints.
+    static constexpr size_t default_max_hints = 1 << 20;
+
+    IncrementalConsolidator() = default;
+    explicit IncrementalConsolidator(size_t max_hints)
+        : max_hints_{max_hints} {}
+
+    /// Return whether a consolidation pass is in progress.
+    bool active() const { return active_; }
+
+    /// Return the deleted vertices that will be unreachable once the current pass ends.
+    const std::vector<I>& targets() const { return targets_; }
+
+    ///
+    /// Begin a consolidation pass for the deleted vertices in `targets`.
+    ///
+    void begin(std::vector<I> targets) {
+        targets_ = std::move(targets);
+        std::sort(targets_.begin(), targets_.end());
+        rechecks_.clear();
+        cursor_ = 0;
+        active_ = true;
+    }
+
+    ///
+    /// Note that vertex `i` is likely to point at a deleted vertex.
+    ///
+    /// Has no effect if ``max_hints()`` hints are already pending.
+    ///
+    void hint(I i) {
+        if (hints_.size() < max_hints_) {
+            hints_.push_back(i);
+        }
+    }
+
+    /// Return the number of hinted vertices not yet repaired.
+    size_t num_hints() const { return hints_.size(); }
+    /// Return the maximum number of pending hints.
+    size_t max_hints() const { return max_hints_; }
+
+    ///
+    /// Note that the adjacency list of vertex `i` was written after the current pass
+    /// started (for example, by an insertion) and must be checked again before the pass
+    /// may complete. Has no effect if no pass is active.
+    ///
+    void recheck(I i) {
+        if (active_) {
+            rechecks_.push_back(i);
+        }
+    }
+
+    ///
+    /// Abandon the current pass and drop all hints.
+    ///
+    void reset() {
+        active_ = false;
+        cursor_ = 0;
+        targets_.clear();
+        hints_.clear();
+        rechecks_.clear();
+    }
+
+    ///
+    /// Perform a bounded amount of consolidation.
+    ///
+    /// @param graph The graph to repair.
+    /// @param data The dataset the graph was built for.
+    /// @param distance The distance function used to prune repaired adjacency lists.
+    /// @param params The degree and pruning parameter for repaired adjacency lists.
+    /// @param budget Limits on the amount of work performed.
+    /// @param is_deleted Predicate returning `true` for vertices that may not appear in
+    ///     adjacency lists.
+    ///
+    template <
+        graphs::MemoryGraph Graph,
+        data::ImmutableMemoryDataset Data,
+        typename Distance,
+        typename Deleted>
+    ConsolidationProgress step(
+        Graph& graph,
+        const Data& data,
+        const Distance& distance,
+        const ConsolidationParameters& params,
+        const ConsolidationBudget& budget,
+        const Deleted& is_deleted
+    ) {
+        auto progress = ConsolidationProgress{};
+        auto pool = threads::SequentialThreadPool();
+        auto consolidator = GraphConsolidator{graph, data, pool, distance, params};
+        auto self_distance = data.self_distance(distance);
+
+        const auto start = lib::now();
+        auto within_budget = [&]() {
+            if (progress.visited >= budget.max_visited ||
+                progress.distance_computations >= budget.max_distance_computations) {
+                return false;
+            }
+            // Reading the clock is comparatively expensive. Only check it periodically.
+            return (progress.visited % 64) != 0 || (lib::now() - start) < budget.max_time;
+        };
+
+        // Deleted vertices that are not targets of this pass are still repaired.
+        auto is_target = [&](size_t i) {
+            return std::binary_search(targets_.begin(), targets_.end(), static_cast<I>(i));
+        };
+
+        const size_t num_nodes = graph.n_nodes();
+        auto visit = [&](size_t i) {
+            ++progress.visited;
+            if (consolidator.prepare_update(
+                    i, scratch_, self_distance, is_deleted, is_target
+                )) {
+                const auto& update = scratch_.final_candidates;
+                graph.replace_node(i, std::span<const I>(update.data(), update.size()));
+                progress.distance_computations += scratch_.valid_candidates.size();
+                ++progress.repaired;
+            }
+        };
+
+        // Repair hinted vertices first.
+        while (!hints_.empty() && within_budget()) {
+            auto i = hints_.back();
+            hints_.pop_back();
+            if (i < num_nodes) {
+                visit(i);
+            }
+        }
+
+        if (!active_) {
+            return progress;
+        }
+
+        // Continue the sweep, then check vertices modified since the pass started.
+        while (cursor_ < num_nodes && within_budget()) {
+            visit(cursor_);
+            ++cursor_;
+        }
+        while (cursor_ >= num_nodes && !rechecks_.empty() && within_budget()) {
+            auto i = rechecks_.back();
+            rechecks_.pop_back();
+            visit(i);
+        }
+        progress.pass_complete = cursor_ >= num_nodes && rechecks_.empty();
+        return progress;
+    }
+
+  private:
+    size_t max_hints_ = default_max_hints;
+    bool active_ = false;
+    size_t cursor_ = 0;
+    std::vector<I> targets_{};
+    std::vector<I> hints_{};
+    std::vector<I> rechecks_{};
+    ConsolidateThreadLocal<I> scratch_{};
+};
+
 } // namespace svs::index::vamana
@@ -12,7 +12,16 @@
 #pragma once
 
 // stdlib
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <utility>
 
 // Include the flat index to spin-up exhaustive searches on demand.
 #include "svs/index/flat/flat.h"
@@ -24,8 +33,10 @@
 #include "svs/core/medioid.h"
 #include "svs/core/query_result.h"
 #include "svs/core/translation.h"
+#include "svs/index/vamana/concurrency.h"
 #include "svs/index/vamana/consolidate.h"
 #include "svs/index/vamana/dynamic_search_buffer.h"
+#include "svs/index/vamana/entry_points.h"
 #include "svs/index/vamana/greedy_search.h"
 #include "svs/index/vamana/index.h"
 #include "svs/index/vamana/vamana_build.h"
@@ -33,32 +44,6 @@
 #include "svs/lib/threads.h"
 
 namespace svs::index::vamana {
-namespace detail {
-template <typename Data, threads::ThreadPool Pool, typename F = lib::ReturnsTrueType>
-size_t find_medioid_helper(
-    const Data& data, Pool& threadpool, F&& predicate = lib::ReturnsTrueType()
-) {
-    return utils::find_medioid(data, threadpool, std::forward<F>(predicate));
-}
-
-template <
-    size_t Primary,
-    size_t Residual,
-    size_t N,
-    typename Storage,
-    threads::ThreadPool Pool,
-    typename F = lib::ReturnsTrueType>
-size_t find_medioid_helper(
-    const quantization::lvq::LVQDataset<Primary, Residual, N, Storage>& data,
-    Pool& threadpool,
-    F&& predicate = lib::ReturnsTrueType()
-) {
-    return utils::find_medioid(
-        data, threadpool, std::forward<F>(predicate), data.decompressor()
-    );
-}
-
-} // namespace detail
 
 /////
 ///// MutableVamanaIndex
@@ -96,23 +81,97 @@ inline std::string name(SlotMetadata metadata) {
 }
 // clang-format on
 
+///
+/// Atomic storage for ``SlotMetadata``.
+///
+/// Allows slot states to be observed by searches running concurrently with insertions and
+/// deletions. Stores have release semantics and loads have acquire semantics, so a search
+/// observing a slot as ``Valid`` also observes its data.
+///
+/// Copying is provided only to allow storage in resizable containers and is not atomic
+/// with respect to concurrent stores.
+///
+class AtomicSlotMetadata {
+  public:
+    AtomicSlotMetadata(SlotMetadata value = SlotMetadata::Empty)
+        : value_{value} {}
+    AtomicSlotMetadata(const AtomicSlotMetadata& other)
+        : value_{other.load()} {}
+    AtomicSlotMetadata& operator=(const AtomicSlotMetadata& other) {
+        store(other.load());
+        return *this;
+    }
+    AtomicSlotMetadata& operator=(SlotMetadata value) {
+        store(value);
+        return *this;
+    }
+
+    SlotMetadata load() const { return value_.load(std::memory_order_acquire); }
+    void store(SlotMetadata value) { value_.store(value, std::memory_order_release); }
+    operator SlotMetadata() const { return load(); }
+
+  private:
+    std::atomic<SlotMetadata> value_;
+};
+
 class SkipBuilder {
   public:
-    SkipBuilder(const std::vector<SlotMetadata>& status)
+    SkipBuilder(const std::vector<AtomicSlotMetadata>& status)
         : status_{status} {}
 
     template <typename I>
     constexpr SkippableSearchNeighbor<I> operator()(I i, float distance) const {
-        bool skipped = getindex(status_, i) == SlotMetadata::Deleted;
         // This neighbor should be skipped if the metadata corresponding to the given index
         // marks this slot as deleted.
+        //
+        // Slots that are still being inserted are reachable by searches running
+        // concurrently with ``add_points`` and must be skipped as well.
+        bool skipped = getindex(status_, i).load() != SlotMetadata::Valid;
         return SkippableSearchNeighbor<I>(i, distance, skipped);
     }
 
   private:
-    const std::vector<SlotMetadata>& status_;
+    const std::vector<AtomicSlotMetadata>& status_;
 };
 
+namespace detail {
+inline toml::table save_slot_metadata(
+    const std::vector<AtomicSlotMetadata>& status, const lib::SaveContext& ctx
+) {
+    auto filename = ctx.generate_name("slot_metadata", "binary");
+    auto stream = lib::open_write(filename);
+    for (const auto& slot : status) {
+        lib::write_binary(stream, slot.load());
+    }
+    return toml::table(
+        {{"num_slots", prepare(status.size())},
+         {"filename", std::string(filename.filename())}}
+    );
+}
+
+inline std::vector<SlotMetadata>
+load_slot_metadata(const toml::table& table, const lib::LoadContext& ctx) {
+    auto num_slots = get<size_t>(table, "num_slots");
+    auto resolved = ctx.get_directory() / get(table, "filename").value();
+    auto stream = lib::open_read(resolved);
+    auto slots = std::vector<SlotMetadata>(num_slots);
+    for (auto& slot : slots) {
+        slot = lib::read_binary<SlotMetadata>(stream);
+        switch (slot) {
+            case SlotMetadata::Empty:
+            case SlotMetadata::Valid:
+            case SlotMetadata::Deleted: {
+                break;
+            }
+            default: {
+                throw ANNEXCEPTION("Corrupted slot metadata in ", resolved, '!');
+            }
+        }
+    }
+    return slots;
+}
+} // namespace detail
+
 template <graphs::MemoryGraph Graph, typename Data, typename Dist>
 class MutableVamanaIndex {
   public:
@@ -141,6 +200,15 @@ class MutableVamanaIndex {
     using data_type = Data;
     using entry_point_type = std::vector<Idx>;
 
+    using adapted_distance_type = std::remove_cvref_t<
+        decltype(std::declval<const Data&>().adapt_distance(std::declval<const Dist&>()))>;
+
+    /// Per-thread scratch space used by search.
+    struct SearchScratch {
+        search_buffer_type buffer;
+        adapted_distance_type distance;
+    };
+
     // Members
   private:
     // Invariants:
@@ -153,19 +221,33 @@ class MutableVamanaIndex {
     graph_type graph_;
     data_type data_;
     entry_point_type entry_point_;
-    std::vector<SlotMetadata> status_;
+    std::vector<AtomicSlotMetadata> status_;
     IDTranslator translator_;
 
     // Thread local data structures.
     distance_type distance_;
     search_buffer_type search_buffer_prototype_;
     threads::NativeThreadPool threadpool_;
+    // Search scratch space reused across calls to search.
+    threads::ScratchPool<SearchScratch> scratch_{};
 
     // Configurations
     size_t construction_window_size_;
     size_t max_candidates_;
     float alpha_ = 1.2;
     bool use_full_search_history_ = true;
+    EarlyTermination early_termination_{};
+
+    // Concurrent search and mutation.
+    bool concurrent_mutation_ = false;
+    std::unique_ptr<IndexLocks> locks_ = std::make_unique<IndexLocks>();
+    // Searches running concurrently with mutation use these threads, leaving
+    // ``threadpool_`` to the mutating operations.
+    std::unique_ptr<threads::PartitionedThreadPool> search_threadpool_{};
+    IncrementalConsolidator<Idx> incremental_consolidator_{};
+    // Declared last so the background thread is stopped before any other member is
+    // destroyed.
+    std::unique_ptr<BackgroundWorker> background_consolidation_{};
 
     // Methods
   public:
@@ -250,29 +332,48 @@ class MutableVamanaIndex {
     ///
     /// * data.size() == graph.n_nodes(): The graph and the data have the same number of
     ///   entries.
-    /// * The data and graph were saved with no "holes". In otherwords, the index was
-    ///   consolidated and compacted prior to saving.
-    /// * The span of internal ID's in translator covers exactly ``[0, data.size())``.
+    /// * If ``slots`` is empty, the data and graph were saved with no "holes". In other
+    ///   words, the index was consolidated and compacted prior to saving and the span of
+    ///   internal ID's in translator covers exactly ``[0, data.size())``.
+    /// * Otherwise, ``slots`` has one entry for each element of the data and the
+    ///   translator covers exactly the valid slots.
     MutableVamanaIndex(
         const VamanaConfigParameters& config,
         data_type data,
         graph_type graph,
         const Dist& distance_function,
         IDTranslator translator,
-        size_t num_threads
+        size_t num_threads,
+        const std::vector<SlotMetadata>& slots = {}
     )
         : graph_{std::move(graph)}
         , data_{std::move(data)}
-        , entry_point_{lib::narrow<Idx>(config.entry_point)}
+        , entry_point_{}
         , status_{data_.size(), SlotMetadata::Valid}
         , translator_{std::move(translator)}
         , distance_{distance_function}
-        , search_buffer_prototype_{config.search_window_size}
+        , search_buffer_prototype_{
+              config.search_window_size,
+              distance::comparator(distance_function),
+              config.visited_set}
         , threadpool_{num_threads}
         , construction_window_size_{config.construction_window_size}
         , max_candidates_{config.max_candidates}
         , alpha_{config.alpha}
-        , use_full_search_history_{config.use_full_search_history} {}
+        , use_full_search_history_{config.use_full_search_history} {
+        if (!slots.empty()) {
+            assert(slots.size() == status_.size());
+            std::copy(slots.begin(), slots.end(), status_.begin());
+        }
+        // Configurations saved prior to v0.0.2 only record a single entry point.
+        if (config.entry_points.empty()) {
+            entry_point_.push_back(lib::narrow<Idx>(config.entry_point));
+        } else {
+            for (auto id : config.entry_points) {
+                entry_point_.push_back(lib::narrow<Idx>(id));
+            }
+        }
+    }
 
     ///// Accessors
 
@@ -384,11 +485,12 @@ class MutableVamanaIndex {
     ///     reasons.
     ///
     /// (2) All entries in `ids` should have valid translations. Otherwise, this function's
-    ///     behavior is undefined.
+    ///     behavior is undefined. The exception is the maximum value of the element type
+    ///     ``I``, which pads short results and is left unchanged.
     ///
-    template <class Dims, class Base>
+    template <typename I, class Dims, class Base>
         requires(std::tuple_size_v<Dims> == 2)
-    void translate_to_external(DenseArray<size_t, Dims, Base>& ids) {
+    void translate_to_external(DenseArray<I, Dims, Base>& ids) {
         // N.B.: lib::narrow_cast should be valid because the origin of the IDs is internal.
         threads::run(
             threadpool_,
@@ -396,8 +498,13 @@ class MutableVamanaIndex {
             [&](const auto is, uint64_t /*tid*/) {
                 for (auto i : is) {
                     for (size_t j = 0, jmax = getsize<1>(ids); j < jmax; ++j) {
-                        auto internal = lib::narrow_cast<Idx>(ids.at(i, j));
-                        ids.at(i, j) = translate_internal_id(internal);
+                        I id = ids.at(i, j);
+                        if (id == std::numeric_limits<I>::max()) {
+                            continue;
+                        }
+                        ids.at(i, j) = lib::narrow_cast<I>(
+                            translate_internal_id(lib::narrow_cast<Idx>(id))
+                        );
                     }
                 }
             }
@@ -451,57 +558,229 @@ class MutableVamanaIndex {
         buffer.sort();
     }
 
+    ///
+    /// @brief Search for the ``num_neighbors`` approximate nearest neighbors of each query.
+    ///
+    /// When concurrent mutation is enabled, the search may overlap with ``add_points``,
+    /// ``delete_entries``, ``consolidate`` and ``compact`` issued from other threads. It
+    /// then runs on a partition of the search thread pool configured by
+    /// ``enable_concurrent_mutation`` rather than the index's own thread pool, which
+    /// stays free for mutations. Entries deleted while the search is in flight may be
+    /// reported with the maximum ID of the result type.
+    ///
+    /// If ``terminations`` is not empty, entry ``i`` receives the reason the search for
+    /// query ``i`` ended.
+    ///
+    /// @see enable_concurrent_mutation, set_early_termination
+    ///
     template <typename QueryType, typename I>
     void search(
         data::ConstSimpleDataView<QueryType> queries,
         size_t num_neighbors,
-        QueryResultView<I> result
+        QueryResultView<I> result,
+        std::span<SearchTermination> terminations = {}
+    ) {
+        if (concurrent_mutation_) {
+            auto lease = search_threadpool_->acquire();
+            search(queries, num_neighbors, result, lease, terminations);
+        } else {
+            search(queries, num_neighbors, result, threadpool_, terminations);
+        }
+    }
+
+    ///
+    /// @brief Search using the threads of ``threadpool``.
+    ///
+    /// Behaves like the search above, but runs on ``threadpool`` instead of a pool owned
+    /// by the index. When concurrent mutation is enabled, ``threadpool`` must not be the
+    /// pool the index uses for mutation, and calls with different thread pools may run
+    /// concurrently.
+    ///
+    template <typename QueryType, typename I, threads::ThreadPool Pool>
+    void search(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        Pool& threadpool,
+        std::span<SearchTermination> terminations = {}
     ) {
-        SkipBuilder builder{status_};
+        if (!terminations.empty() && terminations.size() != queries.size()) {
+            throw ANNEXCEPTION(
+                "Expected ",
+                queries.size(),
+                " search terminations. Instead, got ",
+                terminations.size(),
+                '!'
+            );
+        }
+
+        if (concurrent_mutation_) {
+            search_impl(
+                threadpool,
+                queries,
+                num_neighbors,
+                result,
+                terminations,
+                [&]() { return LockedGraphReader{graph_, locks_->vertices}; }
+            );
+        } else {
+            search_impl(
+                threadpool,
+                queries,
+                num_neighbors,
+                result,
+                terminations,
+                [&]() -> const Graph& { return graph_; }
+            );
+        }
+    }
+
+  private:
+    // Return a callable choosing the entry point nearest to a prepared query.
+    // Passed as the entry points of ``greedy_search``, which prepares each query once.
+    auto select_entry_point() const {
+        return [this](const auto& query, auto& distance) {
+            return nearest_entry_point(
+                data_, entry_point_, query, distance, distance::comparator(distance_)
+            );
+        };
+    }
+
+    // Search for query ``i``, leaving the results in the buffer of ``scratch``.
+    template <typename G, typename QueryType>
+    void search_query(
+        const G& graph,
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t i,
+        size_t num_neighbors,
+        SearchScratch& scratch,
+        std::span<SearchTermination> terminations
+    ) {
+        auto& buffer = scratch.buffer;
+        auto& distance = scratch.distance;
+
+        // Perform the greedy search.
+        // Results from the search will be present in `buffer`.
+        const auto& query = queries.get_datum(i);
+        auto tracker = NullTracker{};
+        auto termination = greedy_search(
+            graph,
+            data_,
+            query,
+            distance,
+            buffer,
+            select_entry_point(),
+            SkipBuilder{status_},
+            tracker,
+            early_termination_,
+            num_neighbors
+        );
+        if (!terminations.empty()) {
+            terminations[i] = termination;
+        }
+
+        buffer.cleanup();
+        // TODO: Properly teach datasets how to inform the index that reranking is
+        // required.
+        if constexpr (needs_reranking) {
+            rerank(distance, query, buffer);
+        }
+    }
+
+    // Write the contents of ``buffer`` to row ``i`` of ``result`` as external IDs.
+    //
+    // A search that ends early may not have found ``num_neighbors`` valid candidates, and
+    // entries deleted by a concurrent mutation no longer have an external ID. Both are
+    // reported with the maximum ID of the result type.
+    template <typename I>
+    void write_result(
+        const search_buffer_type& buffer,
+        size_t i,
+        size_t num_neighbors,
+        QueryResultView<I>& result
+    ) const {
+        const auto padding = std::numeric_limits<I>::max();
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            if (j < buffer.size()) {
+                const auto& neighbor = buffer[j];
+                auto id = neighbor.id();
+                result.index(i, j) = translator_.has_internal(id)
+                                         ? lib::narrow_cast<I>(translate_internal_id(id))
+                                         : padding;
+                result.distance(i, j) = neighbor.distance();
+            } else {
+                result.index(i, j) = padding;
+                result.distance(i, j) =
+                    type_traits::sentinel_v<float, distance::compare_t<Dist>>;
+            }
+        }
+    }
+
+    template <typename Pool, typename QueryType, typename I, typename GetGraph>
+    void search_impl(
+        Pool& pool,
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        std::span<SearchTermination> terminations,
+        const GetGraph& get_graph
+    ) {
+        // Scratch space is cached by the index and reused by later calls. Concurrent
+        // searches get their own temporary scratch.
+        auto scratch = scratch_.acquire(pool.size());
         threads::run(
-            threadpool_,
+            pool,
             threads::StaticPartition{queries.size()},
-            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
-                auto buffer = threads::shallow_copy(search_buffer_prototype_);
-                auto distance = data_.adapt_distance(distance_);
+            [&](const auto is, uint64_t tid) {
+                auto& slot = scratch.at(tid);
+                if (!slot.has_value()) {
+                    slot.emplace(SearchScratch{
+                        threads::shallow_copy(search_buffer_prototype_),
+                        data_.adapt_distance(distance_)});
+                }
+                auto& buffer = slot->buffer;
+                decltype(auto) graph = get_graph();
 
                 // TODO: Use iterators for returning neighbors.
                 //
-                // Perform a sanity check on the search buffer.
+                // Bring the buffer up to date with the current search parameters.
                 // If the buffer is too small, we need to set it to a minimum size to avoid
                 // segfaults when extracting the neighbors.
-                if (buffer.capacity() < num_neighbors) {
-                    buffer.change_maxsize(num_neighbors);
+                size_t target = std::max(search_buffer_prototype_.target(), num_neighbors);
+                if (buffer.target() != target) {
+                    buffer.change_maxsize(target);
+                }
+                if (search_buffer_prototype_.visited_set_enabled()) {
+                    buffer.enable_visited_set();
+                } else {
+                    buffer.disable_visited_set();
                 }
 
-                for (auto i : is) {
-                    // Perform the greedy search.
-                    // Results from the search will be present in `buffer`.
-                    const auto& query = queries.get_datum(i);
-                    greedy_search(
-                        graph_, data_, query, distance, buffer, entry_point_, builder
-                    );
-
-                    buffer.cleanup();
-                    // TODO: Properly teach datasets how to inform the index that
-                    // reranking is required.
-                    if constexpr (needs_reranking) {
-                        rerank(distance, query, buffer);
-                    }
-                    for (size_t j = 0; j < num_neighbors; ++j) {
-                        const auto& neighbor = buffer[j];
-                        result.index(i, j) = neighbor.id();
-                        result.distance(i, j) = neighbor.distance();
+                if (!concurrent_mutation_) {
+                    buffer.reserve_visited(data_.size());
+                    for (auto i : is) {
+                        search_query(graph, queries, i, num_neighbors, *slot, terminations);
+                        write_result(buffer, i, num_neighbors, result);
                     }
+                    return;
+                }
+
+                // Take the structure lock for one query at a time so a pending resize,
+                // consolidation or compaction waits for at most one query per thread
+                // instead of the whole batch.
+                for (auto i : is) {
+                    std::shared_lock structure_lock{locks_->structure};
+                    buffer.reserve_visited(data_.size());
+                    search_query(graph, queries, i, num_neighbors, *slot, terminations);
+                    std::shared_lock translation_lock{locks_->translation};
+                    write_result(buffer, i, num_neighbors, result);
                 }
             }
         );
-
-        // After the search procedure, the indices in `results` are internal.
-        // Perform one more pass to convert these to external ids.
-        translate_to_external(result.indices());
     }
 
+  public:
+
     ///
     /// @brief Return a unique instance of the distance function.
     ///
@@ -517,9 +796,9 @@ class MutableVamanaIndex {
         size_t num_neighbors,
         QueryResultView<I> result
     ) {
-        auto temp_index = temporary_flat_index(data_, distance_, threadpool_);
+        auto temp_index = flat::temporary_flat_index(data_, distance_, threadpool_);
         temp_index.search(queries, num_neighbors, result, [&](size_t i) {
-            return getindex(status_, i) == SlotMetadata::Valid;
+            return getindex(status_, i).load() == SlotMetadata::Valid;
         });
 
         // After the search procedure, the indices in `results` are internal.
@@ -588,13 +867,15 @@ class MutableVamanaIndex {
             );
         }
 
+        std::lock_guard mutation_lock{locks_->mutation};
+
         // Gather all empty slots.
         std::vector<size_t> slots{};
         slots.reserve(num_points);
 
         bool have_room = false;
         for (size_t i = 0, imax = status_.size(); i < imax; ++i) {
-            if (status_[i] == SlotMetadata::Empty) {
+            if (status_[i].load() == SlotMetadata::Empty) {
                 slots.push_back(i);
             }
             if (slots.size() == num_points) {
@@ -606,6 +887,9 @@ class MutableVamanaIndex {
         // Check if we have enough indices. If we don't, we need to resize the data and
         // the graph.
         if (!have_room) {
+            // Resizing may relocate the data and the graph, so wait for any in-flight
+            // searches to finish.
+            std::lock_guard structure_lock{locks_->structure};
             size_t needed = num_points - slots.size();
             size_t current_size = data_.size();
             size_t new_size = current_size + needed;
@@ -624,13 +908,45 @@ class MutableVamanaIndex {
         // Try to update the id translation now that we have internal ids.
         // If this fails, we still haven't mutated the index data structure so we're safe
         // to throw an exception.
-        translator_.insert(external_ids, slots);
+        {
+            std::lock_guard translation_lock{locks_->translation};
+            translator_.insert(external_ids, slots);
+        }
 
-        // Copy the given points into the data and clear the adjacency lists for the graph.
+        // Copy the given points into the data.
+        // The new slots are not yet reachable from any adjacency list, so concurrent
+        // searches cannot observe partially written data.
         copy_points(points, slots);
-        clear_lists(slots);
+        if (concurrent_mutation_) {
+            auto graph = LockedGraph{graph_, locks_->vertices};
+            add_to_graph(graph, slots);
+        } else {
+            add_to_graph(graph_, slots);
+        }
+
+        // Publish all added entries as valid only after their adjacency lists have been
+        // written.
+        for (const auto& i : slots) {
+            status_[i].store(SlotMetadata::Valid);
+            incremental_consolidator_.recheck(i);
+        }
+        return slots;
+    }
+
+  private:
+    // Clear the adjacency lists for the new slots and patch in their neighbors.
+    template <graphs::MemoryGraph G>
+    void add_to_graph(G& graph, const std::vector<size_t>& slots) {
+        threads::run(
+            threadpool_,
+            threads::StaticPartition(slots),
+            [&](const auto& thread_local_ids, uint64_t /*tid*/) {
+                for (auto id : thread_local_ids) {
+                    graph.clear_node(id);
+                }
+            }
+        );
 
-        // Patch in the new neighbors.
         auto parameters = VamanaBuildParameters{
             alpha_,
             graph_.max_degree(),
@@ -639,15 +955,12 @@ class MutableVamanaIndex {
             threadpool_.size(),
             use_full_search_history_};
 
-        VamanaBuilder builder{graph_, data_, distance_, parameters, threadpool_};
+        VamanaBuilder builder{graph, data_, distance_, parameters, threadpool_};
         builder.construct(alpha_, entry_point(), slots, false);
-        // Mark all added entries as valid.
-        for (const auto& i : slots) {
-            status_[i] = SlotMetadata::Valid;
-        }
-        return slots;
     }
 
+  public:
+
     ///
     /// Delete all IDs stored in the random-access container `ids`.
     ///
@@ -671,24 +984,31 @@ class MutableVamanaIndex {
     ///   graph.
     ///
     template <typename T> void delete_entries(const T& ids) {
+        std::lock_guard mutation_lock{locks_->mutation};
         translator_.check_external_exist(ids.begin(), ids.end());
         for (auto i : ids) {
             delete_entry(translator_.get_internal(i));
         }
+        std::lock_guard translation_lock{locks_->translation};
         translator_.delete_external(ids);
     }
 
     void delete_entry(size_t i) {
-        SlotMetadata& meta = getindex(status_, i);
-        assert(meta == SlotMetadata::Valid);
-        meta = SlotMetadata::Deleted;
+        AtomicSlotMetadata& meta = getindex(status_, i);
+        assert(meta.load() == SlotMetadata::Valid);
+        meta.store(SlotMetadata::Deleted);
+
+        // Back edges make the out-neighbors of `i` likely to point back at it.
+        for (auto j : graph_.get_node(i)) {
+            incremental_consolidator_.hint(j);
+        }
     }
 
-    bool is_deleted(size_t i) const { return status_[i] != SlotMetadata::Valid; }
+    bool is_deleted(size_t i) const { return status_[i].load() != SlotMetadata::Valid; }
 
     Idx entry_point() const {
-        assert(entry_point_.size() == 1);
-        return entry_point_[0];
+        assert(!entry_point_.empty());
+        return entry_point_.front();
     }
 
     ///
@@ -714,6 +1034,9 @@ class MutableVamanaIndex {
     ///     improve performance but requires more working memory.
     ///
     void compact(Idx batch_size = 1'000) {
+        std::lock_guard mutation_lock{locks_->mutation};
+        std::lock_guard structure_lock{locks_->structure};
+
         // Step 1: Compute a prefix-sum matching each valid internal index to its new
         // internal index.
         //
@@ -799,8 +1122,8 @@ class MutableVamanaIndex {
                 continue;
             }
 
-            auto status = getindex(status_, old_id);
-            status_[new_id] = status;
+            auto status = getindex(status_, old_id).load();
+            status_[new_id].store(status);
             if (status == SlotMetadata::Valid) {
                 translator_.remap_internal_id(old_id, new_id);
             }
@@ -811,6 +1134,7 @@ class MutableVamanaIndex {
         for (auto& ep : entry_point_) {
             ep = old_to_new_id_map.at(ep);
         }
+        incremental_consolidator_.reset();
     }
 
     ///// Threading Interface
@@ -828,20 +1152,61 @@ class MutableVamanaIndex {
 
     size_t get_search_window_size() const { return search_buffer_prototype_.target(); }
 
+    ///// Early Termination
+    ///
+    /// @brief Set the criteria for ending the search for a query before it converges.
+    ///
+    /// @sa EarlyTermination
+    ///
+    void set_early_termination(const EarlyTermination& criteria) {
+        early_termination_ = criteria;
+    }
+    EarlyTermination get_early_termination() const { return early_termination_; }
+
+    ///// Entry Points
+
+    ///
+    /// @brief Set the vertices where graph searches begin.
+    ///
+    /// @param entry_points The entry points. Must be non-empty and contain only internal
+    ///     IDs of valid (non-deleted) entries.
+    ///
+    /// With more than one entry point, each search starts from the entry point nearest
+    /// the query. Choosing it costs one distance computation per entry point, so a few
+    /// dozen to a few hundred entry points spread over the dataset work best. Graph
+    /// construction and insertion always use the first entry point. If the first entry
+    /// point is deleted, it is replaced by the medioid of the remaining entries on the
+    /// next consolidation. Other deleted entry points are dropped.
+    ///
+    template <std::integral I> void set_entry_points(const std::vector<I>& entry_points) {
+        if (entry_points.empty()) {
+            throw ANNEXCEPTION("At least one entry point is required!");
+        }
+        std::lock_guard mutation_lock{locks_->mutation};
+        auto new_entry_points = entry_point_type();
+        for (auto id : entry_points) {
+            if (lib::narrow<size_t>(id) >= status_.size() || is_deleted(id)) {
+                throw ANNEXCEPTION("Entry point ", id, " is not a valid entry!");
+            }
+            new_entry_points.push_back(lib::narrow<Idx>(id));
+        }
+        std::lock_guard structure_lock{locks_->structure};
+        entry_point_ = std::move(new_entry_points);
+    }
+
+    /// @brief Return the internal IDs of the vertices where graph searches begin.
+    const entry_point_type& get_entry_points() const { return entry_point_; }
+
     void consolidate() {
+        std::lock_guard mutation_lock{locks_->mutation};
+        std::lock_guard structure_lock{locks_->structure};
+
         auto check_is_deleted = [&](size_t i) { return this->is_deleted(i); };
-        auto valid = [&](size_t i) { return !(this->is_deleted(i)); };
-
-        // Determine if the entry point is deleted.
-        // If so - we need to pick a new one.
-        assert(entry_point_.size() == 1);
-        auto entry_point = entry_point_[0];
-        if (status_.at(entry_point) == SlotMetadata::Deleted) {
-            fmt::print("Replacing entry point! ... ");
-            auto new_entry_point = detail::find_medioid_helper(data_, threadpool_, valid);
-            fmt::print(" New point: {}\n", new_entry_point);
-            assert(!is_deleted(new_entry_point));
-            entry_point_[0] = new_entry_point;
+
+        // Determine if any entry point is deleted.
+        // If so - we need to pick new ones.
+        if (auto new_entry_points = find_replacement_entry_points()) {
+            entry_point_ = std::move(*new_entry_points);
         }
 
         // Perform graph consolidation.
@@ -857,30 +1222,232 @@ class MutableVamanaIndex {
 
         // After consolidation - set all `Deleted` slots to `Empty`.
         for (auto& status : status_) {
-            if (status == SlotMetadata::Deleted) {
-                status = SlotMetadata::Empty;
+            if (status.load() == SlotMetadata::Deleted) {
+                status.store(SlotMetadata::Empty);
+            }
+        }
+        // Any in-progress incremental consolidation is now moot.
+        incremental_consolidator_.reset();
+    }
+
+    ///
+    /// @brief Perform a bounded amount of delete consolidation.
+    ///
+    /// @param budget Limits on the work performed by this call.
+    ///
+    /// @returns ``true`` if there was no consolidation work left to do when this call
+    ///     returned. Otherwise, ``false``.
+    ///
+    /// Unlike ``consolidate``, which processes the whole graph at once, this method
+    /// repairs adjacency lists a few vertices at a time on the calling thread. Deleted
+    /// slots are only reclaimed (marked as empty) once a full pass over the graph has
+    /// removed every edge pointing at them. Slots deleted while a pass is running are
+    /// handled by the next pass.
+    ///
+    /// When concurrent mutation is enabled, searches continue to run while this method
+    /// repairs the graph and are only paused briefly to reclaim slots or change the entry
+    /// point.
+    ///
+    /// @see start_background_consolidation
+    ///
+    bool consolidate_step(const ConsolidationBudget& budget = {}) {
+        std::lock_guard mutation_lock{locks_->mutation};
+        auto& consolidator = incremental_consolidator_;
+        if (!consolidator.active()) {
+            auto targets = std::vector<Idx>();
+            for (size_t i = 0, imax = status_.size(); i < imax; ++i) {
+                if (status_[i].load() == SlotMetadata::Deleted) {
+                    targets.push_back(i);
+                }
+            }
+            if (targets.empty()) {
+                return true;
+            }
+
+            // Targets cannot be reclaimed while they are entry points.
+            if (auto new_entry_points = find_replacement_entry_points()) {
+                std::lock_guard structure_lock{locks_->structure};
+                entry_point_ = std::move(*new_entry_points);
+            }
+            consolidator.begin(std::move(targets));
+        }
+
+        auto check_is_deleted = [&](size_t i) { return this->is_deleted(i); };
+        auto parameters = ConsolidationParameters{0, graph_.max_degree(), alpha_};
+        auto progress = ConsolidationProgress{};
+        if (concurrent_mutation_) {
+            auto graph = LockedGraph{graph_, locks_->vertices};
+            progress = consolidator.step(
+                graph, data_, distance_, parameters, budget, check_is_deleted
+            );
+        } else {
+            progress = consolidator.step(
+                graph_, data_, distance_, parameters, budget, check_is_deleted
+            );
+        }
+
+        if (!progress.pass_complete) {
+            return false;
+        }
+
+        // Nothing points at the targets any more. Wait for in-flight searches that may
+        // have reached the targets before reclaiming their slots.
+        {
+            std::lock_guard structure_lock{locks_->structure};
+            for (auto i : consolidator.targets()) {
+                status_[i].store(SlotMetadata::Empty);
+            }
+        }
+        consolidator.reset();
+        return std::none_of(status_.begin(), status_.end(), [](const auto& status) {
+            return status.load() == SlotMetadata::Deleted;
+        });
+    }
+
+    ///
+    /// @brief Run ``consolidate_step`` repeatedly on a dedicated background thread.
+    ///
+    /// @param budget The budget for each step.
+    /// @param period How long to sleep when there is no consolidation work to do.
+    ///
+    /// Requires concurrent mutation to be enabled so searches can continue while the
+    /// background thread modifies the graph. The index must not be moved or destroyed
+    /// without first calling ``stop_background_consolidation``.
+    ///
+    void start_background_consolidation(
+        const ConsolidationBudget& budget = {},
+        std::chrono::nanoseconds period = std::chrono::milliseconds(100)
+    ) {
+        if (!concurrent_mutation_) {
+            throw ANNEXCEPTION(
+                "Background consolidation requires concurrent mutation to be enabled!"
+            );
+        }
+        if (background_consolidation_ != nullptr) {
+            throw ANNEXCEPTION("Background consolidation is already running!");
+        }
+        background_consolidation_ = std::make_unique<BackgroundWorker>(
+            [this, budget]() { return consolidate_step(budget); }, period
+        );
+    }
+
+    ///
+    /// @brief Stop background consolidation, waiting for the current step to finish.
+    ///
+    /// Rethrows any exception raised on the background thread.
+    ///
+    void stop_background_consolidation() {
+        auto worker = std::exchange(background_consolidation_, nullptr);
+        if (worker != nullptr) {
+            worker->stop();
+        }
+    }
+
+    bool background_consolidation_running() const {
+        return background_consolidation_ != nullptr;
+    }
+
+  private:
+    // If any entry point is deleted, return the entry points with the deleted ones
+    // removed. A deleted first entry point is replaced by the medioid of the remaining
+    // valid points.
+    std::optional<entry_point_type> find_replacement_entry_points() {
+        auto deleted = [&](Idx id) {
+            return status_.at(id).load() == SlotMetadata::Deleted;
+        };
+        if (std::none_of(entry_point_.begin(), entry_point_.end(), deleted)) {
+            return std::nullopt;
+        }
+
+        auto new_entry_points = entry_point_type();
+        if (deleted(entry_point_.front())) {
+            auto valid = [&](size_t i) { return !(this->is_deleted(i)); };
+            auto medioid = detail::find_medioid_helper(data_, threadpool_, valid);
+            assert(!is_deleted(medioid));
+            new_entry_points.push_back(lib::narrow<Idx>(medioid));
+        }
+        for (auto id : entry_point_) {
+            auto seen = std::find(new_entry_points.begin(), new_entry_points.end(), id);
+            if (!deleted(id) && seen == new_entry_points.end()) {
+                new_entry_points.push_back(id);
             }
         }
+        return new_entry_points;
+    }
+
+  public:
+    ///// Concurrent Mutation Interface
+
+    ///
+    /// @brief Allow searches to run concurrently with mutating operations.
+    ///
+    /// @param num_search_threads The number of threads available to searches. Defaults to
+    ///     the size of the index's thread pool.
+    /// @param num_search_partitions The number of searches that may run in parallel. The
+    ///     search threads are divided evenly between them.
+    ///
+    /// When enabled, ``search`` may be called from any number of threads while
+    /// ``add_points``, ``delete_entries``, ``consolidate`` and ``compact`` are called from
+    /// other threads. Searches then run on a dedicated thread pool, taking consistent
+    /// snapshots of adjacency lists protected by per-vertex sequence locks. A calling
+    /// thread waits for a free partition of that pool when all partitions are busy.
+    /// Queries wait while the index is resized, consolidated or compacted, but these
+    /// operations only wait for the queries already in flight, not for whole batches.
+    ///
+    /// Toggling this mode is not itself thread safe.
+    ///
+    void enable_concurrent_mutation(
+        size_t num_search_threads = 0, size_t num_search_partitions = 1
+    ) {
+        if (num_search_threads == 0) {
+            num_search_threads = threadpool_.size();
+        }
+        search_threadpool_ = std::make_unique<threads::PartitionedThreadPool>(
+            num_search_threads, num_search_partitions
+        );
+        concurrent_mutation_ = true;
+    }
+
+    ///
+    /// @brief Return to the default mode where searches use the index's thread pool and
+    ///     must not overlap with mutating operations.
+    ///
+    void disable_concurrent_mutation() {
+        concurrent_mutation_ = false;
+        search_threadpool_.reset();
     }
+    bool concurrent_mutation_enabled() const { return concurrent_mutation_; }
 
     ///// Visited Set Interface
-    // TODO: Enable?
-    void enable_visited_set() {}
-    void disable_visited_set() {}
-    bool visited_set_enabled() const { return false; }
+    void enable_visited_set() { search_buffer_prototype_.enable_visited_set(); }
+    void disable_visited_set() { search_buffer_prototype_.disable_visited_set(); }
+    bool visited_set_enabled() const {
+        return search_buffer_prototype_.visited_set_enabled();
+    }
 
     ///// Saving
 
-    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+    // Version History
+    // - v0.0.0: Saved after consolidation and compaction with all slots valid.
+    // - v0.0.1: Saved as-is with the slot metadata, including deleted and empty slots.
+    static constexpr lib::Version save_version = lib::Version(0, 0, 1);
+
+    ///
+    /// @brief Save the index to the given directories.
+    ///
+    /// The index is saved as-is: deleted entries and empty slots are persisted alongside
+    /// the slot metadata rather than being consolidated and compacted away first. Saving
+    /// therefore does not modify the index and is a streaming write of its current state.
+    ///
+    /// Mutating operations are paused for the duration of the save. When concurrent
+    /// mutation is enabled, searches continue to run while the index is being saved.
+    ///
     void save(
         const std::filesystem::path& config_directory,
         const std::filesystem::path& graph_directory,
         const std::filesystem::path& data_directory
     ) {
-        // Post-consolidation, all entries should be "valid".
-        // Therefore, we don't need to save the slot metadata.
-        consolidate();
-        compact();
+        std::lock_guard mutation_lock{locks_->mutation};
 
         // Save auxiliary data structures.
         lib::save_callable(config_directory, [&](const lib::SaveContext& ctx) {
@@ -893,13 +1460,15 @@ class MutableVamanaIndex {
                 get_construction_window_size(),
                 get_full_search_history(),
                 get_search_window_size(),
-                visited_set_enabled()};
+                visited_set_enabled(),
+                std::vector<size_t>(entry_point_.begin(), entry_point_.end())};
 
             return lib::SaveType(
                 toml::table{{
                     {"name", prepare(name())},
                     {"parameters", lib::recursive_save(parameters, ctx)},
                     {"translation", lib::recursive_save(translator_, ctx)},
+                    {"slots", detail::save_slot_metadata(status_, ctx)},
                 }},
                 save_version
             );
@@ -972,7 +1541,7 @@ class MutableVamanaIndex {
     ///
     void debug_check_graph_consistency(bool allow_deleted = false) const {
         auto is_valid = [&, allow_deleted = allow_deleted](size_t i) {
-            const auto& metadata = status_[i];
+            auto metadata = status_[i].load();
             // Use a switch to get a compiler error is we add states to `SlotMetadata`.
             switch (metadata) {
                 case SlotMetadata::Valid: {
@@ -997,7 +1566,7 @@ class MutableVamanaIndex {
             size_t count = 0;
             for (auto j : graph_.get_node(i)) {
                 if (!is_valid(j)) {
-                    const auto& metadata = status_[j];
+                    auto metadata = status_[j].load();
                     throw ANNEXCEPTION(
                         "Node number ",
                         i,
@@ -1068,10 +1637,10 @@ auto auto_dynamic_assemble(
         throw ANNEXCEPTION(message);
     }
 
-    // Unload the ID translator and config parameters.
+    // Unload the ID translator, config parameters and slot metadata.
     auto reloader = lib::LoadOverride{[&](const toml::table& table,
                                           const lib::LoadContext& ctx,
-                                          const lib::Version& SVS_UNUSED(version)) {
+                                          const lib::Version& version) {
         // If loading from the static index, then the table we recieve is itself the
         // parameters table.
         //
@@ -1080,32 +1649,70 @@ auto auto_dynamic_assemble(
         if (debug_load_from_static) {
             return std::make_tuple(
                 lib::recursive_load<VamanaConfigParameters>(table, ctx),
-                IDTranslator(IDTranslator::Identity(datasize))
-            );
-        } else {
-            return std::make_tuple(
-                lib::recursive_load<VamanaConfigParameters>(
-                    subtable(table, "parameters"), ctx
-                ),
-                lib::recursive_load<IDTranslator>(subtable(table, "translation"), ctx)
+                IDTranslator(IDTranslator::Identity(datasize)),
+                std::vector<SlotMetadata>()
             );
         }
+
+        if (version > lib::Version(0, 0, 1)) {
+            throw ANNEXCEPTION("Version mismatch!");
+        }
+        // Indices prior to v0.0.1 were saved without holes.
+        auto slots = std::vector<SlotMetadata>();
+        if (version == lib::Version(0, 0, 1)) {
+            slots = detail::load_slot_metadata(subtable(table, "slots"), ctx);
+        }
+        return std::make_tuple(
+            lib::recursive_load<VamanaConfigParameters>(subtable(table, "parameters"), ctx),
+            lib::recursive_load<IDTranslator>(subtable(table, "translation"), ctx),
+            std::move(slots)
+        );
     }};
-    auto [parameters, translator] = lib::load(reloader, config_path);
+    auto [parameters, translator, slots] = lib::load(reloader, config_path);
 
-    // Make sure that the translator covers all the IDs in the graph and data.
-    auto translator_size = translator.size();
-    if (translator_size != datasize) {
+    // Make sure that the translator covers exactly the valid IDs in the graph and data.
+    if (!slots.empty() && slots.size() != datasize) {
         auto message = fmt::format(
-            "Translator has {} IDs but should have {}", translator_size, datasize
+            "Reloaded slot metadata has {} entries but should have {}",
+            slots.size(),
+            datasize
         );
         throw ANNEXCEPTION(message);
     }
+    auto is_valid = [&](size_t i) {
+        return slots.empty() || slots[i] == SlotMetadata::Valid;
+    };
 
+    size_t num_valid = 0;
     for (size_t i = 0; i < datasize; ++i) {
-        if (!translator.has_internal(i)) {
-            throw ANNEXCEPTION("Translator is missing internal id ", i);
+        bool valid = is_valid(i);
+        num_valid += valid;
+        if (valid != translator.has_internal(i)) {
+            throw ANNEXCEPTION(
+                "Translator ", valid ? "is missing" : "has an invalid", " internal id ", i
+            );
+        }
+    }
+
+    auto translator_size = translator.size();
+    if (translator_size != num_valid) {
+        auto message = fmt::format(
+            "Translator has {} IDs but should have {}", translator_size, num_valid
+        );
+        throw ANNEXCEPTION(message);
+    }
+
+    auto check_entry_point = [&](size_t entry_point) {
+        if (entry_point >= datasize) {
+            throw ANNEXCEPTION("Entry point ", entry_point, " is out of bounds!");
+        }
+        if (!slots.empty() && slots[entry_point] == SlotMetadata::Empty) {
+            throw ANNEXCEPTION("Entry point ", entry_point, " is an empty slot!");
         }
+    };
+    check_entry_point(parameters.entry_point);
+    for (auto entry_point : parameters.entry_points) {
+        check_entry_point(entry_point);
     }
 
     // At this point, we should be completely validated.
@@ -1116,7 +1723,8 @@ auto auto_dynamic_assemble(
         std::move(graph),
         std::move(distance),
         std::move(translator),
-        num_threads};
+        num_threads,
+        slots};
 }
 
 } // namespace svs::index::vamana
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "svs/index/vamana/visited_table.h"
 #include "svs/lib/datatype.h"
 #include "svs/lib/neighbor.h"
 #include "svs/lib/threads/threadlocal.h"
@@ -19,9 +20,9 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <type_traits>
-#include <unordered_set>
 #include <vector>
 
 namespace svs::index::vamana {
@@ -40,22 +41,29 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     using vector_type = std::vector<value_type, threads::CacheAlignedAllocator<value_type>>;
     using iterator = typename vector_type::iterator;
     using const_iterator = typename vector_type::const_iterator;
-    using set_type = std::unordered_set<Idx>;
+    using set_type = GenerationTable<Idx>;
 
   private:
     [[no_unique_address]] Cmp compare_{};
     size_t target_valid_ = 0;
     size_t best_unvisited_ = 0;
     size_t valid_ = 0; // number of unskipped neighbors.
+    // Maximum number of candidates (skipped or not) kept in the buffer.
+    size_t size_limit_ = std::numeric_limits<size_t>::max();
     vector_type candidates_{};
+    // Optional visited set. See ``SearchBuffer`` for details.
+    std::optional<set_type> visited_{std::nullopt};
 
   public:
     MutableBuffer() = default;
-    explicit MutableBuffer(size_t size, Cmp compare = Cmp{})
+    explicit MutableBuffer(size_t size, Cmp compare = Cmp{}, bool enable_visited = false)
         : compare_{std::move(compare)}
         , target_valid_{size}
         , candidates_(size) {
         candidates_.clear();
+        if (enable_visited) {
+            enable_visited_set();
+        }
     }
 
     ///
@@ -67,7 +75,12 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     MutableBuffer shallow_copy() const {
         // We care about the contents of the buffer - just its size.
         // Therefore, we can construct a new buffer from scratch.
-        return MutableBuffer{target_valid_, compare_};
+        auto buffer = MutableBuffer{target_valid_, compare_, visited_set_enabled()};
+        buffer.set_size_limit(size_limit_);
+        if (visited_set_enabled()) {
+            buffer.reserve_visited(visited_->size());
+        }
+        return buffer;
     }
 
     // Change the maximum number of elements that can be in the search buffer.
@@ -76,10 +89,26 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
         candidates_.resize(new_size + 1);
     }
 
+    ///
+    /// Bound the total number of candidates held by the buffer, including skipped ones.
+    ///
+    /// Without a limit, the buffer grows until it holds ``target()`` valid candidates,
+    /// which requires holding every candidate seen when few candidates are valid. Once
+    /// the limit is reached, the worst candidates are dropped whether or not they are
+    /// skipped, so the buffer may end up with fewer than ``target()`` valid candidates.
+    ///
+    /// The limit is clamped to be at least ``target()``.
+    ///
+    void set_size_limit(size_t limit) { size_limit_ = limit; }
+    size_t size_limit() const { return std::max(size_limit_, target_valid_); }
+
     void clear() {
         candidates_.clear();
         best_unvisited_ = 0;
         valid_ = 0;
+        if (visited_set_enabled()) {
+            visited_->clear();
+        }
     }
 
     size_t size() const { return candidates_.size(); }
@@ -129,6 +158,7 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
         // Increment `best_unvisited_` until it's equal to the size OR until we encounter
         // an unvisited node.
         while (++best_unvisited_ != size() && candidates_[best_unvisited_].visited()) {}
+        set_visited(node.id());
         return node;
     }
 
@@ -186,10 +216,19 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
                 }
             }
         }
+
+        // Enforce the size limit. The same reasoning as above keeps `best_unvisited_`
+        // in-bounds: it was at most the size before the insertion, which is at most the
+        // limit.
+        const size_t limit = size_limit();
+        while (size() > limit) {
+            valid_ -= static_cast<size_t>(!back().skipped());
+            candidates_.pop_back();
+        }
     }
 
     bool can_skip(float distance) const {
-        return compare_(back().distance(), distance) && full();
+        return compare_(back().distance(), distance) && (full() || size() >= size_limit());
     }
 
     // size_t insert(Idx id, float distance, bool valid) {
@@ -255,8 +294,29 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     }
 
     ///// Visited API
-    static bool visited(Idx /*i*/) { return false; }
-    static void set_visited(Idx /*i*/) {}
+    bool visited_set_enabled() const { return visited_.has_value(); }
+
+    void enable_visited_set() {
+        if (!visited_set_enabled()) {
+            visited_.emplace();
+        }
+    }
+
+    void disable_visited_set() { visited_.reset(); }
+
+    void reserve_visited(size_t num_vertices) {
+        if (visited_set_enabled()) {
+            visited_->reserve(num_vertices);
+        }
+    }
+
+    bool visited(Idx i) const { return visited_set_enabled() && visited_->contains(i); }
+
+    void set_visited(Idx i) {
+        if (visited_set_enabled()) {
+            visited_->insert(i);
+        }
+    }
 
   private:
     ///
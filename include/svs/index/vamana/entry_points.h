@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/data.h"
+#include "svs/core/distance.h"
+#include "svs/core/kmeans.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/threads.h"
+#include "svs/lib/type_traits.h"
+
+// stl
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Return the IDs of the elements of ``data`` nearest to each centroid.
+///
+/// @param data The dataset to search.
+/// @param centroids The centroids.
+/// @param threadpool The threadpool used to scan ``data``.
+///
+/// Distances are computed using the L2 distance. The returned IDs are sorted and free of
+/// duplicates, so there may be fewer IDs than centroids.
+///
+template <
+    data::ImmutableMemoryDataset Data,
+    data::ImmutableMemoryDataset Centroids,
+    threads::ThreadPool Pool>
+std::vector<size_t>
+nearest_elements(const Data& data, const Centroids& centroids, Pool& threadpool) {
+    using neighbor_type = Neighbor<size_t>;
+    const auto sentinel = type_traits::sentinel_v<neighbor_type, std::less<>>;
+    auto distance = distance::DistanceL2{};
+
+    // Each thread tracks the nearest element to each centroid within its share of
+    // ``data``.
+    auto nearest = threads::SequentialTLS<std::vector<neighbor_type>>(
+        std::vector<neighbor_type>(centroids.size(), sentinel), threadpool.size()
+    );
+    threads::run(
+        threadpool,
+        threads::DynamicPartition{data.size(), 256},
+        [&](auto indices, auto tid) {
+            auto& this_nearest = nearest.at(tid);
+            for (auto i : indices) {
+                const auto& datum = data.get_datum(i);
+                for (size_t c = 0, cmax = centroids.size(); c < cmax; ++c) {
+                    auto d = distance::compute(distance, centroids.get_datum(c), datum);
+                    this_nearest[c] = std::min(this_nearest[c], neighbor_type(i, d));
+                }
+            }
+        }
+    );
+
+    auto best = std::vector<neighbor_type>(centroids.size(), sentinel);
+    nearest.visit([&](const auto& this_nearest) {
+        for (size_t c = 0, cmax = best.size(); c < cmax; ++c) {
+            best[c] = std::min(best[c], this_nearest[c]);
+        }
+    });
+
+    auto ids = std::vector<size_t>();
+    for (const auto& neighbor : best) {
+        if (neighbor.id() < data.size()) {
+            ids.push_back(neighbor.id());
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+///
+/// @brief Return the entry point nearest to ``query`` as a single element span.
+///
+/// @param data The dataset containing the entry points.
+/// @param entry_points The candidate entry points. Must not be empty.
+/// @param query The query. Must already be prepared with ``distance::maybe_fix_argument``.
+/// @param distance The distance functor used to compare ``query`` with ``data``.
+/// @param compare The comparator ordering distances from best to worst.
+///
+/// With a single entry point, no distances are computed. Wrapping this in a callable
+/// passed to ``greedy_search`` selects the entry point after the search has prepared the
+/// query, so the query is only prepared once.
+///
+template <
+    data::ImmutableMemoryDataset Data,
+    typename Idx,
+    typename Query,
+    typename Distance,
+    typename Cmp>
+std::span<const Idx> nearest_entry_point(
+    const Data& data,
+    const std::vector<Idx>& entry_points,
+    const Query& query,
+    Distance& distance,
+    const Cmp& compare
+) {
+    if (entry_points.size() == 1) {
+        return entry_points;
+    }
+    for (auto id : entry_points) {
+        data.prefetch(id, data::fast_access);
+    }
+    size_t best = 0;
+    auto best_distance = type_traits::sentinel_v<float, Cmp>;
+    for (size_t i = 0, imax = entry_points.size(); i < imax; ++i) {
+        auto d = distance::compute(
+            distance, query, data.get_datum(entry_points[i], data::fast_access)
+        );
+        if (compare(d, best_distance)) {
+            best = i;
+            best_distance = d;
+        }
+    }
+    return std::span<const Idx>(entry_points).subspan(best, 1);
+}
+
+///
+/// @brief Choose graph entry points spread over the clusters of ``data``.
+///
+/// @param parameters The k-means parameters. The number of clusters is the maximum
+///     number of entry points returned.
+/// @param data The indexed dataset.
+/// @param threadpool The threadpool used for training and assignment.
+///
+/// Runs k-means over ``data`` and returns the IDs of the elements nearest each centroid.
+/// Starting a search at the entry point nearest the query skips most of the walk in from
+/// the center of the dataset on clustered data.
+///
+template <data::ImmutableMemoryDataset Data>
+std::vector<size_t> learn_entry_points(
+    const KMeansParameters& parameters,
+    const Data& data,
+    threads::NativeThreadPool& threadpool
+) {
+    auto centroids = train_impl(parameters, data, threadpool);
+    return nearest_elements(data, centroids, threadpool);
+}
+
+} // namespace svs::index::vamana
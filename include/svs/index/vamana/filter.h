@@ -0,0 +1,51 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/neighbor.h"
+
+// stl
+#include <concepts>
+
+namespace svs::index::vamana {
+
+///
+/// @brief A predicate over vertex IDs selecting which elements a search may return.
+///
+/// Filters return ``true`` for IDs that may appear in the search results. A
+/// ``svs::lib::Bitset`` is a compact filter for an arbitrary subset of the dataset.
+///
+template <typename F, typename I>
+concept IDFilter = std::predicate<const F&, I>;
+
+///
+/// @brief Search neighbor builder that marks candidates rejected by a filter as skipped.
+///
+/// Used with a ``MutableBuffer``, skipped candidates are still expanded to navigate the
+/// graph but never count towards or appear in the search results.
+///
+template <typename Filter> class FilterBuilder {
+  public:
+    explicit FilterBuilder(const Filter& filter)
+        : filter_{filter} {}
+
+    template <typename I>
+    SkippableSearchNeighbor<I> operator()(I i, float distance) const {
+        return SkippableSearchNeighbor<I>(i, distance, !filter_(i));
+    }
+
+  private:
+    const Filter& filter_;
+};
+
+} // namespace svs::index::vamana
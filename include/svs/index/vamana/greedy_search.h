@@ -14,10 +14,16 @@
 #include "svs/concepts/data.h"
 #include "svs/concepts/distance.h"
 #include "svs/concepts/graph.h"
+#include "svs/core/distance/gather.h"
 #include "svs/index/vamana/search_buffer.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
 #include <memory>
+#include <string_view>
 
 namespace svs::index::vamana {
 
@@ -36,6 +42,28 @@ concept GreedySearchTracker =
         tracker.visited(neighbor, num_distance_computations);
     };
 
+///
+/// @brief Optional tracker extension for recording work avoided by the visited set.
+///
+/// Trackers implementing this API are notified each time greedy search skips the
+/// prefetch or distance computation for a neighbor that has already been scored.
+///
+template <typename T>
+concept GreedySearchSkipTracker = requires(T tracker) {
+    tracker.skipped_prefetch();
+    tracker.skipped_distance_computation();
+};
+
+///
+/// @brief Optional tracker extension for counting hops through the graph.
+///
+/// Trackers implementing this API are notified each time greedy search expands the
+/// adjacency list of a vertex. The number of expansions is the number of hops taken by
+/// the search.
+///
+template <typename T>
+concept GreedySearchHopTracker = requires(T tracker) { tracker.expanded(); };
+
 struct GreedySearchPrefetchParameters {
     // How far from the start of the neighbor list to begin prefetching.
     size_t offset{0};
@@ -43,6 +71,141 @@ struct GreedySearchPrefetchParameters {
     size_t step{2};
 };
 
+/////
+///// Early Termination
+/////
+
+///
+/// @brief The reason a greedy search ended.
+///
+enum class SearchTermination : uint8_t {
+    /// The search converged: every candidate in the search window was expanded.
+    converged,
+    /// The best candidates stopped improving.
+    stalled,
+    /// The budget of distance computations was exhausted.
+    distance_budget,
+    /// The time budget was exhausted.
+    time_budget,
+};
+
+inline constexpr std::string_view
+search_termination_name(SearchTermination termination) {
+    switch (termination) {
+        case SearchTermination::converged: {
+            return "converged";
+        }
+        case SearchTermination::stalled: {
+            return "stalled";
+        }
+        case SearchTermination::distance_budget: {
+            return "distance_budget";
+        }
+        case SearchTermination::time_budget: {
+            return "time_budget";
+        }
+    }
+    return "unknown";
+}
+
+///
+/// @brief Return whether a search ended before converging.
+///
+inline constexpr bool terminated_early(SearchTermination termination) {
+    return termination != SearchTermination::converged;
+}
+
+///
+/// @brief Criteria for ending a greedy search before it converges.
+///
+/// By default, greedy search runs until every candidate in the search window has been
+/// expanded. Easy queries usually find their nearest neighbors long before that, while
+/// hard queries may take many times longer than average. Early termination bounds the
+/// work done for each query at a potential cost in recall.
+///
+/// Each criterion is disabled when set to zero. The search stops as soon as any enabled
+/// criterion is met. Criteria are checked after each expansion of a candidate, so the
+/// distance budget may be exceeded by up to the maximum degree of the graph.
+///
+struct EarlyTermination {
+    /// Stop after this many consecutive expansions that did not change the best
+    /// ``num_neighbors`` candidates.
+    size_t max_stalled_expansions = 0;
+    /// Stop once this many distance computations have been performed.
+    size_t max_distance_computations = 0;
+    /// Stop once the search for a single query has run for this long.
+    std::chrono::microseconds max_time{0};
+
+    /// @brief Return whether any criterion is enabled.
+    bool enabled() const {
+        return max_stalled_expansions != 0 || max_distance_computations != 0 ||
+               max_time.count() != 0;
+    }
+
+    friend bool operator==(const EarlyTermination&, const EarlyTermination&) = default;
+};
+
+namespace detail {
+
+// Termination monitor used when early termination is not requested.
+struct NeverTerminate {
+    static constexpr void inserted(size_t /*position*/) {}
+    static constexpr void computed(size_t /*count*/) {}
+    static constexpr bool should_stop() { return false; }
+    static constexpr SearchTermination reason() { return SearchTermination::converged; }
+};
+
+// Track the progress of a single greedy search against ``EarlyTermination`` criteria.
+class TerminationMonitor {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    TerminationMonitor(const EarlyTermination& criteria, size_t num_neighbors)
+        : criteria_{criteria}
+        , num_neighbors_{num_neighbors}
+        , start_{criteria.max_time.count() == 0 ? clock::time_point{} : clock::now()} {}
+
+    // A candidate was inserted into the search buffer at ``position``.
+    void inserted(size_t position) { improved_ |= (position < num_neighbors_); }
+    // ``count`` distances were computed.
+    void computed(size_t count) { distance_computations_ += count; }
+
+    // Called after each expansion. Return ``true`` if the search should end.
+    bool should_stop() {
+        stalled_ = improved_ ? 0 : stalled_ + 1;
+        improved_ = false;
+        if (criteria_.max_stalled_expansions != 0 &&
+            stalled_ >= criteria_.max_stalled_expansions) {
+            reason_ = SearchTermination::stalled;
+            return true;
+        }
+        if (criteria_.max_distance_computations != 0 &&
+            distance_computations_ >= criteria_.max_distance_computations) {
+            reason_ = SearchTermination::distance_budget;
+            return true;
+        }
+        if (criteria_.max_time.count() != 0 &&
+            clock::now() - start_ >= criteria_.max_time) {
+            reason_ = SearchTermination::time_budget;
+            return true;
+        }
+        return false;
+    }
+
+    SearchTermination reason() const { return reason_; }
+
+  private:
+    EarlyTermination criteria_;
+    size_t num_neighbors_;
+    clock::time_point start_;
+    size_t distance_computations_ = 0;
+    size_t stalled_ = 0;
+    bool improved_ = false;
+    SearchTermination reason_ = SearchTermination::converged;
+};
+
+} // namespace detail
+
 /////
 ///// Greedy Search
 /////
@@ -57,6 +220,20 @@ struct NeighborBuilder {
     }
 };
 
+namespace detail {
+
+// Entry points may be given either as a range of IDs or as a callable
+// ``(query, distance) -> range`` invoked once the query has been prepared by the distance.
+template <typename Ep, typename QueryType, typename Dist>
+decltype(auto)
+resolve_entry_points(const Ep& entry_points, QueryType query, Dist& distance) {
+    if constexpr (std::invocable<const Ep&, QueryType, Dist&>) {
+        return entry_points(query, distance);
+    } else {
+        return (entry_points);
+    }
+}
+
 template <
     graphs::ImmutableMemoryGraph Graph,
     data::ImmutableMemoryDataset Dataset,
@@ -65,22 +242,26 @@ template <
     typename Buffer,
     typename Ep,
     typename Builder,
-    GreedySearchTracker<typename Graph::index_type> Tracker>
-void greedy_search(
+    GreedySearchTracker<typename Graph::index_type> Tracker,
+    typename Monitor>
+SearchTermination greedy_search_impl(
     const Graph& graph,
     const Dataset& dataset,
     QueryType query,
     Dist& distance_function,
     Buffer& search_buffer,
-    const Ep& entry_points,
+    const Ep& entry_points_proto,
     const Builder& builder,
     Tracker& search_tracker,
-    GreedySearchPrefetchParameters prefetch_parameters = {}
+    GreedySearchPrefetchParameters prefetch_parameters,
+    Monitor& monitor
 ) {
     using I = typename Graph::index_type;
 
     // Fix the query if needed by the distance function.
     distance::maybe_fix_argument(distance_function, query);
+    decltype(auto) entry_points =
+        resolve_entry_points(entry_points_proto, query, distance_function);
 
     // Initialize entry points.
     for (const auto& id : entry_points) {
@@ -94,24 +275,53 @@ void greedy_search(
             distance_function, query, dataset.get_datum(id, data::fast_access)
         );
         search_buffer.push_back(builder(id, dist));
+        search_buffer.set_visited(id);
         graph.prefetch_node(id);
         search_tracker.visited(Neighbor<I>{id, dist}, 1);
+        monitor.computed(1);
     }
 
+    // Unvisited neighbors are scored in blocks using ``distance::compute_gathered``.
+    auto block = std::array<I, distance::gather_block_size>();
+    auto block_distances = std::array<float, distance::gather_block_size>();
+    size_t block_size = 0;
+    auto score_block = [&]() {
+        distance::compute_gathered(
+            distance_function,
+            query,
+            dataset,
+            std::span<const I>(block.data(), block_size),
+            std::span<float>(block_distances),
+            data::fast_access
+        );
+        for (size_t i = 0; i < block_size; ++i) {
+            monitor.inserted(search_buffer.insert(builder(block[i], block_distances[i])));
+            monitor.computed(1);
+        }
+        block_size = 0;
+    };
+
     // Main search routine.
     search_buffer.sort();
     const size_t prefetch_step = prefetch_parameters.step;
     while (!search_buffer.done()) {
-        // Get the next unvisited vertex.
-        const auto& node = search_buffer.next();
+        // Get the next unvisited vertex. Copy it since inserting into the search buffer
+        // may invalidate references.
+        auto node = Neighbor<I>{search_buffer.next()};
         auto node_id = node.id();
 
         // Get the adjacency list for this vertex and prepare prefetching logic.
         auto neighbors = graph.get_node(node_id);
         auto prefetch_start = prefetch_parameters.offset;
-        search_tracker.visited(Neighbor<I>{node}, neighbors.size());
+        if constexpr (GreedySearchHopTracker<Tracker>) {
+            search_tracker.expanded();
+        }
+        size_t num_computed = 0;
         for (auto id : neighbors) {
             if (search_buffer.visited(id)) {
+                if constexpr (GreedySearchSkipTracker<Tracker>) {
+                    search_tracker.skipped_distance_computation();
+                }
                 continue;
             }
 
@@ -119,17 +329,132 @@ void greedy_search(
             if (prefetch_start < neighbors.size()) {
                 size_t upper = std::min(neighbors.size(), prefetch_start + prefetch_step);
                 for (size_t i = prefetch_start; i < upper; ++i) {
-                    dataset.prefetch(neighbors[i], data::fast_access);
+                    auto prefetch_id = neighbors[i];
+                    if (search_buffer.visited(prefetch_id)) {
+                        if constexpr (GreedySearchSkipTracker<Tracker>) {
+                            search_tracker.skipped_prefetch();
+                        }
+                        continue;
+                    }
+                    dataset.prefetch(prefetch_id, data::fast_access);
                 }
                 prefetch_start += prefetch_step;
             }
 
-            auto dist = distance::compute(
-                distance_function, query, dataset.get_datum(id, data::fast_access)
-            );
-            search_buffer.insert(builder(id, dist));
+            // Record the neighbor as scored so its distance is not recomputed when it
+            // appears in the adjacency list of another candidate.
+            search_buffer.set_visited(id);
+            block[block_size++] = id;
+            ++num_computed;
+            if (block_size == block.size()) {
+                score_block();
+            }
+        }
+        score_block();
+        // Only neighbors whose distance was computed count, not those skipped as
+        // already visited.
+        search_tracker.visited(node, num_computed);
+
+        if (monitor.should_stop()) {
+            return monitor.reason();
         }
     }
+    return SearchTermination::converged;
+}
+
+} // namespace detail
+
+// The ``entry_points`` are either a range of IDs or a callable
+// ``(query, distance) -> range`` invoked after ``distance`` has been fixed to ``query``.
+// The latter lets the entry points depend on the query without preparing it twice.
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Dataset,
+    typename QueryType,
+    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Buffer,
+    typename Ep,
+    typename Builder,
+    GreedySearchTracker<typename Graph::index_type> Tracker>
+void greedy_search(
+    const Graph& graph,
+    const Dataset& dataset,
+    QueryType query,
+    Dist& distance_function,
+    Buffer& search_buffer,
+    const Ep& entry_points,
+    const Builder& builder,
+    Tracker& search_tracker,
+    GreedySearchPrefetchParameters prefetch_parameters = {}
+) {
+    auto monitor = detail::NeverTerminate{};
+    detail::greedy_search_impl(
+        graph,
+        dataset,
+        query,
+        distance_function,
+        search_buffer,
+        entry_points,
+        builder,
+        search_tracker,
+        prefetch_parameters,
+        monitor
+    );
+}
+
+///
+/// @brief Greedy search that may end before converging.
+///
+/// @param termination The criteria for ending the search early.
+/// @param num_neighbors The number of best candidates monitored for improvement.
+///
+/// All other parameters are the same as for ``greedy_search``. If the search ends early,
+/// the search buffer holds the best candidates found so far in sorted order.
+///
+/// @returns The reason the search ended.
+///
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Dataset,
+    typename QueryType,
+    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Buffer,
+    typename Ep,
+    typename Builder,
+    GreedySearchTracker<typename Graph::index_type> Tracker>
+SearchTermination greedy_search(
+    const Graph& graph,
+    const Dataset& dataset,
+    QueryType query,
+    Dist& distance_function,
+    Buffer& search_buffer,
+    const Ep& entry_points,
+    const Builder& builder,
+    Tracker& search_tracker,
+    const EarlyTermination& termination,
+    size_t num_neighbors,
+    GreedySearchPrefetchParameters prefetch_parameters = {}
+) {
+    auto run = [&](auto& monitor) {
+        return detail::greedy_search_impl(
+            graph,
+            dataset,
+            query,
+            distance_function,
+            search_buffer,
+            entry_points,
+            builder,
+            search_tracker,
+            prefetch_parameters,
+            monitor
+        );
+    };
+    if (!termination.enabled()) {
+        auto monitor = detail::NeverTerminate{};
+        return run(monitor);
+    }
+    auto monitor = detail::TerminationMonitor{termination, num_neighbors};
+    return run(monitor);
 }
 
 // Overload to provide a default search tracker because search trackers are taken by
@@ -23,8 +23,14 @@
 #include "svs/core/graph.h"
 #include "svs/core/medioid.h"
 #include "svs/core/query_result.h"
+#include "svs/core/range_result.h"
+#include "svs/index/vamana/dynamic_search_buffer.h"
+#include "svs/index/vamana/entry_points.h"
+#include "svs/index/vamana/filter.h"
 #include "svs/index/vamana/greedy_search.h"
+#include "svs/index/vamana/interleaved_search.h"
 #include "svs/index/vamana/search_buffer.h"
+#include "svs/index/vamana/visited_table.h"
 #include "svs/index/vamana/vamana_build.h"
 #include "svs/lib/boundscheck.h"
 #include "svs/lib/preprocessor.h"
@@ -38,6 +44,9 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -52,7 +61,9 @@ struct VamanaConfigParameters {
     ///
     /// v0.0.1 - Added the "use_full_search_history" option.
     ///     Loading from older versions default this to "true"
-    static constexpr lib::Version save_version = lib::Version(0, 0, 1);
+    /// v0.0.2 - Added the "entry_points" option.
+    ///     Loading from older versions searches from "entry_point" only.
+    static constexpr lib::Version save_version = lib::Version(0, 0, 2);
 
     // Save and Reload.
     lib::SaveType save(const lib::SaveContext& /*ctx*/) const {
@@ -65,7 +76,8 @@ struct VamanaConfigParameters {
              {"construction_window_size", prepare(construction_window_size)},
              {"default_search_window_size", prepare(search_window_size)},
              {"visited_set", visited_set},
-             {"use_full_search_history", use_full_search_history}}
+             {"use_full_search_history", use_full_search_history},
+             {"entry_points", prepare(entry_points)}}
         );
         return std::make_pair(std::move(table), save_version);
     }
@@ -75,7 +87,7 @@ struct VamanaConfigParameters {
         const lib::LoadContext& SVS_UNUSED(ctx),
         const lib::Version& version
     ) {
-        if (version > lib::Version(0, 0, 1)) {
+        if (version > lib::Version(0, 0, 2)) {
             throw ANNEXCEPTION("Version mismatch!");
         }
 
@@ -96,7 +108,9 @@ struct VamanaConfigParameters {
             // implement it.
             get<bool>(table, "use_full_search_history", true),
             get<size_t>(table, "default_search_window_size"),
-            get<bool>(table, "visited_set")};
+            get<bool>(table, "visited_set"),
+            version < lib::Version(0, 0, 2) ? std::vector<size_t>()
+                                            : get_vector<size_t>(table, "entry_points")};
     }
 
     // Members
@@ -112,6 +126,9 @@ struct VamanaConfigParameters {
     // runtime parameters
     size_t search_window_size;
     bool visited_set;
+    // All entry points used to start searches. If empty, searches start from
+    // ``entry_point``.
+    std::vector<size_t> entry_points = {};
 };
 
 ///
@@ -170,6 +187,45 @@ class VamanaIndex {
     using data_type = Data;
     using entry_point_type = std::vector<Idx>;
 
+    /// The distance functor specialized for the dataset.
+    using adapted_distance_type = std::remove_cvref_t<
+        decltype(std::declval<const Data&>().adapt_distance(std::declval<const Dist&>()))>;
+
+    /// Per-thread scratch space used by search.
+    struct SearchScratch {
+        search_buffer_type buffer;
+        adapted_distance_type distance;
+    };
+
+    /// One query in flight when interleaving searches.
+    using interleaved_lane_type =
+        InterleavedLane<Idx, search_buffer_type, adapted_distance_type>;
+
+    /// Search buffer used by filtered search. Candidates rejected by the filter are
+    /// kept for navigation but do not count towards the search window.
+    using filtered_search_buffer_type = MutableBuffer<Idx, distance::compare_t<Dist>>;
+    /// The default limit on the growth of the filtered search window, as a multiple of
+    /// the search window size.
+    static constexpr size_t default_filtered_window_factor = 64;
+
+    /// Per-thread scratch space used by filtered search.
+    struct FilteredSearchScratch {
+        filtered_search_buffer_type buffer;
+        adapted_distance_type distance;
+    };
+
+    /// Per-thread scratch space used by range search.
+    struct RangeSearchScratch {
+        search_buffer_type buffer;
+        adapted_distance_type distance;
+        // Vertices whose distance to the current query has been computed.
+        GenerationTable<Idx> visited;
+        // Vertices within the radius waiting to be expanded.
+        std::vector<Idx> frontier;
+        // Vertices within the radius found so far.
+        std::vector<Neighbor<Idx>> found;
+    };
+
     // Members
   private:
     graph_type graph_;
@@ -183,6 +239,11 @@ class VamanaIndex {
     // a batch of queries.
     search_buffer_type search_buffer_prototype_ = {};
     threads::NativeThreadPool threadpool_;
+    // Search scratch space reused across calls to search.
+    threads::ScratchPool<SearchScratch> scratch_{};
+    threads::ScratchPool<std::vector<interleaved_lane_type>> interleaved_scratch_{};
+    threads::ScratchPool<FilteredSearchScratch> filtered_scratch_{};
+    threads::ScratchPool<RangeSearchScratch> range_scratch_{};
 
     // Construction parameters
     float alpha_ = 0.0;
@@ -190,6 +251,12 @@ class VamanaIndex {
     size_t construction_window_size_ = 0;
     bool use_full_search_history_ = true;
 
+    // Search parameters
+    bool work_stealing_ = false;
+    size_t interleaved_queries_ = 1;
+    EarlyTermination early_termination_{};
+    size_t filtered_window_factor_ = default_filtered_window_factor;
+
     // Methods
   public:
     ///
@@ -292,8 +359,11 @@ class VamanaIndex {
 
     /// @brief Apply the given configuration parameters to the index.
     void apply(const VamanaConfigParameters& parameters) {
-        entry_point_.clear();
-        entry_point_.push_back(parameters.entry_point);
+        if (parameters.entry_points.empty()) {
+            set_entry_points(std::vector<size_t>{parameters.entry_point});
+        } else {
+            set_entry_points(parameters.entry_points);
+        }
 
         set_alpha(parameters.alpha);
         set_max_candidates(parameters.max_candidates);
@@ -309,8 +379,8 @@ class VamanaIndex {
     // This recomputes distances between the query and the full access elements of the
     // dataset elements contained in the search buffer and re-sorts the buffer according
     // to the newly computed distances.
-    template <typename Distance, typename Query>
-    void rerank(Distance& distance, const Query& query, search_buffer_type& buffer) const {
+    template <typename Distance, typename Query, typename Buffer>
+    void rerank(Distance& distance, const Query& query, Buffer& buffer) const {
         for (size_t i = 0, imax = buffer.size(); i < imax; ++i) {
             auto& neighbor = buffer[i];
             auto id = neighbor.id();
@@ -322,6 +392,101 @@ class VamanaIndex {
         buffer.sort();
     }
 
+    // Throw if ``terminations`` is neither empty nor sized for ``num_queries`` queries.
+    static void
+    check_terminations(size_t num_queries, std::span<SearchTermination> terminations) {
+        if (!terminations.empty() && terminations.size() != num_queries) {
+            throw ANNEXCEPTION(
+                "Expected ",
+                num_queries,
+                " search terminations. Instead, got ",
+                terminations.size(),
+                '!'
+            );
+        }
+    }
+
+    // Run ``search_chunk`` over ``num_queries`` queries on ``threadpool``, partitioning
+    // the queries according to the work stealing setting.
+    template <threads::ThreadPool Pool, typename F>
+    void run_queries(Pool& threadpool, size_t num_queries, F&& search_chunk) const {
+        if (work_stealing_) {
+            threads::run(threadpool, threads::StealingPartition{num_queries}, search_chunk);
+        } else {
+            threads::run(threadpool, threads::StaticPartition{num_queries}, search_chunk);
+        }
+    }
+
+    // Copy the contents of ``buffer`` to row ``i`` of ``result`` and record the reason
+    // the search ended.
+    //
+    // A search that ends early, or a filtered search with few accepted elements, may not
+    // have found ``num_neighbors`` candidates. The remaining entries are padded with the
+    // maximum ID and the worst possible distance.
+    template <typename Buffer, typename I>
+    static void write_query_result(
+        size_t i,
+        const Buffer& buffer,
+        SearchTermination termination,
+        size_t num_neighbors,
+        QueryResultView<I>& result,
+        std::span<SearchTermination> terminations
+    ) {
+        if (!terminations.empty()) {
+            terminations[i] = termination;
+        }
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            if (j < buffer.size()) {
+                const auto& neighbor = buffer[j];
+                result.index(i, j) = neighbor.id();
+                result.distance(i, j) = neighbor.distance();
+            } else {
+                result.index(i, j) = std::numeric_limits<I>::max();
+                result.distance(i, j) =
+                    type_traits::sentinel_v<float, distance::compare_t<Dist>>;
+            }
+        }
+    }
+
+    // Return a callable choosing the entry point nearest to a prepared query.
+    // Passed as the entry points of ``greedy_search``, which prepares each query once.
+    auto select_entry_point() const {
+        return [this](const auto& query, auto& distance) {
+            return nearest_entry_point(
+                data_, entry_point_, query, distance, distance::comparator(distance_)
+            );
+        };
+    }
+
+    // Run the graph search for a single query, leaving the results in ``buffer``.
+    template <typename Query, typename Distance, typename Tracker = NullTracker>
+    SearchTermination search_query(
+        const Query& query,
+        Distance& distance,
+        search_buffer_type& buffer,
+        size_t num_neighbors,
+        Tracker&& tracker = {}
+    ) {
+        auto termination = greedy_search(
+            graph_,
+            data_,
+            query,
+            distance,
+            buffer,
+            select_entry_point(),
+            NeighborBuilder(),
+            tracker,
+            early_termination_,
+            num_neighbors
+        );
+        // TODO: Properly teach datasets how to inform the index that reranking is
+        // required.
+        if constexpr (needs_reranking) {
+            rerank(distance, query, buffer);
+        }
+        return termination;
+    }
+
     ///
     /// @brief Return the ``num_neighbors`` approximate nearest neighbors to each query.
     ///
@@ -377,44 +542,585 @@ class VamanaIndex {
     ///
     template <data::ImmutableMemoryDataset Queries, typename I>
     void search(const Queries& queries, size_t num_neighbors, QueryResultView<I> result) {
-        threads::run(
-            threadpool_,
-            threads::StaticPartition{queries.size()},
-            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
-                auto buffer = threads::shallow_copy(search_buffer_prototype_);
-                auto distance = data_.adapt_distance(distance_);
-
-                // TODO: Use iterators for returning neighbors.
-                //
-                // Perform a sanity check on the search buffer.
-                // If the buffer is too small, we need to set it to a minimum size to
-                // avoid segfaults when extracting the neighbors.
-                if (buffer.capacity() < num_neighbors) {
-                    buffer.change_maxsize(num_neighbors);
+        search(queries, num_neighbors, result, threadpool_);
+    }
+
+    ///
+    /// @brief Fill the result and record how the search for each query ended.
+    ///
+    /// @param terminations Entry ``i`` receives the reason the search for query ``i``
+    ///     ended. Must have the same size as ``queries``.
+    ///
+    /// Otherwise behaves like the search above.
+    ///
+    /// @sa set_early_termination
+    ///
+    template <data::ImmutableMemoryDataset Queries, typename I>
+    void search(
+        const Queries& queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        std::span<SearchTermination> terminations
+    ) {
+        search(queries, num_neighbors, result, threadpool_, terminations);
+    }
+
+    ///
+    /// @brief Fill the result using the threads of ``threadpool``.
+    ///
+    /// Behaves like the search above, but runs on ``threadpool`` instead of the thread
+    /// pool owned by the index. Search does not modify the index, so calls with different
+    /// thread pools may run concurrently without waiting for each other. For example:
+    ///
+    /// - A ``threads::SequentialThreadPool`` runs the search on the calling thread.
+    /// - A lease from a ``threads::PartitionedThreadPool`` shares a fixed budget of
+    ///   threads between concurrent batches.
+    ///
+    /// Concurrent searches must not overlap with calls that modify the index, such as
+    /// changing the search parameters.
+    ///
+    /// If ``terminations`` is not empty, entry ``i`` receives the reason the search for
+    /// query ``i`` ended.
+    ///
+    template <
+        data::ImmutableMemoryDataset Queries,
+        typename I,
+        threads::ThreadPool Pool>
+    void search(
+        const Queries& queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        Pool& threadpool,
+        std::span<SearchTermination> terminations = {}
+    ) {
+        check_terminations(queries.size(), terminations);
+        auto write_result = [&](size_t i,
+                                const search_buffer_type& buffer,
+                                SearchTermination termination) {
+            write_query_result(i, buffer, termination, num_neighbors, result, terminations);
+        };
+        auto run = [&](auto&& search_chunk) {
+            run_queries(threadpool, queries.size(), search_chunk);
+        };
+
+        // Scratch space is created lazily by each thread and cached by the index, so
+        // later calls (and later chunks when work stealing) do not allocate.
+        //
+        // Concurrent calls using other thread pools get their own temporary scratch.
+        if (interleaved_queries_ > 1) {
+            auto scratch = interleaved_scratch_.acquire(threadpool.size());
+            run([&](const auto is, uint64_t tid) {
+                auto& slot = scratch.at(tid);
+                if (!slot.has_value()) {
+                    slot.emplace();
+                }
+                auto& lanes = *slot;
+                for (auto& lane : lanes) {
+                    update_scratchspace(lane.buffer, num_neighbors);
+                }
+                while (lanes.size() < interleaved_queries_) {
+                    lanes.push_back(interleaved_lane_type{
+                        scratchspace(num_neighbors), data_.adapt_distance(distance_)});
+                }
+
+                interleaved_greedy_search(
+                    graph_,
+                    data_,
+                    std::span(lanes).first(interleaved_queries_),
+                    is,
+                    [&](size_t i) { return queries.get_datum(i); },
+                    select_entry_point(),
+                    early_termination_,
+                    num_neighbors,
+                    [&](size_t i, interleaved_lane_type& lane, SearchTermination reason) {
+                        if constexpr (needs_reranking) {
+                            rerank(lane.distance, queries.get_datum(i), lane.buffer);
+                        }
+                        write_result(i, lane.buffer, reason);
+                    }
+                );
+            });
+            return;
+        }
+
+        auto scratch = scratch_.acquire(threadpool.size());
+        run([&](const auto is, uint64_t tid) {
+            auto& slot = scratch.at(tid);
+            if (slot.has_value()) {
+                update_scratchspace(slot->buffer, num_neighbors);
+            } else {
+                slot.emplace(SearchScratch{
+                    scratchspace(num_neighbors), data_.adapt_distance(distance_)});
+            }
+            auto& buffer = slot->buffer;
+            auto& distance = slot->distance;
+
+            for (auto i : is) {
+                const auto& query = queries.get_datum(i);
+                auto termination = search_query(query, distance, buffer, num_neighbors);
+                write_result(i, buffer, termination);
+            }
+        });
+    }
+
+    ///
+    /// @brief Search only the dataset elements accepted by ``filter``.
+    ///
+    /// @param queries The queries. Each entry will be processed.
+    /// @param num_neighbors The number of approximate nearest neighbors to return for
+    ///     each query.
+    /// @param result The result data structure to populate.
+    /// @param filter Predicate over IDs in ``[0, size())``. Only elements for which it
+    ///     returns ``true`` are returned. A ``svs::lib::Bitset`` is a compact choice.
+    /// @param terminations If not empty, entry ``i`` receives the reason the search for
+    ///     query ``i`` ended. Must then have the same size as ``queries``.
+    ///
+    /// Elements rejected by the filter are still used to navigate the graph, so the
+    /// search is not cut off by regions of the graph the filter excludes. The search
+    /// window only counts accepted candidates and grows to hold rejected ones as needed,
+    /// so selective filters automatically explore more of the graph. The window never
+    /// grows beyond ``get_filtered_window_factor()`` times the search window size, which
+    /// bounds the work done when the filter accepts few or no elements. Early termination
+    /// criteria apply as usual.
+    ///
+    /// The visited set is always used since the window may grow well beyond the
+    /// configured search window size.
+    ///
+    /// If fewer than ``num_neighbors`` accepted elements are found, the remaining entries
+    /// of the result hold the maximum ID and the worst possible distance.
+    ///
+    template <data::ImmutableMemoryDataset Queries, typename I, IDFilter<Idx> Filter>
+    void search(
+        const Queries& queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        const Filter& filter,
+        std::span<SearchTermination> terminations = {}
+    ) {
+        search(queries, num_neighbors, result, filter, threadpool_, terminations);
+    }
+
+    ///
+    /// @brief Run a filtered search using the threads of ``threadpool``.
+    ///
+    /// Behaves like the filtered search above, but runs on ``threadpool`` instead of the
+    /// thread pool owned by the index. Concurrency follows the same rules as the
+    /// unfiltered search taking a thread pool.
+    ///
+    template <
+        data::ImmutableMemoryDataset Queries,
+        typename I,
+        IDFilter<Idx> Filter,
+        threads::ThreadPool Pool>
+    void search(
+        const Queries& queries,
+        size_t num_neighbors,
+        QueryResultView<I> result,
+        const Filter& filter,
+        Pool& threadpool,
+        std::span<SearchTermination> terminations = {}
+    ) {
+        check_terminations(queries.size(), terminations);
+        auto builder = FilterBuilder{filter};
+        size_t target = std::max(get_search_window_size(), num_neighbors);
+        // Saturate so very large factors remove the limit.
+        size_t limit = std::numeric_limits<size_t>::max();
+        if (filtered_window_factor_ <= limit / std::max(target, size_t{1})) {
+            limit = filtered_window_factor_ * target;
+        }
+
+        auto scratch = filtered_scratch_.acquire(threadpool.size());
+        run_queries(threadpool, queries.size(), [&](const auto is, uint64_t tid) {
+            auto& slot = scratch.at(tid);
+            if (!slot.has_value()) {
+                slot.emplace(FilteredSearchScratch{
+                    filtered_search_buffer_type{
+                        target, distance::comparator(distance_), true},
+                    data_.adapt_distance(distance_)});
+            } else if (slot->buffer.target() != target) {
+                slot->buffer.change_maxsize(target);
+            }
+            slot->buffer.set_size_limit(limit);
+            auto& buffer = slot->buffer;
+            auto& distance = slot->distance;
+            buffer.reserve_visited(data_.size());
+
+            auto tracker = NullTracker{};
+            for (auto i : is) {
+                const auto& query = queries.get_datum(i);
+                auto termination = greedy_search(
+                    graph_,
+                    data_,
+                    query,
+                    distance,
+                    buffer,
+                    select_entry_point(),
+                    builder,
+                    tracker,
+                    early_termination_,
+                    num_neighbors
+                );
+                buffer.cleanup();
+                if constexpr (needs_reranking) {
+                    rerank(distance, query, buffer);
                 }
+                write_query_result(
+                    i, buffer, termination, num_neighbors, result, terminations
+                );
+            }
+        });
+    }
 
-                for (auto i : is) {
-                    const auto& query = queries.get_datum(i);
+    ///
+    /// @brief Find the dataset elements within ``radius`` of each query.
+    ///
+    /// @param queries The queries. Each entry will be processed.
+    /// @param radius The search radius. For distances where smaller is better, elements
+    ///     with a distance of at most ``radius`` are returned. For similarities where
+    ///     larger is better, elements with a similarity of at least ``radius`` are
+    ///     returned.
+    /// @param max_neighbors The maximum number of neighbors to return for each query.
+    /// @param result The result to populate. Reusing the same result across calls avoids
+    ///     reallocating its storage.
+    ///
+    /// Each query starts with a regular graph search using the current search window.
+    /// The candidates within the radius then seed a breadth-first expansion of the graph
+    /// that continues through every newly discovered vertex within the radius. Large
+    /// result sets are thus found in a single pass rather than by repeating the search
+    /// with larger windows. Expansion stops once ``max_neighbors`` vertices within the
+    /// radius have been found. The neighbors of each query are sorted from best to worst.
+    ///
+    /// As with any graph search, the result is approximate. Elements within the radius
+    /// are missed if no path through the radius connects them to the seeds.
+    ///
+    template <data::ImmutableMemoryDataset Queries>
+    void range_search(
+        const Queries& queries,
+        float radius,
+        size_t max_neighbors,
+        RangeSearchResult<size_t>& result
+    ) {
+        range_search(queries, radius, max_neighbors, result, threadpool_);
+    }
 
-                    // Perform the greedy search.
-                    // Results from the search will be present in `buffer`.
-                    greedy_search(graph_, data_, query, distance, buffer, entry_point_);
+    ///
+    /// @brief Run a range search using the threads of ``threadpool``.
+    ///
+    /// Behaves like the range search above, but runs on ``threadpool`` instead of the
+    /// thread pool owned by the index. Concurrency follows the same rules as the
+    /// search taking a thread pool.
+    ///
+    template <data::ImmutableMemoryDataset Queries, threads::ThreadPool Pool>
+    void range_search(
+        const Queries& queries,
+        float radius,
+        size_t max_neighbors,
+        RangeSearchResult<size_t>& result,
+        Pool& threadpool
+    ) {
+        using compare = distance::compare_t<Dist>;
+        if (max_neighbors == 0) {
+            throw ANNEXCEPTION("Range search requires a positive neighbor limit!");
+        }
+        auto within = [radius](float d) { return within_radius<compare>(d, radius); };
+        auto by_distance = [&](const Neighbor<Idx>& a, const Neighbor<Idx>& b) {
+            return compare{}(a.distance(), b.distance());
+        };
+
+        result.prepare(queries.size(), threadpool.size());
+        auto scratch = range_scratch_.acquire(threadpool.size());
+        run_queries(threadpool, queries.size(), [&](const auto is, uint64_t tid) {
+            auto& slot = scratch.at(tid);
+            if (slot.has_value()) {
+                update_scratchspace(slot->buffer);
+            } else {
+                slot.emplace(RangeSearchScratch{
+                    scratchspace(), data_.adapt_distance(distance_), {}, {}, {}});
+            }
+            auto& buffer = slot->buffer;
+            auto& distance = slot->distance;
+            auto& visited = slot->visited;
+            auto& frontier = slot->frontier;
+            auto& found = slot->found;
+            visited.reserve(data_.size());
+            auto& partial = result.partial(tid);
+
+            for (auto i : is) {
+                const auto& query = queries.get_datum(i);
+                search_query(query, distance, buffer, buffer.capacity());
+
+                // Seed the expansion with the candidates of the graph search.
+                visited.clear();
+                frontier.clear();
+                found.clear();
+                for (size_t j = 0, jmax = buffer.size(); j < jmax; ++j) {
+                    const auto& neighbor = buffer[j];
+                    visited.insert(neighbor.id());
+                    if (within(neighbor.distance())) {
+                        found.push_back(Neighbor<Idx>{neighbor.id(), neighbor.distance()});
+                        frontier.push_back(neighbor.id());
+                    }
+                }
 
-                    // Copy back results.
-                    if constexpr (needs_reranking) {
-                        rerank(distance, query, buffer);
+                // Breadth-first expansion through vertices within the radius.
+                size_t head = 0;
+                while (head < frontier.size() && found.size() < max_neighbors) {
+                    for (auto id : graph_.get_node(frontier[head++])) {
+                        if (!visited.emplace(id)) {
+                            continue;
+                        }
+                        auto d = distance::compute(
+                            distance, query, data_.get_datum(id, data::fast_access)
+                        );
+                        if (within(d)) {
+                            found.push_back(Neighbor<Idx>{id, d});
+                            frontier.push_back(id);
+                        }
                     }
+                }
 
-                    for (size_t j = 0; j < num_neighbors; ++j) {
-                        const auto& neighbor = buffer[j];
-                        result.index(i, j) = neighbor.id();
-                        result.distance(i, j) = neighbor.distance();
+                // Check the expanded vertices against the full precision data.
+                if constexpr (needs_reranking) {
+                    for (auto& neighbor : found) {
+                        neighbor.set_distance(distance::compute(
+                            distance,
+                            query,
+                            data_.get_datum(neighbor.id(), data::full_access)
+                        ));
                     }
+                    std::erase_if(found, [&](const auto& x) {
+                        return !within(x.distance());
+                    });
+                }
+
+                size_t count = std::min(found.size(), max_neighbors);
+                std::partial_sort(
+                    found.begin(), found.begin() + count, found.end(), by_distance
+                );
+                for (size_t j = 0; j < count; ++j) {
+                    const auto& neighbor = found[j];
+                    partial.push_back(
+                        i, Neighbor<size_t>{neighbor.id(), neighbor.distance()}
+                    );
                 }
             }
+        });
+        result.finish(compare());
+    }
+
+    ///
+    /// @brief Return a search buffer configured with the current search parameters.
+    ///
+    /// @param num_neighbors The minimum capacity of the buffer.
+    ///
+    /// The returned buffer is scratch space for ``search_single``. Each thread searching
+    /// concurrently needs its own buffer. A buffer may be reused for any number of
+    /// searches, but should be recreated when the search parameters change.
+    ///
+    search_buffer_type scratchspace(size_t num_neighbors = 0) const {
+        auto buffer = threads::shallow_copy(search_buffer_prototype_);
+        // TODO: Use iterators for returning neighbors.
+        //
+        // Perform a sanity check on the search buffer.
+        // If the buffer is too small, we need to set it to a minimum size to avoid
+        // segfaults when extracting the neighbors.
+        if (buffer.capacity() < num_neighbors) {
+            buffer.change_maxsize(num_neighbors);
+        }
+        // Size the visited set (if enabled) once up front to avoid incremental growth
+        // during the search.
+        buffer.reserve_visited(data_.size());
+        return buffer;
+    }
+
+    ///
+    /// @brief Bring a previously created search buffer up to date.
+    ///
+    /// Applies any changes to the search window size and visited set made since
+    /// ``buffer`` was obtained from ``scratchspace()``. Memory is only reallocated if
+    /// the window size changed.
+    ///
+    void update_scratchspace(search_buffer_type& buffer, size_t num_neighbors = 0) const {
+        size_t capacity = std::max(search_buffer_prototype_.capacity(), num_neighbors);
+        if (buffer.capacity() != capacity) {
+            buffer.change_maxsize(capacity);
+        }
+        if (search_buffer_prototype_.visited_set_enabled()) {
+            buffer.enable_visited_set();
+            buffer.reserve_visited(data_.size());
+        } else {
+            buffer.disable_visited_set();
+        }
+    }
+
+    ///
+    /// @brief Search for the neighbors of a single query on the calling thread.
+    ///
+    /// @param query The query.
+    /// @param buffer Scratch space obtained from ``scratchspace()``.
+    /// @param num_neighbors The number of neighbors of interest. Used by the early
+    ///     termination criteria. Defaults to the full search window.
+    ///
+    /// After the call, ``buffer[j]`` holds the ``j``th nearest neighbor found. No thread
+    /// pool is involved, so any number of threads may call this concurrently, each with
+    /// its own buffer.
+    ///
+    /// @returns The reason the search ended.
+    ///
+    template <typename Query>
+    SearchTermination search_single(
+        const Query& query, search_buffer_type& buffer, size_t num_neighbors = 0
+    ) {
+        return search_single(query, buffer, NullTracker{}, num_neighbors);
+    }
+
+    ///
+    /// @brief Search for a single query, reporting the work done to ``tracker``.
+    ///
+    /// Behaves like ``search_single`` without a tracker. A ``SearchTracker`` records
+    /// statistics such as the number of distance computations and hops.
+    ///
+    template <typename Query, GreedySearchTracker<Idx> Tracker>
+    SearchTermination search_single(
+        const Query& query,
+        search_buffer_type& buffer,
+        Tracker&& tracker,
+        size_t num_neighbors = 0
+    ) {
+        auto distance = data_.adapt_distance(distance_);
+        if (num_neighbors == 0) {
+            num_neighbors = buffer.capacity();
+        }
+        return search_query(
+            query, distance, buffer, num_neighbors, std::forward<Tracker>(tracker)
         );
     }
 
+    ///// Entry Points
+
+    ///
+    /// @brief Set the vertices where graph searches begin.
+    ///
+    /// @param entry_points The entry points. Must be non-empty with all IDs in
+    ///     ``[0, size())``.
+    ///
+    /// With more than one entry point, each search starts from the entry point nearest
+    /// the query. Choosing it costs one distance computation per entry point, so a few
+    /// dozen to a few hundred entry points spread over the dataset work best. Graph
+    /// construction always uses the first entry point.
+    ///
+    /// @sa learn_entry_points
+    ///
+    template <std::integral I> void set_entry_points(const std::vector<I>& entry_points) {
+        if (entry_points.empty()) {
+            throw ANNEXCEPTION("At least one entry point is required!");
+        }
+        auto new_entry_points = entry_point_type();
+        for (auto id : entry_points) {
+            if (lib::narrow<size_t>(id) >= size()) {
+                throw ANNEXCEPTION(
+                    "Entry point ",
+                    id,
+                    " is out of bounds for an index of size ",
+                    size(),
+                    '!'
+                );
+            }
+            new_entry_points.push_back(lib::narrow<Idx>(id));
+        }
+        entry_point_ = std::move(new_entry_points);
+    }
+
+    /// @brief Return the vertices where graph searches begin.
+    const entry_point_type& get_entry_points() const { return entry_point_; }
+
+    ///
+    /// @brief Replace the entry points with vertices spread over the clusters of the data.
+    ///
+    /// @param parameters The k-means parameters. The number of clusters is the maximum
+    ///     number of entry points.
+    ///
+    /// The current first entry point (usually the medioid) is kept first so that graph
+    /// construction is unaffected. Requires a dataset with directly accessible elements.
+    ///
+    /// @sa svs::index::vamana::learn_entry_points
+    ///
+    void learn_entry_points(const KMeansParameters& parameters) {
+        auto learned = vamana::learn_entry_points(parameters, data_, threadpool_);
+        auto entry_points = std::vector<size_t>{entry_point_.front()};
+        for (auto id : learned) {
+            if (id != entry_points.front()) {
+                entry_points.push_back(id);
+            }
+        }
+        set_entry_points(entry_points);
+    }
+
+    ///
+    /// @brief Enable or disable work stealing between threads during search.
+    ///
+    /// By default, queries are divided evenly between threads up front. When the cost of
+    /// individual queries varies widely, work stealing reduces the time spent waiting on
+    /// the slowest thread.
+    ///
+    void set_work_stealing(bool enable) { work_stealing_ = enable; }
+    /// @brief Return whether work stealing is enabled for search.
+    bool get_work_stealing() const { return work_stealing_; }
+
+    ///
+    /// @brief Set the number of queries each thread searches at the same time.
+    ///
+    /// With a single query per thread (the default), each hop of the graph search waits
+    /// on memory. Interleaving the searches for several queries hides this latency by
+    /// working on other queries while data is prefetched. This can improve throughput
+    /// when search is bound by memory latency, such as for indexes much larger than the
+    /// last level cache. The benefit depends on the hardware, so measure before enabling
+    /// it. Values between 4 and 16 are a good starting point. Results are the same for
+    /// any setting.
+    ///
+    /// Applies to batch search without a filter. Passing zero is the same as one.
+    ///
+    /// @sa interleaved_greedy_search
+    ///
+    void set_interleaved_queries(size_t count) {
+        interleaved_queries_ = std::max(count, size_t{1});
+    }
+    /// @brief Return the number of queries each thread searches at the same time.
+    size_t get_interleaved_queries() const { return interleaved_queries_; }
+
+    ///
+    /// @brief Set the criteria for ending the search for a query before it converges.
+    ///
+    /// Early termination bounds the work done for hard queries. This can be used to meet
+    /// per-query latency targets at the cost of some recall. The default criteria never
+    /// end a search early.
+    ///
+    /// A search that ends early may find fewer than the requested number of neighbors.
+    /// The remaining entries of the result hold the maximum ID and the worst possible
+    /// distance.
+    ///
+    /// @sa EarlyTermination
+    ///
+    void set_early_termination(const EarlyTermination& criteria) {
+        early_termination_ = criteria;
+    }
+    /// @brief Return the criteria for ending the search for a query early.
+    EarlyTermination get_early_termination() const { return early_termination_; }
+
+    ///
+    /// @brief Set how far the search window may grow during filtered search.
+    ///
+    /// The window of a filtered search holds at most ``factor`` times the search window
+    /// size candidates, accepted or not. Larger values find more accepted elements for
+    /// very selective filters at the cost of more work per query. Passing zero is the
+    /// same as one.
+    ///
+    void set_filtered_window_factor(size_t factor) {
+        filtered_window_factor_ = std::max(factor, size_t{1});
+    }
+    /// @brief Return how far the search window may grow during filtered search.
+    size_t get_filtered_window_factor() const { return filtered_window_factor_; }
+
     // TODO (Mark): Make descriptions better.
     std::string name() const { return "VamanaIndex"; }
 
@@ -477,6 +1183,14 @@ class VamanaIndex {
     size_t get_search_window_size() const { return search_buffer_prototype_.capacity(); }
 
     ///// Visited Set Interface
+
+    ///
+    /// @brief Enable the visited set for graph search.
+    ///
+    /// When enabled, each search thread keeps a flat table with one slot per vertex to
+    /// avoid recomputing distances to already expanded vertices. Clearing the table
+    /// between queries takes constant time.
+    ///
     void enable_visited_set() { search_buffer_prototype_.enable_visited_set(); }
     void disable_visited_set() { search_buffer_prototype_.disable_visited_set(); }
     bool visited_set_enabled() const {
@@ -546,7 +1260,8 @@ class VamanaIndex {
             get_construction_window_size(),
             get_full_search_history(),
             get_search_window_size(),
-            visited_set_enabled()};
+            visited_set_enabled(),
+            std::vector<size_t>(entry_point_.begin(), entry_point_.end())};
         // Config
         lib::save(parameters, config_directory);
         // Data
@@ -562,24 +1277,21 @@ class VamanaIndex {
 /// @brief Forward an existing dataset.
 ///
 template <data::ImmutableMemoryDataset Data, threads::ThreadPool Pool>
-std::tuple<Data&, size_t>
-load_dataset(NoopLoaderTag SVS_UNUSED(tag), Data& data, Pool& threadpool) {
-    size_t entry_point = utils::find_medioid(data, threadpool);
-    return std::tuple<Data&, size_t>(data, entry_point);
+Data&
+load_dataset(NoopLoaderTag SVS_UNUSED(tag), Data& data, Pool& SVS_UNUSED(threadpool)) {
+    return data;
 }
 
 ///
 /// @brief Load a standard dataset.
 ///
 template <typename T, size_t Extent, typename Builder, threads::ThreadPool Pool>
-std::tuple<typename VectorDataLoader<T, Extent, Builder>::return_type, size_t> load_dataset(
+typename VectorDataLoader<T, Extent, Builder>::return_type load_dataset(
     VectorDataLoaderTag SVS_UNUSED(tag),
     const VectorDataLoader<T, Extent, Builder>& loader,
-    Pool& threadpool
+    Pool& SVS_UNUSED(threadpool)
 ) {
-    auto data = loader.load();
-    size_t medioid_index = utils::find_medioid(data, threadpool);
-    return std::make_tuple(std::move(data), medioid_index);
+    return loader.load();
 }
 
 template <typename LVQLoader, threads::ThreadPool Pool>
@@ -590,19 +1302,35 @@ auto load_dataset(
 ) {
     // TODO: Allow propagation of allocators.
     // TODO: Propagate threat pools around to avoid creating new threads all the time.
-    auto lvq_dataset =
-        loader.load(data::PolymorphicBuilder<HugepageAllocator>(), threadpool.size());
-
-    // Compute the index of the approximate medioid
-    size_t medioid_index = utils::find_medioid(
-        lvq_dataset,
-        threadpool,
-        lib::ReturnsTrueType(),    /*predicate*/
-        lvq_dataset.decompressor() /*element-wise map*/
-    );
+    return loader.load(data::PolymorphicBuilder<HugepageAllocator>(), threadpool.size());
+}
+
+namespace detail {
+template <typename Data, threads::ThreadPool Pool, typename F = lib::ReturnsTrueType>
+size_t find_medioid_helper(
+    const Data& data, Pool& threadpool, F&& predicate = lib::ReturnsTrueType()
+) {
+    return utils::find_medioid(data, threadpool, std::forward<F>(predicate));
+}
 
-    return std::make_tuple(std::move(lvq_dataset), medioid_index);
+// Compute the medioid of LVQ datasets over the decompressed vectors.
+template <
+    size_t Primary,
+    size_t Residual,
+    size_t N,
+    typename Storage,
+    threads::ThreadPool Pool,
+    typename F = lib::ReturnsTrueType>
+size_t find_medioid_helper(
+    const quantization::lvq::LVQDataset<Primary, Residual, N, Storage>& data,
+    Pool& threadpool,
+    F&& predicate = lib::ReturnsTrueType()
+) {
+    return utils::find_medioid(
+        data, threadpool, std::forward<F>(predicate), data.decompressor()
+    );
 }
+} // namespace detail
 
 ///
 /// @brief Resolve a filename as an entrypoint using the ``load_entry_point`` method.
@@ -689,8 +1417,8 @@ auto auto_build(
     const Allocator& graph_allocator
 ) {
     auto threadpool = threads::as_threadpool(threadpool_proto);
-    auto [data, entry_point] =
-        load_dataset(lib::loader_tag<DataProto>, data_proto, threadpool);
+    decltype(auto) data = load_dataset(lib::loader_tag<DataProto>, data_proto, threadpool);
+    size_t entry_point = detail::find_medioid_helper(data, threadpool);
 
     // Default graph.
     auto graph = default_graph(data.size(), parameters.graph_max_degree, graph_allocator);
@@ -715,10 +1443,17 @@ auto auto_build(
 /// @param threadpool_proto Precursor for the thread pool to use. Can either be a
 ///        threadpool instance of an integer specifying the number of threads to use.
 ///
+/// @param recompute_entry_point If ``true``, ignore the entry points stored in the
+///        configuration file and use the recomputed medioid of the dataset instead.
+///
 /// This method provides much of the heavy lifting for instantiating a Vamana index from
 /// a collection of files on disk (or perhaps a mix-and-match of existing data in-memory
 /// and on disk).
 ///
+/// By default, the entry point saved alongside the index is used. This avoids a full pass
+/// over the dataset, so assembly time is dominated by reading the files. Recomputing the
+/// entry point is only necessary if the dataset was modified independently of the graph.
+///
 /// @copydoc hidden_vamana_auto_assemble_doc
 ///
 /// Refer to the examples for use of this interface.
@@ -732,23 +1467,35 @@ auto auto_assemble(
     GraphProto graph_loader,
     DataProto data_proto,
     Distance distance,
-    ThreadPoolProto threadpool_proto
+    ThreadPoolProto threadpool_proto,
+    bool recompute_entry_point = false
 ) {
     auto threadpool = threads::as_threadpool(threadpool_proto);
-    auto [data, computed_entry_point] =
-        load_dataset(lib::loader_tag<DataProto>, data_proto, threadpool);
+    auto config = lib::load<VamanaConfigParameters>(config_path);
+    decltype(auto) data = load_dataset(lib::loader_tag<DataProto>, data_proto, threadpool);
+    if (recompute_entry_point) {
+        config.entry_point = detail::find_medioid_helper(data, threadpool);
+        config.entry_points.clear();
+    }
 
     auto graph = graph_loader.load();
     // Extract the index type of the provided graph.
     using I = typename decltype(graph)::index_type;
+    if (config.entry_point >= data.size()) {
+        throw ANNEXCEPTION(
+            "Entry point ",
+            config.entry_point,
+            " is out of bounds for a dataset of size ",
+            data.size(),
+            '!'
+        );
+    }
     auto index = VamanaIndex{
         std::move(graph),
         std::move(data),
-        lib::narrow<I>(computed_entry_point),
+        lib::narrow<I>(config.entry_point),
         std::move(distance),
         std::move(threadpool)};
-
-    auto config = lib::load<VamanaConfigParameters>(config_path);
     index.apply(config);
     return index;
 }
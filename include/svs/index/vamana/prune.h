@@ -13,14 +13,29 @@
 
 #include "svs/concepts/data.h"
 #include "svs/concepts/distance.h"
+#include "svs/core/distance/gather.h"
 #include "svs/lib/neighbor.h"
 #include "svs/lib/type_traits.h"
 
 #include <functional>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace svs::index::vamana {
 
+///
+/// @brief Scratch space for ``heuristic_prune_neighbors``.
+///
+/// Owned by the caller (usually one per thread) so repeated pruning does not allocate.
+///
+template <typename I> struct PruneScratch {
+    std::vector<bool> pruned{};
+    std::vector<size_t> positions{};
+    std::vector<I> ids{};
+    std::vector<float> distances{};
+};
+
 ///
 /// @brief Function to prune neighbors using MRNG rule (extended with alpha as in Vamana).
 ///
@@ -29,13 +44,17 @@ namespace svs::index::vamana {
 /// @tparam Neighbors The full neighbor-type of the candidate pool.
 /// @tparam I The type of the reusting index for each neighbor.
 /// @tparam Alloc Allocator for the result vector.
+/// @tparam J The ID type of the candidates in ``pool``.
+///
+/// @param scratch Caller-owned scratch space, reused across calls.
 ///
 template <
     data::ImmutableMemoryDataset Data,
     distance::Distance<data::const_value_type_t<Data>, data::const_value_type_t<Data>> Dist,
     NeighborLike Neighbors,
     typename I,
-    typename Alloc>
+    typename Alloc,
+    typename J>
 void heuristic_prune_neighbors(
     size_t max_result_size,
     float alpha,
@@ -43,7 +62,8 @@ void heuristic_prune_neighbors(
     Dist& distance_function,
     size_t current_node_id,
     const std::span<const Neighbors>& pool,
-    std::vector<I, Alloc>& result
+    std::vector<I, Alloc>& result,
+    PruneScratch<J>& scratch
 ) {
     auto cmp = distance::comparator(distance_function);
     assert(std::is_sorted(pool.begin(), pool.end(), cmp));
@@ -54,9 +74,17 @@ void heuristic_prune_neighbors(
     result.clear();
     result.reserve(max_result_size);
     size_t poolsize = pool.size();
-    std::vector<bool> pruned(poolsize, false);
+    auto& pruned = scratch.pruned;
+    pruned.assign(poolsize, false);
     size_t start = 0;
 
+    // The candidates remaining after each selection are scored together.
+    static_assert(std::is_same_v<J, std::remove_cvref_t<decltype(pool.front().id())>>);
+    auto& positions = scratch.positions;
+    auto& ids = scratch.ids;
+    auto& distances = scratch.distances;
+    distances.resize(poolsize);
+
     while (result.size() < max_result_size && start < poolsize) {
         auto id = pool[start].id();
         if (pruned[start] || id == current_node_id) {
@@ -70,18 +98,26 @@ void heuristic_prune_neighbors(
         const auto& query = dataset.get_datum(id, data::full_access);
         distance::maybe_fix_argument(distance_function, query);
         result.push_back(id);
+        positions.clear();
+        ids.clear();
         for (size_t t = start + 1; t < poolsize; ++t) {
-            if (pruned[t]) {
-                continue;
+            if (!pruned[t]) {
+                positions.push_back(t);
+                ids.push_back(pool[t].id());
             }
+        }
 
-            const auto& candidate = pool[t];
-            auto djk = distance::compute(
-                distance_function,
-                query,
-                dataset.get_datum(candidate.id(), data::full_access)
-            );
-            if (cmp(alpha * djk, candidate.distance())) {
+        distance::compute_gathered(
+            distance_function,
+            query,
+            dataset,
+            std::span<const J>(ids),
+            std::span<float>(distances),
+            data::full_access
+        );
+        for (size_t k = 0, kmax = positions.size(); k < kmax; ++k) {
+            auto t = positions[k];
+            if (cmp(alpha * distances[k], pool[t].distance())) {
                 pruned[t] = true;
             }
         }
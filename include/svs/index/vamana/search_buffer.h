@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "svs/index/vamana/visited_table.h"
 #include "svs/lib/datatype.h"
 #include "svs/lib/neighbor.h"
 #include "svs/lib/threads/threadlocal.h"
@@ -21,7 +22,6 @@
 #include <iostream>
 #include <optional>
 #include <type_traits>
-#include <unordered_set>
 #include <vector>
 
 namespace svs::index::vamana {
@@ -43,7 +43,7 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     using iterator = typename vector_type::iterator;
     using const_iterator = typename vector_type::const_iterator;
 
-    using set_type = std::unordered_set<Idx>;
+    using set_type = GenerationTable<Idx>;
 
     ///
     /// @brief Initialize a buffer with zero capacity.
@@ -81,7 +81,11 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     SearchBuffer shallow_copy() const {
         // We care about the contents of the buffer - just its size.
         // Therefore, we can construct a new buffer from scratch.
-        return SearchBuffer{capacity(), compare_, visited_set_enabled()};
+        auto buffer = SearchBuffer{capacity(), compare_, visited_set_enabled()};
+        if (visited_set_enabled()) {
+            buffer.reserve_visited(visited_->size());
+        }
+        return buffer;
     }
 
     ///
@@ -297,12 +301,31 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     ///
     /// Visited set use does not affect accuracy but may affect performance.
     ///
+    /// When enabled, greedy search records every vertex whose distance has been computed,
+    /// not just those that have been expanded. Vertices reached again through another
+    /// adjacency list skip both prefetching and distance computation.
+    ///
+    /// The visited set is a flat table with one slot per vertex which is cleared in
+    /// constant time between searches. It grows as needed, but can be sized up-front
+    /// using ``reserve_visited``.
+    ///
     void enable_visited_set() {
         if (!visited_set_enabled()) {
             visited_.emplace();
         }
     }
 
+    ///
+    /// @brief Pre-size the visited set to hold vertices in ``[0, num_vertices)``.
+    ///
+    /// Has no effect if the visited set is disabled.
+    ///
+    void reserve_visited(size_t num_vertices) {
+        if (visited_set_enabled()) {
+            visited_->reserve(num_vertices);
+        }
+    }
+
     ///
     /// @brief Disable use of the visited set when performing greedy searches.
     /// Visited set use does not affect accuracy but may affect performance.
@@ -26,15 +26,25 @@ class SearchTracker {
     SearchTracker()
         : accessed_points_{100}
         , accessed_search_neighbors_{100}
-        , n_distance_computations_{0} {}
+        , n_distance_computations_{0}
+        , n_skipped_distance_computations_{0}
+        , n_skipped_prefetches_{0}
+        , n_hops_{0} {}
 
     // Satisfy the `GreedySearchTracker` concept.
-    void visited(SearchNeighbor<Idx> neighbor, size_t n_computations) {
+    void visited(Neighbor<Idx> neighbor, size_t n_computations) {
         add_visited_point(neighbor.id_);
         add_visited_neighbor(neighbor);
         add_distance_computations(n_computations);
     }
 
+    // Satisfy the `GreedySearchSkipTracker` concept.
+    void skipped_distance_computation() { ++n_skipped_distance_computations_; }
+    void skipped_prefetch() { ++n_skipped_prefetches_; }
+
+    // Satisfy the `GreedySearchHopTracker` concept.
+    void expanded() { ++n_hops_; }
+
     void add_distance_computations(size_t n = 1) { n_distance_computations_ += n; }
 
     void add_visited_point(Idx idx) { accessed_points_.insert(idx); }
@@ -45,6 +55,26 @@ class SearchTracker {
 
     size_t n_distance_computations() const { return n_distance_computations_; }
 
+    ///
+    /// @brief Return the number of distance computations avoided by the visited set.
+    ///
+    size_t n_skipped_distance_computations() const {
+        return n_skipped_distance_computations_;
+    }
+
+    ///
+    /// @brief Return the number of dataset prefetches avoided by the visited set.
+    ///
+    size_t n_skipped_prefetches() const { return n_skipped_prefetches_; }
+
+    ///
+    /// @brief Return the number of vertices whose adjacency lists were expanded.
+    ///
+    /// Each expansion is one hop through the graph. Entry points that are never
+    /// expanded do not count.
+    ///
+    size_t n_hops() const { return n_hops_; }
+
     const tsl::robin_set<Idx>& accessed_points() const { return accessed_points_; }
 
     const tsl::robin_set<Neighbor<Idx>>& accessed_search_neighbors() const {
@@ -55,5 +85,8 @@ class SearchTracker {
     tsl::robin_set<Idx> accessed_points_;
     tsl::robin_set<Neighbor<Idx>, IDHash, IDEqual> accessed_search_neighbors_;
     size_t n_distance_computations_;
+    size_t n_skipped_distance_computations_;
+    size_t n_skipped_prefetches_;
+    size_t n_hops_;
 };
 } // namespace svs::index::vamana
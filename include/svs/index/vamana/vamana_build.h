@@ -14,6 +14,7 @@
 // local
 #include "svs/concepts/data.h"
 #include "svs/concepts/distance.h"
+#include "svs/core/distance/gather.h"
 #include "svs/index/vamana/build_params.h"
 #include "svs/index/vamana/greedy_search.h"
 #include "svs/index/vamana/prune.h"
@@ -193,7 +194,13 @@ class VamanaBuilder {
         , params_{params}
         , threadpool_{threadpool}
         , vertex_locks_(data.size())
-        , backedge_buffer_{data.size(), 1000} {
+        , backedge_buffer_{data.size(), 1000}
+        , search_buffers_{
+              search_buffer_type{
+                  params.window_size,
+                  distance::comparator(distance_function_),
+                  params.use_visited_set},
+              threadpool.size()} {
         // Check class invariants.
         if (graph_.n_nodes() != data_.size()) {
             throw ANNEXCEPTION(
@@ -298,16 +305,19 @@ class VamanaBuilder {
         const std::vector<Idx>& entry_points,
         lib::Timer& timer
     ) {
-        auto range = threads::StaticPartition{indices};
-
         update_type updates{threadpool_.size()};
         auto main = timer.push_back("main");
-        threads::run(threadpool_, range, [&](const auto& local_indices, uint64_t tid) {
+        // With work stealing, this may be invoked multiple times for each thread.
+        auto generate = [&](const auto& local_indices, uint64_t tid) {
             // Thread local variables
             auto& thread_local_updates = updates.at(tid);
             auto distance_function = data_.self_distance(distance_function_);
             std::vector<Neighbor<Idx>> pool{};
-            search_buffer_type search_buffer{params_.window_size};
+            PruneScratch<Idx> prune_scratch{};
+            // The per-thread search buffers persist across batches so the flat visited
+            // table (if enabled) is only allocated once for the whole construction.
+            auto& search_buffer = search_buffers_.at(tid);
+            search_buffer.reserve_visited(data_.size());
             set_type<Idx> visited{};
             auto tracker = OptionalTracker<Idx>(params_.use_full_search_history);
 
@@ -392,11 +402,17 @@ class VamanaBuilder {
                     distance_function,
                     node_id,
                     lib::as_const_span(pool),
-                    pruned_results
+                    pruned_results,
+                    prune_scratch
                 );
             }
-        });
+        };
 
+        if (params_.work_stealing) {
+            threads::run(threadpool_, threads::StealingPartition{indices}, generate);
+        } else {
+            threads::run(threadpool_, threads::StaticPartition{indices}, generate);
+        }
         main.finish();
 
         // Apply updates.
@@ -446,7 +462,10 @@ class VamanaBuilder {
             [&](auto& buckets, uint64_t SVS_UNUSED(tid)) {
                 // Thread local auxiliary data structures.
                 std::vector<Neighbor<Idx>> candidates{};
+                std::vector<Idx> candidate_ids{};
+                std::vector<float> candidate_distances{};
                 std::vector<Idx> pruned_results{};
+                PruneScratch<Idx> prune_scratch{};
                 auto distance_function = data_.self_distance(distance_function_);
                 auto cmp = distance::comparator(distance_function);
                 for (auto& bucket : buckets) {
@@ -457,30 +476,34 @@ class VamanaBuilder {
                         const auto& src_data = data_.get_datum(src, data::full_access);
                         distance::maybe_fix_argument(distance_function, src_data);
 
-                        // Helper lambda to make distance computations look a little
-                        // cleaner.
-                        auto make_neighbor = [&](auto i) {
-                            return Neighbor<Idx>{
-                                i,
-                                distance::compute(
-                                    distance_function,
-                                    src_data,
-                                    data_.get_datum(i, data::full_access)
-                                )};
-                        };
-
-                        candidates.clear();
+                        candidate_ids.clear();
                         // Add the overflow candidates.
                         for (auto n : neighbors) {
-                            candidates.push_back(make_neighbor(n));
+                            candidate_ids.push_back(n);
                         }
 
                         // Add the old adjacency list.
                         for (auto n : graph_.get_node(src)) {
                             if (!neighbors.contains(n)) {
-                                candidates.push_back(make_neighbor(n));
+                                candidate_ids.push_back(n);
                             }
                         }
+
+                        candidate_distances.resize(candidate_ids.size());
+                        distance::compute_gathered(
+                            distance_function,
+                            src_data,
+                            data_,
+                            std::span<const Idx>(candidate_ids),
+                            std::span<float>(candidate_distances),
+                            data::full_access
+                        );
+                        candidates.clear();
+                        for (size_t i = 0, imax = candidate_ids.size(); i < imax; ++i) {
+                            candidates.push_back(
+                                {candidate_ids[i], candidate_distances[i]}
+                            );
+                        }
                         std::sort(candidates.begin(), candidates.end(), cmp);
                         candidates.resize(
                             std::min(candidates.size(), params_.max_candidate_pool_size)
@@ -493,7 +516,8 @@ class VamanaBuilder {
                             distance_function,
                             src,
                             lib::as_const_span(candidates),
-                            pruned_results
+                            pruned_results,
+                            prune_scratch
                         );
                         graph_.replace_node(src, pruned_results);
                     }
@@ -517,5 +541,7 @@ class VamanaBuilder {
     std::vector<SpinLock> vertex_locks_;
     /// Overflow backedge buffer.
     BackedgeBuffer<Idx> backedge_buffer_;
+    /// Per-thread search buffers with the visited set enabled.
+    threads::SequentialTLS<search_buffer_type> search_buffers_;
 };
 } // namespace svs::index::vamana
@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+#include "svs/lib/prefetch.h"
+#include "svs/lib/threads/threadlocal.h"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Flat visited set for graph search with constant time clearing.
+///
+/// @tparam Idx The integer type used to identify vertices.
+/// @tparam Stamp The integer type used to encode the generation of each slot.
+///
+/// Each vertex owns a single ``Stamp`` sized slot in a dense table. A vertex is
+/// considered visited if its slot holds the current generation. Clearing the set
+/// increments the generation, so the full table is only reset when the generation counter
+/// wraps around (once every ``std::numeric_limits<Stamp>::max()`` clears).
+///
+/// The table grows on demand to cover the largest vertex ID inserted so far. Use
+/// ``reserve`` to size the table ahead of time for a known number of vertices.
+///
+/// Provides the ``contains``/``insert``/``clear`` subset of the ``std::unordered_set``
+/// API used by the search buffers.
+///
+template <std::unsigned_integral Idx, std::unsigned_integral Stamp = uint16_t>
+class GenerationTable {
+  public:
+    using stamp_type = Stamp;
+    using allocator_type = threads::CacheAlignedAllocator<Stamp>;
+    using vector_type = std::vector<Stamp, allocator_type>;
+
+    ///
+    /// @brief Construct an empty table.
+    ///
+    GenerationTable() = default;
+
+    ///
+    /// @brief Construct a table with room for ``size`` vertices.
+    ///
+    explicit GenerationTable(size_t size)
+        : stamps_(size, Stamp{0}) {}
+
+    ///
+    /// @brief Return a new empty table with the same number of slots.
+    ///
+    GenerationTable shallow_copy() const { return GenerationTable(size()); }
+
+    ///
+    /// @brief Return the number of vertices covered by the table without reallocation.
+    ///
+    size_t size() const { return stamps_.size(); }
+
+    ///
+    /// @brief Ensure the table has room for at least ``size`` vertices.
+    ///
+    void reserve(size_t size) {
+        if (size > stamps_.size()) {
+            stamps_.resize(size, Stamp{0});
+        }
+    }
+
+    ///
+    /// @brief Return ``true`` if vertex ``i`` has been inserted since the last clear.
+    ///
+    bool contains(Idx i) const {
+        return static_cast<size_t>(i) < stamps_.size() && stamps_[i] == generation_;
+    }
+
+    ///
+    /// @brief Mark vertex ``i`` as visited.
+    ///
+    void insert(Idx i) {
+        auto j = static_cast<size_t>(i);
+        if (j >= stamps_.size()) [[unlikely]] {
+            grow(j);
+        }
+        stamps_[j] = generation_;
+    }
+
+    ///
+    /// @brief Insert vertex ``i`` and return whether it was **not** previously present.
+    ///
+    bool emplace(Idx i) {
+        if (contains(i)) {
+            return false;
+        }
+        insert(i);
+        return true;
+    }
+
+    ///
+    /// @brief Bring the slot for vertex ``i`` into L1 cache ahead of a query.
+    ///
+    void prefetch(Idx i) const {
+        if (static_cast<size_t>(i) < stamps_.size()) {
+            lib::prefetch_l0(stamps_.data() + i);
+        }
+    }
+
+    ///
+    /// @brief Remove all vertices from the table.
+    ///
+    /// Amortized constant time.
+    ///
+    void clear() {
+        ++generation_;
+        // On wrap-around, old stamps could alias the new generation. Reset the whole table
+        // and skip the reserved "never visited" value of zero.
+        if (generation_ == Stamp{0}) [[unlikely]] {
+            std::fill(stamps_.begin(), stamps_.end(), Stamp{0});
+            generation_ = Stamp{1};
+        }
+    }
+
+  private:
+    void grow(size_t i) {
+        // Grow geometrically to amortize the cost of vertices being discovered in
+        // increasing order.
+        stamps_.resize(std::max(i + 1, 2 * stamps_.size()), Stamp{0});
+    }
+
+    // Members
+    vector_type stamps_{};
+    Stamp generation_{1};
+};
+
+} // namespace svs::index::vamana
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace svs::lib {
+
+///
+/// @brief A dynamically sized set of bits.
+///
+/// Stores one bit per element, making it a compact representation of a subset of the
+/// integers ``[0, size())``. Bitsets can be used directly as predicates. For example, to
+/// restrict searches to a subset of a dataset.
+///
+class Bitset {
+  public:
+    using word_type = uint64_t;
+    static constexpr size_t bits_per_word = 64;
+
+    ///
+    /// @brief Construct a bitset with ``size`` bits.
+    ///
+    /// @param size The number of bits.
+    /// @param value The initial value of all bits.
+    ///
+    explicit Bitset(size_t size = 0, bool value = false)
+        : size_{size}
+        , words_(num_words(size), value ? ~word_type{0} : word_type{0}) {
+        clear_padding();
+    }
+
+    /// @brief Return the number of bits.
+    size_t size() const { return size_; }
+
+    /// @brief Return the value of bit ``i``. Requires ``i < size()``.
+    bool test(size_t i) const {
+        return (words_[i / bits_per_word] >> (i % bits_per_word)) & word_type{1};
+    }
+
+    /// @brief Return the value of bit ``i``. Throws an ``ANNException`` if out of bounds.
+    bool at(size_t i) const {
+        check_bounds(i);
+        return test(i);
+    }
+
+    /// @brief Set bit ``i`` to ``value``. Throws an ``ANNException`` if out of bounds.
+    void set(size_t i, bool value = true) {
+        check_bounds(i);
+        auto mask = word_type{1} << (i % bits_per_word);
+        auto& word = words_[i / bits_per_word];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    /// @brief Clear bit ``i``. Throws an ``ANNException`` if out of bounds.
+    void reset(size_t i) { set(i, false); }
+
+    /// @brief Set all bits to ``value``.
+    void fill(bool value) {
+        std::fill(words_.begin(), words_.end(), value ? ~word_type{0} : word_type{0});
+        clear_padding();
+    }
+
+    /// @brief Return the number of set bits.
+    size_t count() const {
+        size_t total = 0;
+        for (auto word : words_) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    /// @brief Predicate interface. Return the value of bit ``i``.
+    bool operator()(size_t i) const { return test(i); }
+
+    /// @brief Return the underlying words. Bit ``i`` is bit ``i % 64`` of word ``i / 64``.
+    const std::vector<word_type>& words() const { return words_; }
+
+    friend bool operator==(const Bitset&, const Bitset&) = default;
+
+  private:
+    static size_t num_words(size_t size) {
+        return (size + bits_per_word - 1) / bits_per_word;
+    }
+
+    void check_bounds(size_t i) const {
+        if (i >= size_) {
+            throw ANNEXCEPTION("Index ", i, " is out of bounds for a bitset of size ", size_);
+        }
+    }
+
+    // Keep the unused bits of the last word cleared so ``count`` and ``==`` are exact.
+    void clear_padding() {
+        size_t used = size_ % bits_per_word;
+        if (used != 0) {
+            words_.back() &= (word_type{1} << used) - 1;
+        }
+    }
+
+    size_t size_;
+    std::vector<word_type> words_;
+};
+
+} // namespace svs::lib
@@ -14,6 +14,17 @@
 // Mark functions as "noinline"
 #define SVS_NOINLINE [[gnu::noinline]]
 
+// Compile a function for a specific instruction set, independent of the global `-march`
+// flags. Used to provide runtime dispatched kernels. See "svs/core/distance/dispatch.h".
+//
+// The AVX512F level includes the BW, DQ and VL extensions required by the masked loads
+// and conversions used throughout the library.
+#define SVS_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define SVS_TARGET_AVX512F \
+    __attribute__((target("avx2,fma,f16c,avx512f,avx512bw,avx512dq,avx512vl")))
+#define SVS_TARGET_AVX512VNNI \
+    __attribute__((target("avx2,fma,f16c,avx512f,avx512bw,avx512dq,avx512vl,avx512vnni")))
+
 // Selectively apply the `[[gnu::noinline]]` attribute.
 #if defined(NDEBUG) && defined(__clang__)
 #define CLANG_NDEBUG_NOINLINE SVS_NOINLINE
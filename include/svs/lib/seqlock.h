@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/spinlock.h"
+
+// stl
+#include <atomic>
+#include <cstdint>
+
+namespace svs {
+
+///
+/// Sequence lock allowing any number of optimistic readers to run alongside a single
+/// writer.
+///
+/// Writers use the "Lockable" interface and are mutually exclusive. While a writer holds
+/// the lock, the sequence number is odd.
+///
+/// Readers never block writers. Instead, a reader records the sequence number with
+/// ``read_begin()``, copies the protected data, and then calls ``read_retry()``. If the
+/// latter returns ``true``, a writer was active during the copy and the copy must be
+/// discarded and retried.
+///
+/// Readers must only ever copy out of the protected region and must not act on the
+/// copied values until ``read_retry()`` returns ``false``.
+///
+class SeqLock {
+  public:
+    SeqLock() = default;
+
+    ///
+    /// Attempts to acquire the write lock without blocking.
+    /// Return `true` if the lock was acquired, `false` otherwise.
+    ///
+    bool try_lock() noexcept {
+        uint32_t expected = sequence_.load(std::memory_order_relaxed);
+        if ((expected & 1) != 0) {
+            return false;
+        }
+        bool acquired = sequence_.compare_exchange_strong(
+            expected, expected + 1, std::memory_order_acquire, std::memory_order_relaxed
+        );
+        // Keep the writes to the protected data from being reordered before the sequence
+        // number becomes odd.
+        std::atomic_thread_fence(std::memory_order_release);
+        return acquired;
+    }
+
+    ///
+    /// Blocks until the write lock is acquired.
+    ///
+    void lock() {
+        while (!try_lock()) {
+            detail::pause();
+        }
+    }
+
+    ///
+    /// Releases the write lock and publishes all writes made while holding it.
+    ///
+    void unlock() noexcept { sequence_.fetch_add(1, std::memory_order_release); }
+
+    ///
+    /// Return `true` if the write lock is held by some execution agent.
+    ///
+    bool islocked() const noexcept {
+        return (sequence_.load(std::memory_order_acquire) & 1) != 0;
+    }
+
+    ///
+    /// Begin an optimistic read, spinning while a writer is active.
+    /// Return the sequence number to pass to ``read_retry()``.
+    ///
+    uint32_t read_begin() const noexcept {
+        uint32_t sequence = sequence_.load(std::memory_order_acquire);
+        while ((sequence & 1) != 0) {
+            detail::pause();
+            sequence = sequence_.load(std::memory_order_acquire);
+        }
+        return sequence;
+    }
+
+    ///
+    /// Return `true` if a writer intervened since ``read_begin()`` returned ``sequence``.
+    ///
+    bool read_retry(uint32_t sequence) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) != sequence;
+    }
+
+  private:
+    std::atomic<uint32_t> sequence_{0};
+};
+
+} // namespace svs
@@ -14,10 +14,12 @@
 #include "svs/lib/exception.h"
 #include "svs/lib/misc.h"
 #include "svs/lib/numa.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/spinlock.h"
 #include "svs/lib/threads/thunks.h"
 #include "svs/third-party/fmt.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
@@ -47,6 +49,77 @@ class ThreadCrashedError : public std::runtime_error {
 constexpr size_t default_spintime() { return 1'000'000; }
 constexpr size_t short_spintime() { return 1'000; }
 
+///
+/// @brief Control how long an idle worker spins before going to sleep.
+///
+/// A fixed policy always spins for the same number of iterations. An adaptive policy
+/// adjusts the spin count between a minimum and maximum based on how long the worker ends
+/// up sleeping:
+///
+/// * If new work arrives shortly after the worker falls asleep (sooner than the time it
+///   already spent spinning), a longer spin would have avoided the wake-up latency, so
+///   the spin count is doubled.
+/// * Otherwise, the idle period was long and the spin was wasted, so the spin count is
+///   halved.
+///
+/// Bursty workloads thus keep spinning between closely spaced jobs while idle workers
+/// quickly stop burning cycles.
+///
+class SpinPolicy {
+  public:
+    /// @brief Construct a fixed policy spinning for ``spin_count`` iterations.
+    explicit constexpr SpinPolicy(size_t spin_count)
+        : SpinPolicy(spin_count, spin_count) {}
+
+    ///
+    /// @brief Construct an adaptive policy.
+    ///
+    /// The spin count starts at ``max_spin_count``.
+    ///
+    constexpr SpinPolicy(size_t min_spin_count, size_t max_spin_count)
+        : min_spin_count_{std::max(std::min(min_spin_count, max_spin_count), size_t{1})}
+        , max_spin_count_{std::max(max_spin_count, size_t{1})}
+        , spin_count_{max_spin_count_} {}
+
+    /// @brief Return the default adaptive policy.
+    static constexpr SpinPolicy adaptive(
+        size_t min_spin_count = short_spintime(), size_t max_spin_count = default_spintime()
+    ) {
+        return SpinPolicy(min_spin_count, max_spin_count);
+    }
+
+    /// @brief Return the number of iterations to spin for the next wait.
+    constexpr size_t spin_count() const { return spin_count_; }
+    constexpr size_t min_spin_count() const { return min_spin_count_; }
+    constexpr size_t max_spin_count() const { return max_spin_count_; }
+    constexpr bool is_adaptive() const { return min_spin_count_ != max_spin_count_; }
+
+    ///
+    /// @brief Update the spin count after a wait that ended in sleep.
+    ///
+    /// @param spin_time The time spent spinning before going to sleep.
+    /// @param sleep_time The time spent asleep.
+    ///
+    constexpr void
+    update(std::chrono::nanoseconds spin_time, std::chrono::nanoseconds sleep_time) {
+        if (sleep_time < spin_time) {
+            spin_count_ = std::min(2 * spin_count_, max_spin_count_);
+        } else {
+            spin_count_ = std::max(spin_count_ / 2, min_spin_count_);
+        }
+    }
+
+  private:
+    size_t min_spin_count_;
+    size_t max_spin_count_;
+    size_t spin_count_;
+};
+
+///
+/// @brief The spin policy used by default constructed threads and thread pools.
+///
+constexpr SpinPolicy default_spin_policy() { return SpinPolicy::adaptive(); }
+
 // ThreadState is used to communicate information between the worker thread and the
 // controlling context.
 //
@@ -191,6 +264,12 @@ class NoTelemetry {
     void enter_spinloop() {}
     void exit_spinloop_success() {}
     void exit_spinloop_fail() {}
+
+    // Timing
+    void spin_time(std::chrono::nanoseconds SVS_UNUSED(time), bool SVS_UNUSED(timeout)) {}
+    void sleep_time(std::chrono::nanoseconds SVS_UNUSED(time)) {}
+    void wake_requested() {}
+    void woke_up() {}
 };
 
 // Make a struct to explicitly be able to inspect the fields.
@@ -208,6 +287,12 @@ struct ActionTelemetry {
     void exit_spinloop_success() { spin_success_++; }
     void exit_spinloop_fail() { spin_fail_++; }
 
+    // Timing
+    void spin_time(std::chrono::nanoseconds SVS_UNUSED(time), bool SVS_UNUSED(timeout)) {}
+    void sleep_time(std::chrono::nanoseconds SVS_UNUSED(time)) {}
+    void wake_requested() {}
+    void woke_up() {}
+
     ///// Members
     size_t sleep_attempts_{0};
     size_t sleep_predicate_checks_{0};
@@ -217,6 +302,145 @@ struct ActionTelemetry {
     size_t spin_success_{0};
     size_t spin_fail_{0};
 };
+
+///
+/// @brief Aggregated statistics on how idle workers waited for work.
+///
+struct WaitStatistics {
+    /// The number of waits where work arrived while spinning.
+    size_t spin_success = 0;
+    /// The number of waits where the worker timed out while spinning.
+    size_t spin_fail = 0;
+    /// The number of times the worker went to sleep.
+    size_t sleeps = 0;
+    /// Total time spent spinning, including spins that ended in sleep.
+    std::chrono::nanoseconds spin_time{0};
+    /// Total time spent spinning before going to sleep. These cycles were wasted.
+    std::chrono::nanoseconds wasted_spin_time{0};
+    /// Total time spent asleep.
+    std::chrono::nanoseconds sleep_time{0};
+    /// Total time between a controller waking a sleeping worker and the worker resuming.
+    std::chrono::nanoseconds wakeup_latency{0};
+
+    /// @brief Return the mean wake-up latency of sleeping workers.
+    std::chrono::nanoseconds mean_wakeup_latency() const {
+        return sleeps == 0 ? std::chrono::nanoseconds{0}
+                           : wakeup_latency / static_cast<int64_t>(sleeps);
+    }
+
+    WaitStatistics& operator+=(const WaitStatistics& other) {
+        spin_success += other.spin_success;
+        spin_fail += other.spin_fail;
+        sleeps += other.sleeps;
+        spin_time += other.spin_time;
+        wasted_spin_time += other.wasted_spin_time;
+        sleep_time += other.sleep_time;
+        wakeup_latency += other.wakeup_latency;
+        return *this;
+    }
+};
+
+///
+/// @brief Low-overhead telemetry recording ``WaitStatistics``.
+///
+/// Counters are only written by the worker thread and may be read concurrently by the
+/// controlling thread.
+///
+class WaitTelemetry {
+  public:
+    WaitTelemetry() = default;
+
+    // Sleeping
+    void sleep_attempt() {}
+    void sleep_predicate_check() {}
+    void sleep_success() { increment(sleeps_, 1); }
+    void sleep_fail() {}
+
+    // Spinning
+    void enter_spinloop() {}
+    void exit_spinloop_success() { increment(spin_success_, 1); }
+    void exit_spinloop_fail() { increment(spin_fail_, 1); }
+
+    // Timing
+    void spin_time(std::chrono::nanoseconds time, bool timeout) {
+        increment(spin_ns_, time.count());
+        if (timeout) {
+            increment(wasted_spin_ns_, time.count());
+        }
+    }
+    void sleep_time(std::chrono::nanoseconds time) { increment(sleep_ns_, time.count()); }
+
+    // Called by the controller before waking a sleeping worker.
+    void wake_requested() {
+        wake_request_ns_.store(now(), std::memory_order_relaxed);
+    }
+    // Called by the worker after being woken.
+    void woke_up() {
+        auto requested = wake_request_ns_.load(std::memory_order_relaxed);
+        increment(wakeup_ns_, std::max<int64_t>(now() - requested, 0));
+    }
+
+    /// @brief Return a snapshot of the recorded statistics.
+    WaitStatistics statistics() const {
+        using ns = std::chrono::nanoseconds;
+        return WaitStatistics{
+            .spin_success = count(spin_success_),
+            .spin_fail = count(spin_fail_),
+            .sleeps = count(sleeps_),
+            .spin_time = ns{load(spin_ns_)},
+            .wasted_spin_time = ns{load(wasted_spin_ns_)},
+            .sleep_time = ns{load(sleep_ns_)},
+            .wakeup_latency = ns{load(wakeup_ns_)}};
+    }
+
+    ///
+    /// @brief Reset all counters to zero.
+    ///
+    /// Not synchronized with the worker: counts from waits in progress may be lost.
+    ///
+    void reset() {
+        for (auto* counter :
+             {&spin_success_,
+              &spin_fail_,
+              &sleeps_,
+              &spin_ns_,
+              &wasted_spin_ns_,
+              &sleep_ns_,
+              &wakeup_ns_}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()
+        )
+            .count();
+    }
+
+    // Single writer: a relaxed load and store is sufficient.
+    static void increment(std::atomic<int64_t>& counter, int64_t value) {
+        counter.store(
+            counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed
+        );
+    }
+    static int64_t load(const std::atomic<int64_t>& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+    static size_t count(const std::atomic<int64_t>& counter) {
+        return static_cast<size_t>(load(counter));
+    }
+
+    std::atomic<int64_t> spin_success_{0};
+    std::atomic<int64_t> spin_fail_{0};
+    std::atomic<int64_t> sleeps_{0};
+    std::atomic<int64_t> spin_ns_{0};
+    std::atomic<int64_t> wasted_spin_ns_{0};
+    std::atomic<int64_t> sleep_ns_{0};
+    std::atomic<int64_t> wakeup_ns_{0};
+    std::atomic<int64_t> wake_request_ns_{0};
+};
 } // namespace telemetry
 
 ///
@@ -472,6 +696,13 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
         return telemetry_;
     }
 
+    /// @copydoc get_telemetry() const
+    Telemetry& get_telemetry()
+        requires(!std::is_same_v<Telemetry, telemetry::NoTelemetry>)
+    {
+        return telemetry_;
+    }
+
     /////
     ///// Control Side API
     /////
@@ -497,6 +728,11 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
     // - Worker thread must not be in the `Working` state.
     void notify_thread(ThreadState current, ThreadState next = ThreadState::Working) {
         for (;;) {
+            // Only wake-ups of sleeping workers are timed. Record the request before the
+            // worker can observe the state change.
+            if (current == ThreadState::Sleeping) {
+                telemetry_.wake_requested();
+            }
             bool success = cas_state(current, next);
 
             // Rollback successful CAS in case something went wrong.
@@ -563,6 +799,9 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
         bool shutdown_requested = false;
         for (;;) {
             bool exit_loop = false;
+            if (current == ThreadState::Sleeping) {
+                telemetry_.wake_requested();
+            }
             bool success = cas_state(current, ThreadState::RequestShutdown);
             auto rollback = [&, success, current]() {
                 if (success) {
@@ -690,18 +929,24 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
     /// - Control block must be set to `boot_state`.
     ///
     /// @param promise The promise where thread shutdown and exceptions will live.
-    /// @param spin_count The number of times to spin before attempting to sleep. A higher
-    ///     count will increase the probability of new work being assigned while the thread
-    ///     is spinning, at the cost of higher CPU utilization burned in idle cycles.
+    /// @param policy Determines the number of times to spin before attempting to sleep. A
+    ///     higher count will increase the probability of new work being assigned while the
+    ///     thread is spinning, at the cost of higher CPU utilization burned in idle cycles.
     /// @param startup Optional thunk to set up global state for the thread that will be
     ///     held until the thread is shutdown.
     ///
     template <typename F = DefaultStartup>
     void unsafe_run(
         std::promise<void> promise,
-        size_t spin_count = default_spintime(),
+        SpinPolicy policy = default_spin_policy(),
         F&& startup = DefaultStartup()
     ) {
+        using clock = std::chrono::steady_clock;
+        // Only read the clock if someone is going to use the result.
+        const bool timed =
+            policy.is_adaptive() || !std::is_same_v<Telemetry, telemetry::NoTelemetry>;
+        auto now = [timed]() { return timed ? clock::now() : clock::time_point{}; };
+
         // This variable is meant for RAII purposes and just supposed to hand-on to
         // something until the thread terminates.
         [[maybe_unused]] auto resource = startup();
@@ -709,9 +954,18 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
         for (;;) {
             // Spin until new work is available or we time out.
             // If we time-out, try to sleep.
-            ThreadState request = spin_wait(spin_count);
-            if (request == ThreadState::Spinning) {
-                try_sleep();
+            auto spin_start = now();
+            ThreadState request = spin_wait(policy.spin_count());
+            bool timeout = (request == ThreadState::Spinning);
+            auto spin_stop = now();
+            telemetry_.spin_time(spin_stop - spin_start, timeout);
+            if (timeout) {
+                if (try_sleep()) {
+                    auto sleep_stop = now();
+                    telemetry_.woke_up();
+                    telemetry_.sleep_time(sleep_stop - spin_stop);
+                    policy.update(spin_stop - spin_start, sleep_stop - spin_stop);
+                }
                 request = get_state(std::memory_order_acquire);
             }
 
@@ -750,6 +1004,14 @@ template <typename Telemetry = telemetry::NoTelemetry> class ThreadControlBlock
         }
     }
 
+    ///
+    /// Startup a thread with a fixed spin count.
+    ///
+    template <typename F = DefaultStartup>
+    void unsafe_run(std::promise<void> promise, size_t spin_count, F&& startup = {}) {
+        unsafe_run(std::move(promise), SpinPolicy(spin_count), std::forward<F>(startup));
+    }
+
   private:
     std::atomic<ThreadState> threadstate_{boot_state()};
     ThreadFunctionRef fn_{};
@@ -784,7 +1046,7 @@ template <typename T = telemetry::NoTelemetry> class ThreadImpl {
   public:
     template <typename F = DefaultStartup>
     explicit ThreadImpl(
-        size_t spin_count = default_spintime(), F startup = DefaultStartup()
+        SpinPolicy policy = default_spin_policy(), F startup = DefaultStartup()
     )
         : control_{std::make_unique<ThreadControlBlock<T>>()} {
         std::promise<void> promise{};
@@ -797,9 +1059,9 @@ template <typename T = telemetry::NoTelemetry> class ThreadImpl {
         // eachother's duration.
         control_->set_state(boot_state());
         auto f = [&control_local = *control_,
-                  spin_count,
+                  policy,
                   inner_startup = std::move(startup)](std::promise<void>&& channel) {
-            control_local.unsafe_run(std::move(channel), spin_count, inner_startup);
+            control_local.unsafe_run(std::move(channel), policy, inner_startup);
         };
 
         // Launch the thread and wait until it reaches far enough in its execution that
@@ -808,6 +1070,13 @@ template <typename T = telemetry::NoTelemetry> class ThreadImpl {
         control_->spin_while(boot_state());
     }
 
+    ///
+    /// Construct a thread that spins for a fixed ``spin_count`` iterations before sleeping.
+    ///
+    template <typename F = DefaultStartup>
+    explicit ThreadImpl(size_t spin_count, F startup = DefaultStartup())
+        : ThreadImpl(SpinPolicy(spin_count), std::move(startup)) {}
+
     ///// Member Functions
 
     // General Queries
@@ -834,6 +1103,23 @@ template <typename T = telemetry::NoTelemetry> class ThreadImpl {
     ///
     void wait() { control_->wait_while_busy(); }
 
+    ///
+    /// Return the telemetry of the worker. Only available if the telemetry type is not
+    /// `svs::threads::telemetry::NoTelemetry`.
+    ///
+    const T& get_telemetry() const
+        requires(!std::is_same_v<T, telemetry::NoTelemetry>)
+    {
+        return control_->get_telemetry();
+    }
+
+    /// @copydoc get_telemetry() const
+    T& get_telemetry()
+        requires(!std::is_same_v<T, telemetry::NoTelemetry>)
+    {
+        return control_->get_telemetry();
+    }
+
     ///
     /// Get a thrown exception from a crashed thread.
     /// **Preconditions:**
@@ -964,7 +1250,13 @@ template <typename T = telemetry::NoTelemetry> class ThreadImpl {
     bool is_initialized() const { return control_ != nullptr; }
 };
 
-using Thread = ThreadImpl<telemetry::NoTelemetry>;
+using Thread = ThreadImpl<>;
+
+///
+/// A thread recording ``telemetry::WaitStatistics``. Recording reads the clock around
+/// every wait, so it is opt-in.
+///
+using TelemetryThread = ThreadImpl<telemetry::WaitTelemetry>;
 
 } // namespace threads
 } // namespace svs
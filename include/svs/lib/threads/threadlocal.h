@@ -19,7 +19,10 @@
 #include <concepts>
 #include <cstddef>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <optional>
 #include <vector>
 
 namespace svs::threads {
@@ -166,4 +169,86 @@ template <typename T> class SequentialTLS {
   private:
     container_type values_;
 };
+
+///
+/// @brief Per-thread scratch space cached by an owner and reused across parallel jobs.
+///
+/// Each job calls ``acquire`` and indexes the returned handle with its thread ID. The
+/// slots start out empty and are populated by the job on first use. The populated slots
+/// persist after the handle is destroyed, so later jobs can reuse them instead of
+/// allocating new scratch space.
+///
+/// Only one handle at a time refers to the cached slots. If the cache is already in use
+/// by a concurrent job, ``acquire`` returns a handle to fresh, temporary slots instead so
+/// concurrent jobs never wait on each other.
+///
+/// Copies of a ``ScratchPool`` start out empty.
+///
+template <typename T> class ScratchPool {
+  public:
+    using value_type = T;
+    using slot_type = std::optional<T>;
+    using container_type = std::vector<Padded<slot_type>>;
+
+    class Handle {
+      public:
+        Handle(ScratchPool& pool, size_t num_threads)
+            : lock_{*pool.mutex_, std::try_to_lock}
+            , slots_{lock_.owns_lock() ? &pool.slots_ : &temporary_} {
+            if (slots_->size() < num_threads) {
+                slots_->resize(num_threads);
+            }
+        }
+
+        // The handle may point to its own slots.
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle(Handle&&) = delete;
+        Handle& operator=(Handle&&) = delete;
+        ~Handle() = default;
+
+        /// @brief Return whether this handle refers to the cached slots.
+        bool cached() const { return lock_.owns_lock(); }
+
+        /// @brief Return the scratch slot for thread ``tid``.
+        slot_type& operator[](size_t tid) { return (*slots_)[tid].unwrap(); }
+        slot_type& at(size_t tid) { return slots_->at(tid).unwrap(); }
+        size_t size() const { return slots_->size(); }
+
+      private:
+        std::unique_lock<std::mutex> lock_;
+        container_type temporary_{};
+        container_type* slots_;
+    };
+
+    ScratchPool() = default;
+    ScratchPool(const ScratchPool& /*other*/)
+        : ScratchPool() {}
+    ScratchPool& operator=(const ScratchPool& other) {
+        if (this != &other) {
+            clear();
+        }
+        return *this;
+    }
+    ScratchPool(ScratchPool&&) = default;
+    ScratchPool& operator=(ScratchPool&&) = default;
+    ~ScratchPool() = default;
+
+    ///
+    /// @brief Return a handle to at least ``num_threads`` scratch slots.
+    ///
+    Handle acquire(size_t num_threads) { return Handle{*this, num_threads}; }
+
+    ///
+    /// @brief Release all cached scratch space.
+    ///
+    /// Must not be called while a job is using the cached slots.
+    ///
+    void clear() { slots_.clear(); }
+
+  private:
+    // Make a unique-ptr to allow the pool to be moved.
+    std::unique_ptr<std::mutex> mutex_{std::make_unique<std::mutex>()};
+    container_type slots_{};
+};
 } // namespace svs::threads
@@ -15,12 +15,18 @@
 #include <algorithm>
 #include <atomic>
 #include <concepts>
+#include <condition_variable>
 #include <cstdint>
 #include <mutex>
+#include <optional>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "svs/lib/exception.h"
 #include "svs/lib/numa.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/threads/thread.h"
 #include "svs/lib/threads/thunks.h"
 #include "svs/lib/threads/types.h"
@@ -83,18 +89,25 @@ class SequentialThreadPool {
 static_assert(ThreadPool<SequentialThreadPool>);
 
 ///
-/// Construct a Thread with a specified spin time.
+/// Construct a thread of type ``T`` with a specified spin policy.
 ///
-class DefaultBuilder {
+template <typename T> class BasicBuilder {
   private:
-    uint64_t spin_time_;
+    SpinPolicy policy_;
 
   public:
-    explicit DefaultBuilder(uint64_t spin_time = default_spintime())
-        : spin_time_{spin_time} {}
-    Thread build(uint64_t /*tid*/) const { return Thread{spin_time_}; }
+    explicit BasicBuilder(SpinPolicy policy = default_spin_policy())
+        : policy_{policy} {}
+    /// Use a fixed spin time.
+    explicit BasicBuilder(uint64_t spin_time)
+        : policy_{spin_time} {}
+    T build(uint64_t /*tid*/) const { return T{policy_}; }
 };
 
+using DefaultBuilder = BasicBuilder<Thread>;
+/// Construct threads that record wait statistics.
+using TelemetryBuilder = BasicBuilder<TelemetryThread>;
+
 #if defined(SVS_ENABLE_NUMA)
 ///
 /// Construct main threads for each socket of a multi-socket system.
@@ -120,9 +133,12 @@ class InterNUMABuilder {
 #endif
 
 template <typename Builder> class NativeThreadPoolBase {
+  public:
+    using thread_type = decltype(std::declval<const Builder&>().build(0));
+
   private:
     Builder builder_;
-    std::vector<Thread> threads_{};
+    std::vector<thread_type> threads_{};
     // Make a unique-ptr to allow the thread pool to be moved.
     // Mutexes cannot be moved or copied.
     std::unique_ptr<std::mutex> use_mutex_{std::make_unique<std::mutex>()};
@@ -153,6 +169,36 @@ template <typename Builder> class NativeThreadPoolBase {
         }
     }
 
+    ///
+    /// @brief Return the wait statistics accumulated over all worker threads.
+    ///
+    /// Reports how often idle workers received new work while spinning versus after going
+    /// to sleep, the time spent in each state and the latency of waking sleeping workers.
+    /// Only available for pools of ``TelemetryThread``.
+    ///
+    telemetry::WaitStatistics wait_statistics() const
+        requires std::is_same_v<thread_type, TelemetryThread>
+    {
+        std::lock_guard lock{*use_mutex_};
+        auto statistics = telemetry::WaitStatistics{};
+        for (const auto& thread : threads_) {
+            statistics += thread.get_telemetry().statistics();
+        }
+        return statistics;
+    }
+
+    ///
+    /// @brief Reset the wait statistics of all worker threads.
+    ///
+    void reset_wait_statistics()
+        requires std::is_same_v<thread_type, TelemetryThread>
+    {
+        std::lock_guard lock{*use_mutex_};
+        for (auto& thread : threads_) {
+            thread.get_telemetry().reset();
+        }
+    }
+
     void run(FunctionType& f) {
         std::lock_guard lock{*use_mutex_};
         for (size_t i = 0; i < threads_.size(); ++i) {
@@ -205,6 +251,147 @@ using NativeThreadPool = NativeThreadPoolBase<DefaultBuilder>;
 // Ensure that we satisfy the requirements for a threadpool.
 static_assert(ResizeableThreadPool<NativeThreadPool>);
 
+/// A thread pool whose workers record wait statistics.
+using TelemetryThreadPool = NativeThreadPoolBase<TelemetryBuilder>;
+
+///
+/// @brief Divide a fixed budget of threads between concurrent users.
+///
+/// A ``NativeThreadPoolBase`` serializes calls to ``run`` because each worker can only
+/// execute one job at a time. This class splits the thread budget into independent
+/// partitions so several callers can run parallel jobs at the same time.
+///
+/// Callers gain exclusive use of a partition through ``acquire``, which returns a
+/// ``Lease`` satisfying the ``ThreadPool`` concept. The calling thread participates in
+/// jobs run through the lease as thread 0, so each partition of ``n`` threads only owns
+/// ``n - 1`` workers.
+///
+template <typename Builder> class PartitionedThreadPoolBase {
+  public:
+    using pool_type = NativeThreadPoolBase<Builder>;
+
+    ///
+    /// @brief Exclusive use of one partition. The partition is released on destruction.
+    ///
+    class Lease {
+      public:
+        Lease(PartitionedThreadPoolBase& parent, size_t partition)
+            : parent_{&parent}
+            , partition_{partition} {}
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept
+            : parent_{std::exchange(other.parent_, nullptr)}
+            , partition_{other.partition_} {}
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                parent_ = std::exchange(other.parent_, nullptr);
+                partition_ = other.partition_;
+            }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        /// @brief Return the index of the leased partition.
+        size_t partition() const { return partition_; }
+
+        size_t size() const { return parent_->pools_[partition_].size(); }
+        void run(FunctionType& f) { parent_->pools_[partition_].run(f); }
+
+      private:
+        void release() {
+            if (parent_ != nullptr) {
+                parent_->release(partition_);
+                parent_ = nullptr;
+            }
+        }
+
+        PartitionedThreadPoolBase* parent_;
+        size_t partition_;
+    };
+
+    ///
+    /// @brief Split ``num_threads`` threads into ``num_partitions`` partitions.
+    ///
+    /// The threads are divided as evenly as possible. Each partition receives at least
+    /// one thread. Any trailing arguments are used to construct the thread builder of
+    /// each partition.
+    ///
+    template <typename... Args>
+    PartitionedThreadPoolBase(size_t num_threads, size_t num_partitions, Args&&... args) {
+        if (num_partitions == 0) {
+            throw ANNEXCEPTION("Cannot create a thread pool without partitions!");
+        }
+        num_threads = std::max(num_threads, num_partitions);
+        pools_.reserve(num_partitions);
+        for (size_t i = 0; i < num_partitions; ++i) {
+            pools_.emplace_back(balance(num_threads, num_partitions, i).size(), args...);
+            free_.push_back(i);
+        }
+    }
+
+    // The leases refer back to the parent.
+    PartitionedThreadPoolBase(const PartitionedThreadPoolBase&) = delete;
+    PartitionedThreadPoolBase& operator=(const PartitionedThreadPoolBase&) = delete;
+
+    /// @brief Return the number of partitions.
+    size_t num_partitions() const { return pools_.size(); }
+
+    /// @brief Return the total number of threads over all partitions.
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& pool : pools_) {
+            total += pool.size();
+        }
+        return total;
+    }
+
+    ///
+    /// @brief Return exclusive use of a partition, blocking until one is available.
+    ///
+    Lease acquire() {
+        std::unique_lock lock{mutex_};
+        available_.wait(lock, [&]() { return !free_.empty(); });
+        return take(lock);
+    }
+
+    ///
+    /// @brief Return exclusive use of a partition if one is immediately available.
+    ///
+    std::optional<Lease> try_acquire() {
+        std::unique_lock lock{mutex_};
+        if (free_.empty()) {
+            return std::nullopt;
+        }
+        return take(lock);
+    }
+
+  private:
+    Lease take(std::unique_lock<std::mutex>& SVS_UNUSED(lock)) {
+        size_t partition = free_.back();
+        free_.pop_back();
+        return Lease{*this, partition};
+    }
+
+    void release(size_t partition) {
+        {
+            std::lock_guard lock{mutex_};
+            free_.push_back(partition);
+        }
+        available_.notify_one();
+    }
+
+    std::vector<pool_type> pools_{};
+    std::vector<size_t> free_{};
+    std::mutex mutex_{};
+    std::condition_variable available_{};
+};
+
+using PartitionedThreadPool = PartitionedThreadPoolBase<DefaultBuilder>;
+static_assert(ThreadPool<PartitionedThreadPool::Lease>);
+
 #if defined(SVS_ENABLE_NUMA)
 /////
 ///// Numa Stuff
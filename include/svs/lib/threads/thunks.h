@@ -12,14 +12,17 @@
 #pragma once
 
 // stdlib
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 // local
 #include "svs/lib/misc.h"
+#include "svs/lib/spinlock.h"
 #include "svs/lib/threads/types.h"
 
 namespace svs {
@@ -102,6 +105,115 @@ template <typename F, typename I> struct Thunk<F, DynamicPartition<I>> {
     }
 };
 
+namespace detail {
+
+// The share of the iteration space owned by one thread in a ``StealingPartition``.
+//
+// The owner takes chunks from the front while thieves take the back half.
+// The bounds are atomic so thieves can estimate the remaining work without locking.
+// All modifications happen with the lock held.
+class alignas(64) StealableRange {
+  public:
+    StealableRange() = default;
+
+    void reset(size_t start, size_t stop) {
+        std::lock_guard lock{lock_};
+        start_.store(start, std::memory_order_relaxed);
+        stop_.store(stop, std::memory_order_relaxed);
+    }
+
+    // Approximate number of remaining elements.
+    size_t remaining() const {
+        auto start = start_.load(std::memory_order_relaxed);
+        auto stop = stop_.load(std::memory_order_relaxed);
+        return stop > start ? stop - start : 0;
+    }
+
+    // Take a chunk from the front. The chunk size is a fraction of the remaining work so
+    // early chunks amortize scheduling overhead while later chunks keep the tail
+    // balanced.
+    UnitRange<size_t> take_front(size_t grainsize) {
+        std::lock_guard lock{lock_};
+        auto start = start_.load(std::memory_order_relaxed);
+        auto stop = stop_.load(std::memory_order_relaxed);
+        auto chunk = std::min(std::max((stop - start) / 4, grainsize), stop - start);
+        start_.store(start + chunk, std::memory_order_relaxed);
+        return UnitRange<size_t>{start, start + chunk};
+    }
+
+    // Take the back half of the remaining work.
+    UnitRange<size_t> take_back(size_t grainsize) {
+        std::lock_guard lock{lock_};
+        auto start = start_.load(std::memory_order_relaxed);
+        auto stop = stop_.load(std::memory_order_relaxed);
+        auto chunk = std::min(std::max((stop - start) / 2, grainsize), stop - start);
+        stop_.store(stop - chunk, std::memory_order_relaxed);
+        return UnitRange<size_t>{stop - chunk, stop};
+    }
+
+  private:
+    SpinLock lock_{};
+    std::atomic<size_t> start_{0};
+    std::atomic<size_t> stop_{0};
+};
+
+// Steal work for thread ``tid`` from the thread with the most remaining work.
+// Return ``false`` if there is no work left to steal.
+inline bool steal(std::vector<StealableRange>& ranges, size_t tid, size_t grainsize) {
+    for (;;) {
+        size_t victim = tid;
+        size_t most = 0;
+        for (size_t i = 0, imax = ranges.size(); i < imax; ++i) {
+            auto remaining = ranges[i].remaining();
+            if (i != tid && remaining > most) {
+                victim = i;
+                most = remaining;
+            }
+        }
+        if (victim == tid) {
+            return false;
+        }
+
+        // The victim may have drained its range since we looked.
+        auto stolen = ranges[victim].take_back(grainsize);
+        if (!stolen.empty()) {
+            ranges[tid].reset(stolen.start(), stolen.stop());
+            return true;
+        }
+    }
+}
+
+} // namespace detail
+
+// Work stealing partition
+template <typename F, typename I> struct Thunk<F, StealingPartition<I>> {
+    static FunctionType wrap(ThreadCount nthreads, F& f, StealingPartition<I> space) {
+        auto nthr = static_cast<size_t>(nthreads);
+        auto ranges = std::make_shared<std::vector<detail::StealableRange>>(nthr);
+        for (size_t tid = 0; tid < nthr; ++tid) {
+            auto r = balance(space.size(), nthr, tid);
+            (*ranges)[tid].reset(r.start(), r.stop());
+        }
+
+        return [&f, space, ranges](uint64_t tid) {
+            size_t grainsize = std::max(space.grainsize, uint64_t{1});
+            auto& own = (*ranges)[tid];
+            for (;;) {
+                auto r = own.take_front(grainsize);
+                if (r.empty()) {
+                    if (!detail::steal(*ranges, tid, grainsize)) {
+                        return;
+                    }
+                    continue;
+                }
+                auto this_range = IteratorPair{
+                    std::begin(space) + r.start(), std::begin(space) + r.stop()};
+                f(this_range, tid);
+            }
+        };
+    }
+};
+
 // Thunk entry point.
 template <typename F, typename... Args>
 FunctionType wrap(ThreadCount nthreads, F& f, Args&&... args) {
@@ -421,6 +421,71 @@ template <typename /*std::ranges::random_access_range*/ R>
     requires(!std::integral<R>)
 DynamicPartition(const R&, size_t) -> DynamicPartition<typename R::const_iterator>;
 
+///
+/// @brief Work stealing partition of an iteration space.
+///
+/// Each thread starts with an equal contiguous share of the iteration space and processes
+/// it front to back in chunks of decreasing size. Threads that run out of work steal the
+/// back half of the largest remaining share of another thread.
+///
+/// Compared with ``StaticPartition``, this tolerates large variations in the cost of
+/// individual elements. Compared with ``DynamicPartition``, threads mostly work on their
+/// own contiguous share without contending on a single shared counter.
+///
+/// The work function may be invoked multiple times per thread.
+///
+template <PartitionableIterator I> struct StealingPartition : public IteratorPair<I> {
+    using parent_type = IteratorPair<I>;
+
+    ///
+    /// Construct a work stealing partition directly from an iterator pair.
+    ///
+    explicit StealingPartition(parent_type pair, size_t grainsize = 1)
+        : parent_type{std::move(pair)}
+        , grainsize{grainsize} {}
+
+    ///
+    /// Construct a work stealing partition of the sequence of numbers `[0, length)`.
+    ///
+    template <std::integral T>
+    explicit StealingPartition(T length, size_t grainsize = 1)
+        : parent_type{IndexIterator<T>{0}, IndexIterator<T>{length}}
+        , grainsize{grainsize} {}
+
+    ///
+    /// Construct a work stealing partition of the sequence of numbers `[start, stop)`.
+    ///
+    template <std::integral T>
+    StealingPartition(T start, T stop, size_t grainsize)
+        : parent_type{IndexIterator{start}, IndexIterator{stop}}
+        , grainsize{grainsize} {}
+
+    ///
+    /// Construct a work stealing partition of the random access range `range`.
+    ///
+    template <typename /*std::ranges::random_access_range*/ R>
+        requires(!std::integral<R>) // Needed because clang-12 doesn't support ranges.
+    explicit StealingPartition(const R& range, size_t grainsize = 1)
+        : parent_type{std::begin(range), std::end(range)}
+        , grainsize{grainsize} {}
+
+    // Members
+    /// The smallest number of elements processed by one invocation of the work function.
+    uint64_t grainsize;
+};
+
+template <std::integral T>
+StealingPartition(T, size_t) -> StealingPartition<IndexIterator<T>>;
+template <std::integral T> StealingPartition(T) -> StealingPartition<IndexIterator<T>>;
+template <std::integral T>
+StealingPartition(T, T, size_t) -> StealingPartition<IndexIterator<T>>;
+template <typename /*std::ranges::random_access_range*/ R>
+    requires(!std::integral<R>)
+StealingPartition(const R&, size_t) -> StealingPartition<typename R::const_iterator>;
+template <typename /*std::ranges::random_access_range*/ R>
+    requires(!std::integral<R>)
+StealingPartition(const R&) -> StealingPartition<typename R::const_iterator>;
+
 } // namespace threads
 } // namespace svs
 
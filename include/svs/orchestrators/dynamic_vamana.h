@@ -128,6 +128,39 @@ class DynamicVamana
     void enable_visited_set() { impl_->enable_visited_set(); }
     void disable_visited_set() { impl_->disable_visited_set(); }
 
+    /// @copydoc svs::index::vamana::MutableVamanaIndex::set_early_termination
+    void set_early_termination(const index::vamana::EarlyTermination& criteria) {
+        impl_->set_early_termination(criteria);
+    }
+    index::vamana::EarlyTermination get_early_termination() const {
+        return impl_->get_early_termination();
+    }
+
+    using base_type::search;
+
+    ///
+    /// @brief Perform a batch search and record how the search for each query ended.
+    ///
+    /// @param terminations Entry ``i`` receives the reason the search for query ``i``
+    ///     ended. Must have the same size as ``queries``.
+    ///
+    template <typename QueryType>
+    void search(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        std::span<index::vamana::SearchTermination> terminations
+    ) {
+        impl_->search_with_termination(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            nneighbors,
+            result,
+            terminations
+        );
+    }
+
     // Mutable Interface.
     DynamicVamana& consolidate() {
         impl_->consolidate();
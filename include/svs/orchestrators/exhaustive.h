@@ -18,6 +18,7 @@
 #include "svs/core/data.h"
 #include "svs/core/distance.h"
 #include "svs/core/graph.h"
+#include "svs/core/range_result.h"
 #include "svs/lib/preprocessor.h"
 #include "svs/lib/threads.h"
 
@@ -40,6 +41,15 @@ class FlatInterface : public manager::ManagerInterface {
     virtual size_t get_data_batch_size() const = 0;
     virtual void set_query_batch_size(size_t batch_size) = 0;
     virtual size_t get_query_batch_size() const = 0;
+
+    // Range search.
+    virtual void range_search(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        float radius,
+        RangeSearchResult<size_t>& result
+    ) = 0;
 };
 
 template <typename QueryType, typename Impl, typename IFace = FlatInterface>
@@ -72,6 +82,29 @@ class FlatImpl : public manager::ManagerImpl<QueryType, Impl, FlatInterface> {
         impl().set_query_batch_size(batch_size);
     }
     size_t get_query_batch_size() const override { return impl().get_query_batch_size(); }
+
+    // Range search.
+    void range_search(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        float radius,
+        RangeSearchResult<size_t>& result
+    ) override {
+        if (data.type() != datatype_v<QueryType>) {
+            throw ANNEXCEPTION(
+                "Unsupported data type! Got: ",
+                data.type(),
+                ".  Expected: ",
+                datatype_v<QueryType>,
+                '.'
+            );
+        }
+        const auto queries = data::ConstSimpleDataView(
+            data.template get_unchecked<QueryType>(), dim0, dim1
+        );
+        impl().range_search(queries, radius, result);
+    }
 };
 
 // Forward Declarations
@@ -105,6 +138,26 @@ class Flat : public manager::IndexManager<FlatInterface, FlatImpl> {
 
     size_t get_query_batch_size() const { return impl_->get_query_batch_size(); }
 
+    ///
+    /// @brief Find all dataset elements within ``radius`` of each query.
+    ///
+    /// @sa svs::index::flat::FlatIndex::range_search
+    ///
+    template <typename QueryType>
+    void range_search(
+        data::ConstSimpleDataView<QueryType> queries,
+        float radius,
+        RangeSearchResult<size_t>& result
+    ) {
+        impl_->range_search(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            radius,
+            result
+        );
+    }
+
     ///// Loading
 
     ///
@@ -20,16 +20,21 @@
 #include "svs/core/distance.h"
 #include "svs/core/graph.h"
 #include "svs/core/medioid.h"
+#include "svs/core/range_result.h"
 #include "svs/index/vamana/index.h"
 #include "svs/index/vamana/vamana_build.h"
+#include "svs/lib/bitset.h"
 #include "svs/lib/readwrite.h"
 #include "svs/lib/threads.h"
 #include "svs/orchestrators/manager.h"
 
 // stdlib
 #include <filesystem>
+#include <functional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace svs {
 
@@ -53,6 +58,51 @@ class VamanaInterface : public manager::ManagerInterface {
     virtual void enable_visited_set() = 0;
     virtual void disable_visited_set() = 0;
 
+    // Early termination.
+    virtual void set_early_termination(const index::vamana::EarlyTermination& criteria
+    ) = 0;
+    virtual index::vamana::EarlyTermination get_early_termination() const = 0;
+    virtual void search_with_termination(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        std::span<index::vamana::SearchTermination> terminations
+    ) = 0;
+
+    // Entry points.
+    virtual void set_entry_points(const std::vector<size_t>& entry_points) = 0;
+    virtual std::vector<size_t> get_entry_points() const = 0;
+
+    // Filtered search.
+    virtual void search_filtered(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const lib::Bitset& filter
+    ) = 0;
+    virtual void search_filtered(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const std::function<bool(size_t)>& filter
+    ) = 0;
+
+    // Range search.
+    virtual void range_search(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        float radius,
+        size_t max_neighbors,
+        RangeSearchResult<size_t>& result
+    ) = 0;
+
     // Saving
     virtual void save(
         const std::filesystem::path& config_dir,
@@ -103,6 +153,90 @@ class VamanaImpl : public manager::ManagerImpl<QueryType, Impl, IFace> {
     void enable_visited_set() override { impl().enable_visited_set(); }
     void disable_visited_set() override { impl().disable_visited_set(); }
 
+    // Early termination.
+    void set_early_termination(const index::vamana::EarlyTermination& criteria
+    ) override {
+        impl().set_early_termination(criteria);
+    }
+    index::vamana::EarlyTermination get_early_termination() const override {
+        return impl().get_early_termination();
+    }
+    void search_with_termination(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        std::span<index::vamana::SearchTermination> terminations
+    ) override {
+        impl().search(queries_view(data, dim0, dim1), nneighbors, result, terminations);
+    }
+
+    // Entry points.
+    void set_entry_points(const std::vector<size_t>& entry_points) override {
+        if constexpr (requires { impl().set_entry_points(entry_points); }) {
+            impl().set_entry_points(entry_points);
+        } else {
+            throw ANNEXCEPTION(
+                "The current Vamana backend doesn't support multiple entry points!"
+            );
+        }
+    }
+    std::vector<size_t> get_entry_points() const override {
+        if constexpr (requires { impl().get_entry_points(); }) {
+            const auto& entry_points = impl().get_entry_points();
+            return std::vector<size_t>(entry_points.begin(), entry_points.end());
+        } else {
+            return std::vector<size_t>{impl().entry_point()};
+        }
+    }
+
+    // Filtered search.
+    void search_filtered(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const lib::Bitset& filter
+    ) override {
+        if (filter.size() != impl().size()) {
+            throw ANNEXCEPTION(
+                "Filter size ", filter.size(), " does not match index size ", impl().size()
+            );
+        }
+        search_filtered_impl(queries_view(data, dim0, dim1), nneighbors, result, filter);
+    }
+    void search_filtered(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const std::function<bool(size_t)>& filter
+    ) override {
+        search_filtered_impl(queries_view(data, dim0, dim1), nneighbors, result, filter);
+    }
+
+    // Range search.
+    void range_search(
+        ConstErasedPointer data,
+        size_t dim0,
+        size_t dim1,
+        float radius,
+        size_t max_neighbors,
+        RangeSearchResult<size_t>& result
+    ) override {
+        auto queries = queries_view(data, dim0, dim1);
+        if constexpr (requires {
+                          impl().range_search(queries, radius, max_neighbors, result);
+                      }) {
+            impl().range_search(queries, radius, max_neighbors, result);
+        } else {
+            throw ANNEXCEPTION("The current Vamana backend doesn't support range search!");
+        }
+    }
+
     // Saving.
     void save(
         const std::filesystem::path& config_dir,
@@ -123,6 +257,37 @@ class VamanaImpl : public manager::ManagerImpl<QueryType, Impl, IFace> {
             throw ANNEXCEPTION("The current Vamana backend doesn't support saving!");
         }
     }
+
+  private:
+    static data::ConstSimpleDataView<QueryType>
+    queries_view(ConstErasedPointer data, size_t dim0, size_t dim1) {
+        if (data.type() != datatype_v<QueryType>) {
+            throw ANNEXCEPTION(
+                "Unsupported data type! Got: ",
+                data.type(),
+                ".  Expected: ",
+                datatype_v<QueryType>,
+                '.'
+            );
+        }
+        return data::ConstSimpleDataView(
+            data.template get_unchecked<QueryType>(), dim0, dim1
+        );
+    }
+
+    template <typename Filter>
+    void search_filtered_impl(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const Filter& filter
+    ) {
+        if constexpr (requires { impl().search(queries, nneighbors, result, filter); }) {
+            impl().search(queries, nneighbors, result, filter);
+        } else {
+            throw ANNEXCEPTION("The current Vamana backend doesn't support filtering!");
+        }
+    }
 };
 
 // Forward declarations
@@ -181,6 +346,122 @@ class Vamana : public manager::IndexManager<VamanaInterface, VamanaImpl> {
     void enable_visited_set() { impl_->enable_visited_set(); }
     void disable_visited_set() { impl_->disable_visited_set(); }
 
+    /// @copydoc svs::index::vamana::VamanaIndex::set_early_termination
+    void set_early_termination(const index::vamana::EarlyTermination& criteria) {
+        impl_->set_early_termination(criteria);
+    }
+    /// @copydoc svs::index::vamana::VamanaIndex::get_early_termination
+    index::vamana::EarlyTermination get_early_termination() const {
+        return impl_->get_early_termination();
+    }
+
+    /// @copydoc svs::index::vamana::VamanaIndex::set_entry_points
+    void set_entry_points(const std::vector<size_t>& entry_points) {
+        impl_->set_entry_points(entry_points);
+    }
+    /// @copydoc svs::index::vamana::VamanaIndex::get_entry_points
+    std::vector<size_t> get_entry_points() const { return impl_->get_entry_points(); }
+
+    using base_type::search;
+
+    ///
+    /// @brief Find the dataset elements within ``radius`` of each query.
+    ///
+    /// @param queries The queries.
+    /// @param radius The search radius.
+    /// @param max_neighbors The maximum number of neighbors to return for each query.
+    /// @param result The result to populate.
+    ///
+    /// @sa svs::index::vamana::VamanaIndex::range_search
+    ///
+    template <typename QueryType>
+    void range_search(
+        data::ConstSimpleDataView<QueryType> queries,
+        float radius,
+        size_t max_neighbors,
+        RangeSearchResult<size_t>& result
+    ) {
+        impl_->range_search(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            radius,
+            max_neighbors,
+            result
+        );
+    }
+
+    ///
+    /// @brief Perform a batch search over the dataset elements accepted by ``filter``.
+    ///
+    /// @param filter Bit ``i`` is set if dataset element ``i`` may be returned.
+    ///
+    /// @sa svs::index::vamana::VamanaIndex::search
+    ///
+    template <typename QueryType>
+    void search(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const lib::Bitset& filter
+    ) {
+        impl_->search_filtered(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            nneighbors,
+            result,
+            filter
+        );
+    }
+
+    ///
+    /// @brief Perform a batch search over the dataset elements accepted by ``filter``.
+    ///
+    /// @param filter Return ``true`` for IDs of dataset elements that may be returned.
+    ///     Called through type erasure, so prefer the ``lib::Bitset`` overload when
+    ///     performance matters.
+    ///
+    template <typename QueryType>
+    void search(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        const std::function<bool(size_t)>& filter
+    ) {
+        impl_->search_filtered(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            nneighbors,
+            result,
+            filter
+        );
+    }
+
+    ///
+    /// @brief Perform a batch search and record how the search for each query ended.
+    ///
+    /// @param terminations Entry ``i`` receives the reason the search for query ``i``
+    ///     ended. Must have the same size as ``queries``.
+    ///
+    template <typename QueryType>
+    void search(
+        data::ConstSimpleDataView<QueryType> queries,
+        size_t nneighbors,
+        QueryResultView<size_t> result,
+        std::span<index::vamana::SearchTermination> terminations
+    ) {
+        impl_->search_with_termination(
+            ConstErasedPointer{queries.data()},
+            queries.size(),
+            queries.dimensions(),
+            nneighbors,
+            result,
+            terminations
+        );
+    }
+
     ///
     /// @copydoc svs::index::vamana::VamanaIndex::save
     ///
@@ -211,6 +492,8 @@ class Vamana : public manager::IndexManager<VamanaInterface, VamanaImpl> {
     ///     similarity search computations.
     /// @param num_threads The number of threads to use to process queries.
     ///     May be changed at run-time.
+    /// @param recompute_entry_point Recompute the medioid of the dataset as the entry
+    ///     point instead of using the entry point saved in the configuration.
     ///
     /// @copydoc hidden_vamana_auto_assemble_doc
     ///
@@ -226,7 +509,8 @@ class Vamana : public manager::IndexManager<VamanaInterface, VamanaImpl> {
         const GraphLoaderType& graph_loader,
         DataLoader&& data_loader,
         const Distance& distance,
-        size_t num_threads = 1
+        size_t num_threads = 1,
+        bool recompute_entry_point = false
     ) {
         // If given an `enum` for the distance type, than we need to dispatch over that
         // enum.
@@ -241,12 +525,19 @@ class Vamana : public manager::IndexManager<VamanaInterface, VamanaImpl> {
                     graph_loader,
                     data_loader,
                     distance_function,
-                    num_threads
+                    num_threads,
+                    recompute_entry_point
                 );
             });
         } else {
             return make_vamana<QueryType>(
-                AssembleTag(), config_path, graph_loader, data_loader, distance, num_threads
+                AssembleTag(),
+                config_path,
+                graph_loader,
+                data_loader,
+                distance,
+                num_threads,
+                recompute_entry_point
             );
         }
     }
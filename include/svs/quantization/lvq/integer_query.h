@@ -0,0 +1,415 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/distance/dispatch.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/quantization/lvq/compressed.h"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <x86intrin.h>
+
+///
+/// Integer arithmetic for distance computations between a float query and LVQ compressed
+/// vectors.
+///
+/// The float query is quantized once per search to 16-bit integers with its own scale.
+/// Distance computations then take integer dot products directly against the packed
+/// codes, converting to float only once per compressed vector instead of once per
+/// component.
+///
+/// For a compressed vector ``y = a * c + b`` with integer codes ``c`` and a query
+/// approximated as ``q ~ s * u``, the required quantities are recovered as
+///
+///     <q, y>   ~ a * s * <u, c> + b * sum(q)
+///     ||y||^2  = a^2 * <c, c> + 2 * a * b * sum(c) + n * b^2
+///
+/// Euclidean distances are assembled from these terms, so their absolute error follows the
+/// norms of the operands rather than the distance. Small distances, such as between near
+/// duplicates, are less accurate than with the floating point kernels.
+///
+/// The 16-bit products are accumulated using ``vpdpwssd`` on AVX512-VNNI hosts and
+/// ``vpmaddwd`` on AVX512F hosts. All other hosts use a portable scalar implementation.
+///
+/// The integer path is disabled by default. It can be enabled by setting the environment
+/// variable ``SVS_LVQ_INTEGER_QUERY=1`` or using
+/// ``svs::quantization::lvq::set_integer_query_enabled``.
+///
+
+namespace svs::quantization::lvq {
+
+///
+/// @brief The largest absolute code value supported by the integer kernels.
+///
+/// Covers one-level compression with 4 or 8 bits and two-level compression with
+/// 4x4, 4x8 and 8x4 bits.
+///
+inline constexpr int32_t max_integer_code = 4095;
+
+///
+/// @brief The largest absolute value of a quantized query component.
+///
+/// Chosen so the 32-bit accumulator lanes of the vectorized kernels cannot overflow
+/// within one block of ``integer_block_size`` components.
+///
+inline constexpr int32_t max_query_code = 32767;
+
+///
+/// @brief The number of components accumulated in 32-bit lanes before widening.
+///
+inline constexpr size_t integer_block_size = 256;
+
+namespace detail {
+inline bool initial_integer_query() {
+    const char* requested = std::getenv("SVS_LVQ_INTEGER_QUERY");
+    return requested != nullptr && std::string_view{requested} == "1";
+}
+
+inline std::atomic<bool> integer_query_enabled_{initial_integer_query()};
+} // namespace detail
+
+///
+/// @brief Return whether biased LVQ distances use the integer query path.
+///
+inline bool integer_query_enabled() {
+    return detail::integer_query_enabled_.load(std::memory_order_relaxed);
+}
+
+///
+/// @brief Enable or disable the integer query path for biased LVQ distances.
+///
+/// Takes effect for queries processed after the call.
+///
+inline void set_integer_query_enabled(bool enabled) {
+    detail::integer_query_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+///
+/// @brief A query vector quantized to 16-bit integers.
+///
+/// The integer codes are padded with zeros to a multiple of 32 so vectorized kernels can
+/// load them without masking.
+///
+class QuantizedQuery {
+  public:
+    static constexpr size_t padding = 32;
+
+    QuantizedQuery() = default;
+
+    ///
+    /// @brief Quantize ``query``, reusing previously allocated storage.
+    ///
+    void assign(std::span<const float> query) {
+        assign_impl(query.size(), [query](size_t i) { return query[i]; });
+    }
+
+    ///
+    /// @brief Quantize ``query - shift`` without materializing the shifted query.
+    ///
+    void assign(std::span<const float> query, std::span<const float> shift) {
+        assert(query.size() == shift.size());
+        assign_impl(query.size(), [query, shift](size_t i) { return query[i] - shift[i]; });
+    }
+
+    /// @brief Return the number of components in the original query.
+    size_t size() const { return size_; }
+    /// @brief Return the zero-padded integer codes.
+    std::span<const int16_t> codes() const { return {codes_.data(), codes_.size()}; }
+    /// @brief Return the scale such that ``query[i] ~ scale() * codes()[i]``.
+    float scale() const { return scale_; }
+    /// @brief Return the sum of the components of the original query.
+    float sum() const { return sum_; }
+    /// @brief Return the squared norm of the original query.
+    float norm_squared() const { return norm_squared_; }
+
+  private:
+    template <typename F> void assign_impl(size_t size, F&& get) {
+        size_ = size;
+        codes_.assign(lib::round_up_to_multiple_of(size_, padding), 0);
+
+        float absmax = 0;
+        double sum = 0;
+        double norm_squared = 0;
+        for (size_t i = 0; i < size_; ++i) {
+            float x = get(i);
+            absmax = std::max(absmax, std::abs(x));
+            sum += x;
+            norm_squared += static_cast<double>(x) * x;
+        }
+        sum_ = static_cast<float>(sum);
+        norm_squared_ = static_cast<float>(norm_squared);
+
+        scale_ = absmax / static_cast<float>(max_query_code);
+        if (absmax == 0) {
+            return;
+        }
+        float inverse = 1.0f / scale_;
+        constexpr long bound = max_query_code;
+        for (size_t i = 0; i < size_; ++i) {
+            auto u = std::clamp<long>(std::lround(get(i) * inverse), -bound, bound);
+            codes_[i] = static_cast<int16_t>(u);
+        }
+    }
+
+    std::vector<int16_t> codes_{};
+    size_t size_ = 0;
+    float scale_ = 0;
+    float sum_ = 0;
+    float norm_squared_ = 0;
+};
+
+///
+/// @brief Integer reductions between a quantized query and integer codes.
+///
+struct IntegerSums {
+    /// The dot product between the query codes and the vector codes.
+    int64_t dot = 0;
+    /// The sum of the vector codes.
+    int64_t sum = 0;
+    /// The sum of squares of the vector codes.
+    int64_t sumsq = 0;
+};
+
+/////
+///// Code Loaders
+/////
+
+namespace detail {
+
+// Load 32 codes starting at element `i` (which must be a multiple of 32) widened to
+// 16-bit integers. The `mask` must select a prefix of the 32 lanes and unselected lanes
+// are zeroed.
+template <typename Sign, size_t Bits, size_t Extent>
+SVS_TARGET_AVX512F inline __m512i
+load_codes(const CompressedVector<Sign, Bits, Extent>& v, size_t i, __mmask32 mask) {
+    static_assert(Bits == 4 || Bits == 8);
+    const std::byte* base = v.data();
+    if constexpr (Bits == 8) {
+        __m256i x = _mm256_maskz_loadu_epi8(mask, base + i);
+        if constexpr (std::is_same_v<Sign, Signed>) {
+            return _mm512_cvtepi8_epi16(x);
+        } else {
+            return _mm512_cvtepu8_epi16(x);
+        }
+    } else {
+        // Two codes per byte with the even element in the low nibble.
+        // Widen each byte into a 32-bit lane and split the nibbles into its two 16-bit
+        // halves.
+        auto num_bytes = (__builtin_popcount(mask) + 1) / 2;
+        auto byte_mask = static_cast<__mmask16>((uint32_t{1} << num_bytes) - 1);
+        __m512i x = _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(byte_mask, base + i / 2));
+        __m512i lo = _mm512_and_si512(x, _mm512_set1_epi32(0x0F));
+        __m512i hi = _mm512_slli_epi32(_mm512_and_si512(x, _mm512_set1_epi32(0xF0)), 12);
+        __m512i codes = _mm512_or_si512(lo, hi);
+        if constexpr (std::is_same_v<Sign, Signed>) {
+            codes = _mm512_sub_epi16(codes, _mm512_set1_epi16(8));
+        }
+        return _mm512_maskz_mov_epi16(mask, codes);
+    }
+}
+
+} // namespace detail
+
+///
+/// @brief Integer codes of a one-level compressed vector.
+///
+template <size_t Bits, size_t Extent> struct OneLevelCodes {
+    static constexpr int32_t max_code = (1 << Bits) - 1;
+
+    size_t size() const { return data.size(); }
+    int32_t get(size_t i) const { return data.get(i); }
+
+    SVS_TARGET_AVX512F __m512i load(size_t i, __mmask32 mask) const {
+        return detail::load_codes(data, i, mask);
+    }
+
+    CompressedVector<Unsigned, Bits, Extent> data;
+};
+
+///
+/// @brief Integer codes ``(primary << Residual) + residual`` of a two-level compressed
+///     vector.
+///
+template <size_t Primary, size_t Residual, size_t Extent> struct TwoLevelCodes {
+    static constexpr int32_t max_code =
+        ((1 << Primary) - 1) * (1 << Residual) + (1 << (Residual - 1));
+
+    size_t size() const { return primary.size(); }
+    int32_t get(size_t i) const {
+        return (int32_t{primary.get(i)} << Residual) + int32_t{residual.get(i)};
+    }
+
+    SVS_TARGET_AVX512F __m512i load(size_t i, __mmask32 mask) const {
+        __m512i p = detail::load_codes(primary, i, mask);
+        __m512i r = detail::load_codes(residual, i, mask);
+        return _mm512_add_epi16(_mm512_slli_epi16(p, Residual), r);
+    }
+
+    CompressedVector<Unsigned, Primary, Extent> primary;
+    CompressedVector<Signed, Residual, Extent> residual;
+};
+
+template <typename T> inline constexpr bool is_integer_codes_v = false;
+template <size_t Bits, size_t Extent>
+inline constexpr bool is_integer_codes_v<OneLevelCodes<Bits, Extent>> =
+    (Bits == 4 || Bits == 8);
+template <size_t Primary, size_t Residual, size_t Extent>
+inline constexpr bool is_integer_codes_v<TwoLevelCodes<Primary, Residual, Extent>> =
+    (Primary == 4 || Primary == 8) && (Residual == 4 || Residual == 8) &&
+    TwoLevelCodes<Primary, Residual, Extent>::max_code <= max_integer_code;
+
+/////
+///// Kernels
+/////
+
+namespace detail {
+
+inline __mmask32 prefix_mask(size_t i, size_t n) {
+    size_t remaining = n - i;
+    return remaining >= 32 ? ~__mmask32{0} : (__mmask32{1} << remaining) - 1;
+}
+
+// Add the 32-bit lanes of `x` into the 64-bit lanes of `accum`.
+SVS_TARGET_AVX512F inline __m512i widen_add(__m512i accum, __m512i x) {
+    __m512i lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(x));
+    __m512i hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(x, 1));
+    return _mm512_add_epi64(accum, _mm512_add_epi64(lo, hi));
+}
+
+template <bool Norms, typename Codes>
+IntegerSums integer_sums_generic(const int16_t* query, const Codes& codes) {
+    auto sums = IntegerSums{};
+    for (size_t i = 0, imax = codes.size(); i < imax; ++i) {
+        int64_t c = codes.get(i);
+        sums.dot += c * query[i];
+        if constexpr (Norms) {
+            sums.sum += c;
+            sums.sumsq += c * c;
+        }
+    }
+    return sums;
+}
+
+// The AVX512F and AVX512VNNI kernels differ only in the multiply-accumulate instruction.
+// They are spelled out separately because each body requires its own target attribute.
+template <bool Norms, typename Codes>
+SVS_NOINLINE SVS_TARGET_AVX512F IntegerSums
+integer_sums_avx512f(const int16_t* query, const Codes& codes) {
+    __m512i dot64 = _mm512_setzero_si512();
+    __m512i sum64 = _mm512_setzero_si512();
+    __m512i sumsq64 = _mm512_setzero_si512();
+    const __m512i ones = _mm512_set1_epi16(1);
+    const size_t n = codes.size();
+    for (size_t block = 0; block < n; block += integer_block_size) {
+        __m512i dot = _mm512_setzero_si512();
+        __m512i sum = _mm512_setzero_si512();
+        __m512i sumsq = _mm512_setzero_si512();
+        for (size_t i = block, imax = std::min(n, block + integer_block_size); i < imax;
+             i += 32) {
+            __m512i c = codes.load(i, prefix_mask(i, n));
+            __m512i q = _mm512_loadu_si512(query + i);
+            dot = _mm512_add_epi32(dot, _mm512_madd_epi16(q, c));
+            if constexpr (Norms) {
+                sum = _mm512_add_epi32(sum, _mm512_madd_epi16(c, ones));
+                sumsq = _mm512_add_epi32(sumsq, _mm512_madd_epi16(c, c));
+            }
+        }
+        dot64 = widen_add(dot64, dot);
+        if constexpr (Norms) {
+            sum64 = widen_add(sum64, sum);
+            sumsq64 = widen_add(sumsq64, sumsq);
+        }
+    }
+    return IntegerSums{
+        _mm512_reduce_add_epi64(dot64),
+        _mm512_reduce_add_epi64(sum64),
+        _mm512_reduce_add_epi64(sumsq64)};
+}
+
+template <bool Norms, typename Codes>
+SVS_NOINLINE SVS_TARGET_AVX512VNNI IntegerSums
+integer_sums_avx512vnni(const int16_t* query, const Codes& codes) {
+    __m512i dot64 = _mm512_setzero_si512();
+    __m512i sum64 = _mm512_setzero_si512();
+    __m512i sumsq64 = _mm512_setzero_si512();
+    const __m512i ones = _mm512_set1_epi16(1);
+    const size_t n = codes.size();
+    for (size_t block = 0; block < n; block += integer_block_size) {
+        __m512i dot = _mm512_setzero_si512();
+        __m512i sum = _mm512_setzero_si512();
+        __m512i sumsq = _mm512_setzero_si512();
+        for (size_t i = block, imax = std::min(n, block + integer_block_size); i < imax;
+             i += 32) {
+            __m512i c = codes.load(i, prefix_mask(i, n));
+            __m512i q = _mm512_loadu_si512(query + i);
+            dot = _mm512_dpwssd_epi32(dot, q, c);
+            if constexpr (Norms) {
+                sum = _mm512_dpwssd_epi32(sum, c, ones);
+                sumsq = _mm512_dpwssd_epi32(sumsq, c, c);
+            }
+        }
+        dot64 = widen_add(dot64, dot);
+        if constexpr (Norms) {
+            sum64 = widen_add(sum64, sum);
+            sumsq64 = widen_add(sumsq64, sumsq);
+        }
+    }
+    return IntegerSums{
+        _mm512_reduce_add_epi64(dot64),
+        _mm512_reduce_add_epi64(sum64),
+        _mm512_reduce_add_epi64(sumsq64)};
+}
+
+} // namespace detail
+
+///
+/// @brief Compute the integer dot product between ``query`` and ``codes``.
+///
+/// If ``Norms`` is ``true``, also compute the sum and sum of squares of the codes.
+/// Otherwise, these fields are left as zero.
+///
+/// @param query The query codes, zero padded to a multiple of 32.
+/// @param codes The integer codes of a compressed vector.
+///
+template <bool Norms, typename Codes>
+    requires is_integer_codes_v<Codes>
+IntegerSums integer_sums(std::span<const int16_t> query, const Codes& codes) {
+    assert(query.size() >= codes.size());
+    assert(query.size() % QuantizedQuery::padding == 0);
+    switch (distance::active_isa()) {
+        case distance::ISA::avx512vnni: {
+            return detail::integer_sums_avx512vnni<Norms>(query.data(), codes);
+        }
+        case distance::ISA::avx512f: {
+            return detail::integer_sums_avx512f<Norms>(query.data(), codes);
+        }
+        case distance::ISA::avx2:
+        case distance::ISA::generic: {
+            break;
+        }
+    }
+    return detail::integer_sums_generic<Norms>(query.data(), codes);
+}
+
+} // namespace svs::quantization::lvq
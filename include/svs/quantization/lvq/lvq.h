@@ -97,18 +97,23 @@ GlobalMinMax mapped_extrema(const Data& data, const Map& map, Pool& threadpool)
 }
 
 ///
-/// Compress a dataset.
+/// Compress `original` into the entries `[offset, offset + original.size())` of
+/// `compressed`.
 ///
 template <
     data::MemoryDataset Compressed,
     data::ImmutableMemoryDataset Original,
     typename Map,
     threads::ThreadPool Pool>
-void generic_compress(
-    Compressed& compressed, const Original& original, Map&& map, Pool& threadpool
+void generic_compress_at(
+    Compressed& compressed,
+    size_t offset,
+    const Original& original,
+    Map&& map,
+    Pool& threadpool
 ) {
-    if (compressed.size() != original.size()) {
-        throw ANNEXCEPTION("Compressed and original dataset have mismatched sizes!");
+    if (offset + original.size() > compressed.size()) {
+        throw ANNEXCEPTION("Original dataset does not fit in the compressed dataset!");
     }
     threads::run(
         threadpool,
@@ -117,12 +122,34 @@ void generic_compress(
             // Construct a thread-local copy of the original map.
             auto map_local = map;
             for (auto i : is) {
-                compressed.set_datum(i, map_local(original.get_datum(i)));
+                compressed.set_datum(offset + i, map_local(original.get_datum(i)));
             }
         }
     );
 }
 
+///
+/// Compress a dataset.
+///
+template <
+    data::MemoryDataset Compressed,
+    data::ImmutableMemoryDataset Original,
+    typename Map,
+    threads::ThreadPool Pool>
+void generic_compress(
+    Compressed& compressed, const Original& original, Map&& map, Pool& threadpool
+) {
+    if (compressed.size() != original.size()) {
+        throw ANNEXCEPTION("Compressed and original dataset have mismatched sizes!");
+    }
+    generic_compress_at(compressed, 0, original, std::forward<Map>(map), threadpool);
+}
+
+///
+/// Compute the residuals of `original` with respect to the entries
+/// `[offset, offset + original.size())` of `primary`, storing the results in the same
+/// entries of `residual`.
+///
 template <
     data::MemoryDataset Residual,
     data::ImmutableMemoryDataset Primary,
@@ -130,16 +157,17 @@ template <
     typename Map1,
     typename Map2,
     threads::ThreadPool Pool>
-void generic_compress_residual(
+void generic_compress_residual_at(
     Residual& residual,
     const Primary& primary,
+    size_t offset,
     const Original& original,
     Map1&& map_outer,
     Map2&& map_inner,
     Pool& threadpool
 ) {
-    if (primary.size() != original.size()) {
-        throw ANNEXCEPTION("Primary and original dataset have mismatched sizes!");
+    if (offset + original.size() > primary.size()) {
+        throw ANNEXCEPTION("Original dataset does not fit in the primary dataset!");
     }
     if (primary.size() != residual.size()) {
         throw ANNEXCEPTION("Primary and residual dataset have mismatched sizes!");
@@ -153,12 +181,103 @@ void generic_compress_residual(
             auto map_inner_local = map_inner;
             for (auto i : is) {
                 const auto& compressed = map_outer_local(
-                    primary.get_datum(i), map_inner_local(original.get_datum(i))
+                    primary.get_datum(offset + i), map_inner_local(original.get_datum(i))
                 );
-                residual.set_datum(i, compressed);
+                residual.set_datum(offset + i, compressed);
+            }
+        }
+    );
+}
+
+template <
+    data::MemoryDataset Residual,
+    data::ImmutableMemoryDataset Primary,
+    data::ImmutableMemoryDataset Original,
+    typename Map1,
+    typename Map2,
+    threads::ThreadPool Pool>
+void generic_compress_residual(
+    Residual& residual,
+    const Primary& primary,
+    const Original& original,
+    Map1&& map_outer,
+    Map2&& map_inner,
+    Pool& threadpool
+) {
+    if (primary.size() != original.size()) {
+        throw ANNEXCEPTION("Primary and original dataset have mismatched sizes!");
+    }
+    generic_compress_residual_at(
+        residual,
+        primary,
+        0,
+        original,
+        std::forward<Map1>(map_outer),
+        std::forward<Map2>(map_inner),
+        threadpool
+    );
+}
+
+/////
+///// Streaming Compression
+/////
+
+///
+/// The default maximum number of uncompressed vectors held in memory at a time when
+/// compressing a dataset directly from a file.
+///
+inline constexpr size_t default_compression_chunk_size = 1'000'000;
+
+///
+/// Return whether the dataset at `path` can be compressed in a streaming manner.
+///
+/// Datasets saved by the library (a directory or a config file) are loaded in full.
+///
+inline bool is_streamable(const std::filesystem::path& path) {
+    return !(maybe_config_file(path) || std::filesystem::is_directory(path));
+}
+
+///
+/// Compute the number of vectors and the component-wise means of the dataset in the file
+/// at `path` while holding at most `chunk_size` vectors in memory.
+///
+template <typename T, size_t Extent, threads::ThreadPool Pool>
+std::pair<size_t, std::vector<double>> streaming_means(
+    const std::filesystem::path& path, size_t chunk_size, Pool& threadpool
+) {
+    // Accumulate in double precision, weighting the means of each chunk by the chunk size.
+    auto sums = utils::CountSum(0);
+    io::auto_for_each_chunk<T, Extent>(
+        path,
+        chunk_size,
+        [&](const auto& chunk, size_t SVS_UNUSED(start)) {
+            auto means = utils::compute_medioid(chunk, threadpool);
+            auto count = chunk.size();
+            if (sums.size() == 0) {
+                sums = utils::CountSum(means.size());
+            }
+            for (size_t i = 0, imax = means.size(); i < imax; ++i) {
+                sums.sums[i] += means[i] * lib::narrow_cast<double>(count);
             }
+            sums.count += count;
         }
     );
+
+    if (sums.count == 0) {
+        throw ANNEXCEPTION("Cannot compress the empty dataset ", path, '!');
+    }
+    return std::make_pair(sums.count, sums.finish());
+}
+
+///
+/// Convert component-wise means into a form that can be assigned as the centroids of a
+/// compressed dataset.
+///
+inline data::SimpleData<float> as_centroids(const std::vector<double>& means) {
+    auto means_f32 = std::vector<float>(means.begin(), means.end());
+    auto centroids = data::SimpleData<float>(1, means_f32.size());
+    centroids.set_datum(0, means_f32);
+    return centroids;
 }
 
 // Partial template specializations to get the access mode value types set-up correctly.
@@ -689,14 +808,53 @@ template <size_t Primary, size_t Extent = svs::Dynamic> class OneLevelWithBias {
         );
     }
 
+    ///
+    /// @brief Compress the dataset in the given file.
+    ///
+    /// @param path The path to the uncompressed dataset.
+    /// @param builder The builder to use for the compressed dataset.
+    /// @param num_threads The number of threads to use for compression.
+    /// @param chunk_size The maximum number of uncompressed vectors to keep in memory.
+    ///
+    /// The file is read twice: once to compute the component-wise means and once to
+    /// compress the dataset chunk by chunk, so the full-precision dataset is never
+    /// materialized. Previously saved uncompressed datasets are loaded in full.
+    ///
     template <typename SourceType, typename Builder = default_builder_type>
     return_type<Builder> compress_file(
         const std::filesystem::path& path,
         const Builder& builder = {},
-        size_t num_threads = 1
+        size_t num_threads = 1,
+        size_t chunk_size = default_compression_chunk_size
     ) const {
-        auto data = VectorDataLoader<SourceType>(path).load();
-        return compress(data, builder, num_threads);
+        if (!is_streamable(path)) {
+            auto data = VectorDataLoader<SourceType>(path).load();
+            return compress(data, builder, num_threads);
+        }
+
+        threads::NativeThreadPool threadpool{num_threads};
+        auto [size, means] =
+            streaming_means<SourceType, Extent>(path, chunk_size, threadpool);
+
+        auto dims = lib::MaybeStatic<Extent>(means.size());
+        primary_type<Builder> primary{size, dims, padding_, builder};
+        primary.set_centroids(as_centroids(means));
+
+        auto map = VectorBias::make_map<SourceType>(means);
+        io::auto_for_each_chunk<SourceType, Extent>(
+            path,
+            chunk_size,
+            [&](const auto& chunk, size_t start) {
+                generic_compress_at(
+                    primary,
+                    start,
+                    chunk,
+                    lib::Compose(MinRange<Primary, Extent>(dims), map),
+                    threadpool
+                );
+            }
+        );
+        return return_type<Builder>{std::move(primary)};
     }
 
     template <data::ImmutableMemoryDataset Data, typename Builder = default_builder_type>
@@ -725,13 +883,7 @@ template <size_t Primary, size_t Extent = svs::Dynamic> class OneLevelWithBias {
         // Allocate the compressed dataset.
         auto dims = lib::MaybeStatic<Extent>(data.dimensions());
         primary_type<Builder> primary{data.size(), dims, padding_, builder};
-
-        // Need to do a little dance to get the means into a form that can be cleanly
-        // assigned to the dataset.
-        auto means_f32 = std::vector<float>(centroid.begin(), centroid.end());
-        auto means = data::SimpleData<float>(1, means_f32.size());
-        means.set_datum(0, means_f32);
-        primary.set_centroids(means);
+        primary.set_centroids(as_centroids(centroid));
 
         // Compress the dataset by:
         // 1. Lazily removing the per-vector bias using `map`.
@@ -945,14 +1097,63 @@ template <size_t Primary, size_t Residual, size_t Extent = Dynamic> class TwoLev
         );
     }
 
+    ///
+    /// @brief Compress the dataset in the given file.
+    ///
+    /// @param path The path to the uncompressed dataset.
+    /// @param builder The builder to use for the compressed dataset.
+    /// @param num_threads The number of threads to use for compression.
+    /// @param chunk_size The maximum number of uncompressed vectors to keep in memory.
+    ///
+    /// The file is read twice: once to compute the component-wise means and once to
+    /// compress the dataset chunk by chunk, so the full-precision dataset is never
+    /// materialized. Previously saved uncompressed datasets are loaded in full.
+    ///
     template <typename SourceType, typename Builder = default_builder_type>
     return_type<Builder> compress_file(
         const std::filesystem::path& path,
         const Builder& builder = {},
-        size_t num_threads = 1
+        size_t num_threads = 1,
+        size_t chunk_size = default_compression_chunk_size
     ) const {
-        auto data = VectorDataLoader<SourceType>(path).load();
-        return compress(data, builder, num_threads);
+        if (!is_streamable(path)) {
+            auto data = VectorDataLoader<SourceType>(path).load();
+            return compress(data, builder, num_threads);
+        }
+
+        threads::NativeThreadPool threadpool{num_threads};
+        auto [size, means] =
+            streaming_means<SourceType, Extent>(path, chunk_size, threadpool);
+
+        auto static_ndims = lib::MaybeStatic<Extent>(means.size());
+        auto primary = primary_type<Builder>{size, static_ndims, padding_, builder};
+        primary.set_centroids(as_centroids(means));
+        auto residual = residual_type<Builder>{size, static_ndims, builder};
+
+        auto map = VectorBias::make_map<SourceType>(means);
+        io::auto_for_each_chunk<SourceType, Extent>(
+            path,
+            chunk_size,
+            [&](const auto& chunk, size_t start) {
+                generic_compress_at(
+                    primary,
+                    start,
+                    chunk,
+                    lib::Compose(MinRange<Primary, Extent>(static_ndims), map),
+                    threadpool
+                );
+                generic_compress_residual_at(
+                    residual,
+                    primary,
+                    start,
+                    chunk,
+                    ResidualEncoder<Residual>(),
+                    map,
+                    threadpool
+                );
+            }
+        );
+        return return_type<Builder>{std::move(primary), std::move(residual)};
     }
 
     template <data::ImmutableMemoryDataset Data, typename Builder = default_builder_type>
@@ -978,11 +1179,7 @@ template <size_t Primary, size_t Residual, size_t Extent = Dynamic> class TwoLev
         VectorBias op{};
         auto&& [map, centroid] = op(data, threadpool);
         auto primary = primary_type<Builder>{data.size(), static_ndims, padding_, builder};
-
-        auto means_f32 = std::vector<float>(centroid.begin(), centroid.end());
-        auto means = data::SimpleData<float>(1, means_f32.size());
-        means.set_datum(0, means_f32);
-        primary.set_centroids(means);
+        primary.set_centroids(as_centroids(centroid));
 
         generic_compress(
             primary,
@@ -187,15 +187,24 @@ struct VectorBias : public DatasetPreOpBase {
         using T = element_type_t<Data>;
 
         // Compute the component-wise mean of the dataset.
-        // Negate the medioid to get the bias we've applied to the dataset.
         std::vector<double> means_f64 = utils::compute_medioid(data, pool);
-        auto negative_means = std::vector<double>(means_f64.begin(), means_f64.end());
+        auto map = make_map<T>(means_f64);
+        return std::make_tuple(std::move(map), std::move(means_f64));
+    }
+
+    ///
+    /// Construct the map subtracting the precomputed component-wise ``means`` from a
+    /// dataset entry with element type ``T``.
+    ///
+    /// Useful when the means are accumulated without materializing the whole dataset.
+    ///
+    template <typename T> static ScaleShift<T> make_map(const std::vector<double>& means) {
+        // Negate the medioid to get the bias we've applied to the dataset.
+        auto negative_means = std::vector<double>(means.begin(), means.end());
         range::negate(negative_means);
 
         auto ones = std::vector<double>(negative_means.size(), 1.0);
-        return std::make_tuple(
-            ScaleShift<T>(std::move(ones), std::move(negative_means)), std::move(means_f64)
-        );
+        return ScaleShift<T>(std::move(ones), std::move(negative_means));
     }
 };
 } // namespace svs::quantization::lvq
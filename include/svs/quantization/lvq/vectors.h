@@ -21,6 +21,7 @@
 #include "svs/lib/saveload.h"
 #include "svs/lib/type_traits.h"
 #include "svs/quantization/lvq/compressed.h"
+#include "svs/quantization/lvq/integer_query.h"
 #include "svs/third-party/eve.h"
 
 // stl
@@ -608,9 +609,72 @@ float compute(Distance distance, std::span<const float> x, const T& y) {
 
 namespace quantization::lvq {
 
+/////
+///// Integer Query Path
+/////
+
+template <size_t Bits, size_t Extent>
+OneLevelCodes<Bits, Extent> integer_codes(const ScaledBiasedVector<Bits, Extent>& v) {
+    return OneLevelCodes<Bits, Extent>{v.data};
+}
+
+template <size_t Primary, size_t Residual, size_t N>
+TwoLevelCodes<Primary, Residual, N>
+integer_codes(const ScaledBiasedWithResidual<Primary, Residual, N>& v) {
+    return TwoLevelCodes<Primary, Residual, N>{v.primary_.data, v.residual_};
+}
+
+///
+/// Compressed vectors whose codes are supported by the integer query kernels.
+///
+template <typename T>
+concept IntegerQueryable =
+    requires(const T& x) { integer_codes(x); } &&
+    is_integer_codes_v<decltype(integer_codes(std::declval<const T&>()))>;
+
+///
+/// Compute the inner product between the original query of `query` and `y`.
+///
+template <IntegerQueryable T>
+float integer_inner_product(const QuantizedQuery& query, const T& y) {
+    auto aux = y.prepare_aux();
+    auto sums = integer_sums<false>(query.codes(), integer_codes(y));
+    return aux.scale * query.scale() * static_cast<float>(sums.dot) +
+           aux.bias * query.sum();
+}
+
+///
+/// Compute the squared Euclidean distance between the original query of `query` and `y`.
+///
+/// The distance is assembled as ``||q||^2 - 2 <q, y> + ||y||^2``. Quantizing the query
+/// introduces an absolute error of at most ``query.scale() * sum(|y[i] - bias|)``, which
+/// scales with the norms rather than with the distance itself. Distances between near
+/// duplicates therefore have a much larger relative error than with the float kernel,
+/// which accumulates the squared differences directly. The squared difference cannot be
+/// accumulated in the integer domain because the query and ``y`` use different scales.
+///
+template <IntegerQueryable T>
+float integer_euclidean(const QuantizedQuery& query, const T& y) {
+    auto aux = y.prepare_aux();
+    auto sums = integer_sums<true>(query.codes(), integer_codes(y));
+    float a = aux.scale;
+    float b = aux.bias;
+    float qy = a * query.scale() * static_cast<float>(sums.dot) + b * query.sum();
+    float yy = a * a * static_cast<float>(sums.sumsq) +
+               2 * a * b * static_cast<float>(sums.sum) +
+               static_cast<float>(y.size()) * b * b;
+    // Guard against a slightly negative result due to cancellation.
+    return std::max(query.norm_squared() - 2 * qy + yy, 0.0f);
+}
+
 ///
 /// Distance computations supporting a global vector bias.
 ///
+/// The query shifted by each centroid is computed lazily by ``compute`` the first time a
+/// vector using that centroid is encountered. Even though ``compute`` is ``const``, it
+/// writes these caches, so a functor must not be used by several threads at once. Give
+/// each thread its own functor, for example using ``shallow_copy``.
+///
 class EuclideanBiased {
   public:
     using compare = std::less<>;
@@ -621,14 +685,17 @@ class EuclideanBiased {
     // Constructors
     EuclideanBiased(const std::shared_ptr<const data::SimpleData<float>>& centroids)
         : processed_query_(centroids->size(), centroids->dimensions())
+        , shifted_epoch_(centroids->size(), 0)
         , centroids_{centroids} {}
 
     EuclideanBiased(std::shared_ptr<const data::SimpleData<float>>&& centroids)
         : processed_query_(centroids->size(), centroids->dimensions())
+        , shifted_epoch_(centroids->size(), 0)
         , centroids_{std::move(centroids)} {}
 
     EuclideanBiased(const std::vector<float>& centroid)
         : processed_query_(1, centroid.size())
+        , shifted_epoch_(1, 0)
         , centroids_{} {
         // Construct the shared pointer by first creating a non-const version, then
         // using the copy-constructor.
@@ -642,21 +709,23 @@ class EuclideanBiased {
     EuclideanBiased shallow_copy() const { return EuclideanBiased{centroids_}; }
 
     ///
-    /// Subtract each centroid from the query and store the result in `processed_query_`.
-    /// This essentially moves the query by the same amount as the original data point,
-    /// preserving L2 distance.
+    /// Record the query for subsequent distance computations.
+    ///
+    /// The query is shifted by a centroid (moving it by the same amount as the original
+    /// data points assigned to that centroid, preserving L2 distance) the first time a
+    /// vector using that centroid is encountered. With many centroids, this avoids paying
+    /// for centroids that are never visited by the search.
     ///
     void fix_argument(const std::span<const float>& query) {
         // Check pre-conditions.
         assert(centroids_->dimensions() == query.size());
-        // Component-wise add the bias to the query and cache the result.
-        auto jmax = query.size();
-        for (size_t i = 0, imax = centroids_->size(); i < imax; ++i) {
-            const auto& centroid = centroids_->get_datum(i);
-            auto dst = processed_query_.get_datum(i);
-            for (size_t j = 0; j < jmax; ++j) {
-                dst[j] = query[j] - centroid[j];
-            }
+        query_.assign(query.begin(), query.end());
+        // Bumping the epoch invalidates all cached shifted queries.
+        ++epoch_;
+        use_integer_ = integer_query_enabled();
+        if (use_integer_) {
+            quantized_query_.resize(centroids_->size());
+            quantized_epoch_.resize(centroids_->size(), 0);
         }
     }
 
@@ -679,12 +748,43 @@ class EuclideanBiased {
     {
         // If the argument `y` is a `std::span`, it's not a compressed vector so fall-back
         // to doing normal distance computations.
+        if constexpr (IntegerQueryable<T>) {
+            if (use_integer_) {
+                return integer_euclidean(view_quantized_query(y.get_selector()), y);
+            }
+        }
         distance::DistanceL2 inner{};
         return distance::compute(inner, view_query(y.get_selector()), y);
     }
 
+    ///
+    /// Return the query shifted by centroid `i`, computing it if necessary.
+    ///
     std::span<const float> view_query(size_t i) const {
-        return processed_query_.get_datum(i);
+        auto dst = processed_query_.get_datum(i);
+        if (shifted_epoch_[i] != epoch_) {
+            auto centroid = centroids_->get_datum(i);
+            for (size_t j = 0, jmax = query_.size(); j < jmax; ++j) {
+                dst[j] = query_[j] - centroid[j];
+            }
+            shifted_epoch_[i] = epoch_;
+        }
+        return dst;
+    }
+
+    ///
+    /// Return the integer version of the query shifted by centroid `i`, computing it if
+    /// necessary. Requires the integer query path to have been enabled during the last
+    /// call to `fix_argument`.
+    ///
+    const QuantizedQuery& view_quantized_query(size_t i) const {
+        assert(use_integer_);
+        auto& quantized = quantized_query_[i];
+        if (quantized_epoch_[i] != epoch_) {
+            quantized.assign(query_, centroids_->get_datum(i));
+            quantized_epoch_[i] = epoch_;
+        }
+        return quantized;
     }
 
     ///
@@ -695,7 +795,19 @@ class EuclideanBiased {
     std::span<const float> get_centroid(size_t i) const { return centroids_->get_datum(i); }
 
   private:
-    data::SimpleData<float> processed_query_;
+    // The query passed to the last call to `fix_argument`.
+    std::vector<float> query_{};
+    // The query shifted by each centroid. Row `i` is valid if `shifted_epoch_[i]` matches
+    // the current `epoch_`.
+    mutable data::SimpleData<float> processed_query_;
+    mutable std::vector<uint64_t> shifted_epoch_;
+    // Integer versions of the shifted queries, populated in the same manner.
+    mutable std::vector<QuantizedQuery> quantized_query_{};
+    mutable std::vector<uint64_t> quantized_epoch_{};
+    // Incremented on each call to `fix_argument`. Starts above zero so that no cached
+    // entry is valid before the first query.
+    uint64_t epoch_ = 1;
+    bool use_integer_ = false;
     std::shared_ptr<const data::SimpleData<float>> centroids_;
 };
 
@@ -720,6 +832,15 @@ inline bool operator==(const EuclideanBiased& x, const EuclideanBiased& y) {
     return true;
 }
 
+///
+/// Inner product computations supporting a global vector bias.
+///
+/// The inner product between the query and each centroid is computed lazily by
+/// ``compute`` the first time a vector using that centroid is encountered. Even though
+/// ``compute`` is ``const``, it writes these caches, so a functor must not be used by
+/// several threads at once. Give each thread its own functor, for example using
+/// ``shallow_copy``.
+///
 class InnerProductBiased {
   public:
     using compare = std::greater<>;
@@ -730,14 +851,17 @@ class InnerProductBiased {
     // Constructor
     InnerProductBiased(const std::shared_ptr<const data::SimpleData<float>>& centroids)
         : processed_query_(centroids->size())
+        , processed_epoch_(centroids->size(), 0)
         , centroids_{centroids} {}
 
     InnerProductBiased(std::shared_ptr<const data::SimpleData<float>>&& centroids)
         : processed_query_(centroids->size())
+        , processed_epoch_(centroids->size(), 0)
         , centroids_{std::move(centroids)} {}
 
     InnerProductBiased(const std::vector<float>& centroid)
         : processed_query_(1)
+        , processed_epoch_(1, 0)
         , centroids_{} {
         // Construct the shared pointer by first creating a non-const version, then
         // using the copy-constructor.
@@ -750,23 +874,26 @@ class InnerProductBiased {
     InnerProductBiased shallow_copy() const { return InnerProductBiased{centroids_}; }
 
     ///
-    /// Precompute the inner product between the query and the global bias.
-    /// This pre-computed value will be added to the result of standard distance
-    /// computations using the distributive property where
+    /// Record the query for subsequent distance computations.
+    ///
+    /// The inner product between the query and each centroid is added to the result of
+    /// standard distance computations using the distributive property where
     /// ```
     /// q . (x + b) == (q . x) + (q . b)
     /// ```
+    /// Each such product is computed the first time a vector using that centroid is
+    /// encountered and cached for the remainder of the query.
     ///
     void fix_argument(const std::span<const float>& query) {
         // Check pre-conditions.
         assert(centroids_->dimensions() == query.size());
         assert(processed_query_.size() == centroids_->size());
-
-        // Pre-compute the inner-product between the query and each centroid.
-        distance::DistanceIP inner_distance{};
-        for (size_t i = 0, imax = centroids_->size(); i < imax; ++i) {
-            processed_query_[i] =
-                distance::compute(inner_distance, query, centroids_->get_datum(i));
+        query_.assign(query.begin(), query.end());
+        // Bumping the epoch invalidates all cached inner products.
+        ++epoch_;
+        use_integer_ = integer_query_enabled();
+        if (use_integer_) {
+            quantized_query_.assign(query);
         }
     }
 
@@ -775,7 +902,7 @@ class InnerProductBiased {
         requires(lib::is_spanlike_v<T>)
     {
         auto inner = distance::DistanceIP{};
-        return distance::compute(inner, query, y) + processed_query_[selector];
+        return distance::compute(inner, query, y) + centroid_product(selector);
     }
 
     template <typename T>
@@ -784,8 +911,29 @@ class InnerProductBiased {
     {
         // If the argument `y` is a `std::span`, it's not a compressed vector so fall-back
         // to doing normal distance computations.
+        if constexpr (IntegerQueryable<T>) {
+            if (use_integer_) {
+                return integer_inner_product(quantized_query_, y) +
+                       centroid_product(y.get_selector());
+            }
+        }
         distance::DistanceIP inner{};
-        return distance::compute(inner, query, y) + processed_query_[y.get_selector()];
+        return distance::compute(inner, query, y) + centroid_product(y.get_selector());
+    }
+
+    ///
+    /// Return the inner product between the query and centroid `i`, computing it if
+    /// necessary.
+    ///
+    float centroid_product(size_t i) const {
+        if (processed_epoch_[i] != epoch_) {
+            distance::DistanceIP inner_distance{};
+            processed_query_[i] = distance::compute(
+                inner_distance, lib::as_const_span(query_), centroids_->get_datum(i)
+            );
+            processed_epoch_[i] = epoch_;
+        }
+        return processed_query_[i];
     }
 
     ///
@@ -796,9 +944,19 @@ class InnerProductBiased {
     std::span<const float> get_centroid(size_t i) const { return centroids_->get_datum(i); }
 
   private:
+    // The query passed to the last call to `fix_argument`.
+    std::vector<float> query_{};
     // The results of computing the inner product between each centroid and the query.
     // Applied after the distance computation between the query and compressed vector.
-    std::vector<float> processed_query_;
+    // Entry `i` is valid if `processed_epoch_[i]` matches the current `epoch_`.
+    mutable std::vector<float> processed_query_;
+    mutable std::vector<uint64_t> processed_epoch_;
+    // Incremented on each call to `fix_argument`.
+    uint64_t epoch_ = 1;
+    // The query quantized during the last call to `fix_argument` if the integer query
+    // path was enabled.
+    QuantizedQuery quantized_query_{};
+    bool use_integer_ = false;
     std::shared_ptr<const data::SimpleData<float>> centroids_;
 };
 
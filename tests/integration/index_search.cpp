@@ -188,6 +188,18 @@ CATCH_TEST_CASE("Testing Search", "[integration][search]") {
         CATCH_REQUIRE(index.dimensions() == test_dataset::NUM_DIMENSIONS);
         run_tests(index, queries, groundtruth, results);
 
+        // Recomputing the entry point instead of using the saved one should not change
+        // the results as the saved entry point is the medioid.
+        auto recomputed = svs::Vamana::assemble<float>(
+            test_dataset::vamana_config_file(),
+            svs::GraphLoader(test_dataset::graph_file()),
+            svs::VectorDataLoader<float>(test_dataset::data_svs_file()),
+            distance_type,
+            2,
+            true
+        );
+        run_tests(recomputed, queries, groundtruth, results);
+
         // Save and reload.
         svs_test::prepare_temp_directory();
 
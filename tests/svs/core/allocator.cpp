@@ -166,6 +166,25 @@ CATCH_TEST_CASE("Testing Allocator", "[allocators]") {
             for (size_t i = 0; i < nelements; ++i) {
                 CATCH_REQUIRE(*(base + i) == i);
             }
+
+            // Lazy, aligned and advised mappings observe the same contents.
+            CATCH_REQUIRE(mapper.populate());
+            CATCH_REQUIRE(mapper.advice() == svs::MemoryMapper::NoAdvice);
+            CATCH_REQUIRE(mapper.alignment() == 0);
+            CATCH_REQUIRE_THROWS_AS(mapper.setalignment(3), svs::ANNException);
+            mapper.setpolicy(svs::MemoryMapper::MustUseExisting);
+            mapper.setpopulate(false);
+            mapper.setadvice(svs::MemoryMapper::Random);
+            const size_t alignment = 1 << 21;
+            mapper.setalignment(alignment);
+            for (size_t j = 0; j < 3; ++j) {
+                svs::MMapPtr<float> aligned = mapper.mmap(temp_file, bytes);
+                CATCH_REQUIRE(reinterpret_cast<uintptr_t>(aligned.base()) % alignment == 0);
+                base = svs::lib::memory::access_storage(aligned);
+                for (size_t i = 0; i < nelements; ++i) {
+                    CATCH_REQUIRE(*(base + i) == i);
+                }
+            }
         }
     }
 }
@@ -82,4 +82,27 @@ CATCH_TEST_CASE("Data Loading/Saving", "[core][data]") {
         auto w = loader.load();
         CATCH_REQUIRE(w == z);
     }
+
+    CATCH_SECTION("Memory Mapped Data") {
+        auto x = svs::data::SimplePolymorphicData<float, svs::Dynamic>(10, 10);
+        set_sequential(x);
+        auto file = temp_directory / "mapped.svs";
+        svs::io::save(x, svs::io::NativeFile(file));
+
+        auto mapper = svs::MemoryMapper();
+        mapper.setpopulate(false);
+        auto builder = svs::data::MemoryMapBuilder(mapper);
+        using Loader = svs::VectorDataLoader<float, 10, svs::data::MemoryMapBuilder>;
+        auto y = Loader(file, builder).load();
+        CATCH_REQUIRE(x == y);
+
+        // Loading from a saved directory maps the referenced binary file.
+        svs::lib::save(x, temp_directory / "mapped");
+        auto z = Loader(temp_directory / "mapped", builder).load();
+        CATCH_REQUIRE(x == z);
+
+        // Dimension mismatches are still detected.
+        using WrongLoader = svs::VectorDataLoader<float, 20, svs::data::MemoryMapBuilder>;
+        CATCH_REQUIRE_THROWS_AS(WrongLoader(file, builder).load(), svs::ANNException);
+    }
 }
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// stdlib
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// svs
+#include "svs/core/distance.h"
+#include "svs/core/distance/dispatch.h"
+#include "svs/lib/float16.h"
+
+// catch2
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// tests
+#include "tests/utils/generators.h"
+
+namespace {
+
+// Compare the active kernel against the generic implementation for all supported levels.
+template <typename Ea, typename Eb, typename T>
+void test_all_levels(T lo, T hi, size_t ndims, size_t num_tests) {
+    namespace dist = svs::distance;
+    auto a = std::vector<Ea>();
+    auto b = std::vector<Eb>();
+    // Use fixed seeds so any failure is reproducible.
+    auto generator_a = svs_test::make_generator<Ea>(lo, hi, 0xc0ffee);
+    auto generator_b = svs_test::make_generator<Eb>(lo, hi, 0xdecade);
+
+    const auto original = dist::active_isa();
+    for (size_t i = 0; i < num_tests; ++i) {
+        svs_test::populate(a, generator_a, ndims);
+        svs_test::populate(b, generator_b, ndims);
+        float a_norm = std::sqrt(dist::IP::compute(a.data(), a.data(), ndims));
+
+        // Kernels use different summation orders, so results differ by rounding error.
+        // For the inner product, that error is bounded relative to the sum of the
+        // magnitudes of the terms rather than to the result, which may cancel to near
+        // zero. Scale the absolute tolerance accordingly.
+        double magnitude = 0;
+        double b_norm_squared = 0;
+        for (size_t j = 0; j < ndims; ++j) {
+            auto aj = static_cast<double>(static_cast<float>(a[j]));
+            auto bj = static_cast<double>(static_cast<float>(b[j]));
+            magnitude += std::abs(aj * bj);
+            b_norm_squared += bj * bj;
+        }
+        const double eps = 1e-4;
+        auto ip_margin = eps * magnitude;
+        auto cosine_margin = ip_margin / (a_norm * std::sqrt(b_norm_squared));
+
+        CATCH_REQUIRE(dist::set_active_isa(dist::ISA::generic) == dist::ISA::generic);
+        auto l2 = dist::L2::compute(a.data(), b.data(), ndims);
+        auto ip = dist::IP::compute(a.data(), b.data(), ndims);
+        auto cosine = dist::CosineSimilarity::compute(a.data(), b.data(), a_norm, ndims);
+        auto approx = [&](float x, double margin) {
+            return Catch::Approx(x).epsilon(eps).margin(margin);
+        };
+
+        for (auto isa : {dist::ISA::avx2, dist::ISA::avx512f, dist::ISA::avx512vnni}) {
+            if (dist::set_active_isa(isa) != isa) {
+                // Not supported by this host.
+                break;
+            }
+            CATCH_REQUIRE(dist::L2::compute(a.data(), b.data(), ndims) == approx(l2, eps));
+            CATCH_REQUIRE(
+                dist::IP::compute(a.data(), b.data(), ndims) == approx(ip, ip_margin)
+            );
+            CATCH_REQUIRE(
+                dist::CosineSimilarity::compute(a.data(), b.data(), a_norm, ndims) ==
+                approx(cosine, cosine_margin)
+            );
+        }
+    }
+    dist::set_active_isa(original);
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Distance Dispatch", "[distance][dispatch]") {
+    namespace dist = svs::distance;
+
+    CATCH_SECTION("Names") {
+        auto all = {
+            dist::ISA::generic, dist::ISA::avx2, dist::ISA::avx512f, dist::ISA::avx512vnni};
+        for (auto isa : all) {
+            auto parsed = dist::parse_isa(dist::name(isa));
+            CATCH_REQUIRE(parsed.has_value());
+            CATCH_REQUIRE(parsed.value() == isa);
+        }
+        CATCH_REQUIRE(!dist::parse_isa("sse4").has_value());
+    }
+
+    CATCH_SECTION("Selection") {
+        const auto original = dist::active_isa();
+        const auto detected = dist::detect_isa();
+        CATCH_REQUIRE(original <= detected);
+
+        // Requests are clamped to what the host supports.
+        CATCH_REQUIRE(dist::set_active_isa(dist::ISA::avx512vnni) == detected);
+        CATCH_REQUIRE(dist::active_isa() == detected);
+        CATCH_REQUIRE(dist::set_active_isa(dist::ISA::generic) == dist::ISA::generic);
+        CATCH_REQUIRE(dist::active_isa() == dist::ISA::generic);
+        dist::set_active_isa(original);
+    }
+
+    CATCH_SECTION("Kernel Agreement") {
+        const size_t ntests = 100;
+        for (size_t ndims : {16, 43, 128}) {
+            test_all_levels<float, float>(-1, 1, ndims, ntests);
+            test_all_levels<float, svs::Float16>(-1, 1, ndims, ntests);
+            test_all_levels<svs::Float16, svs::Float16>(-1, 1, ndims, ntests);
+            test_all_levels<float, int8_t>(-128, 127, ndims, ntests);
+            test_all_levels<float, uint8_t>(0, 255, ndims, ntests);
+            test_all_levels<int8_t, int8_t>(-128, 127, ndims, ntests);
+            test_all_levels<uint8_t, uint8_t>(0, 255, ndims, ntests);
+        }
+    }
+}
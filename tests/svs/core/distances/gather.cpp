@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// stdlib
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/distance/gather.h"
+#include "svs/lib/float16.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// tests
+#include "tests/utils/generators.h"
+
+namespace {
+
+// Check that gathered distances match the per-pair distances for every instruction set
+// level supported by the host.
+template <typename T, size_t Extent, typename Dist>
+void test_gather(Dist distance, size_t ndims) {
+    namespace dist = svs::distance;
+    const size_t num_elements = 50;
+    auto data = svs::data::SimpleData<T, Extent>(num_elements, ndims);
+    auto generator = svs_test::make_generator<T>(-1, 1);
+    auto buffer = std::vector<T>();
+    for (size_t i = 0; i < num_elements; ++i) {
+        svs_test::populate(buffer, generator, ndims);
+        data.set_datum(i, buffer);
+    }
+
+    auto query_buffer = std::vector<float>();
+    svs_test::populate(query_buffer, svs_test::make_generator<float>(-1, 1), ndims);
+    auto query = std::span<const float, Extent>(query_buffer.data(), ndims);
+    dist::maybe_fix_argument(distance, query);
+
+    // Scatter the IDs over the dataset.
+    auto ids = std::vector<uint32_t>();
+    for (size_t i = 0; i < 37; ++i) {
+        ids.push_back((7 * i) % num_elements);
+    }
+    const auto original = dist::active_isa();
+    for (auto isa :
+         {dist::ISA::generic, dist::ISA::avx2, dist::ISA::avx512f, dist::ISA::avx512vnni}) {
+        if (dist::set_active_isa(isa) != isa) {
+            // Not supported by this host.
+            break;
+        }
+        // Include counts that are not a multiple of the kernel unrolling or block size.
+        for (size_t count : {0, 1, 3, 4, 16, 17, 37}) {
+            auto result = std::vector<float>(count, -1);
+            dist::compute_gathered(
+                distance,
+                query,
+                data,
+                std::span<const uint32_t>(ids.data(), count),
+                std::span<float>(result),
+                svs::data::full_access
+            );
+            // Each accumulator of the batched kernels sees the same sequence of operations
+            // as the single-vector kernel, so results are identical.
+            for (size_t i = 0; i < count; ++i) {
+                auto datum = data.get_datum(ids.at(i), svs::data::full_access);
+                CATCH_REQUIRE(result.at(i) == dist::compute(distance, query, datum));
+            }
+        }
+    }
+    dist::set_active_isa(original);
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Gathered Distances", "[distance][gather]") {
+    for (size_t ndims : {3, 16, 43, 128}) {
+        test_gather<float, svs::Dynamic>(svs::DistanceL2(), ndims);
+        test_gather<float, svs::Dynamic>(svs::DistanceIP(), ndims);
+        test_gather<svs::Float16, svs::Dynamic>(svs::DistanceL2(), ndims);
+        test_gather<svs::Float16, svs::Dynamic>(svs::DistanceIP(), ndims);
+        // Not batched. Scored one element at a time.
+        test_gather<float, svs::Dynamic>(svs::DistanceCosineSimilarity(), ndims);
+    }
+    test_gather<float, 128>(svs::DistanceL2(), 128);
+    test_gather<float, 128>(svs::DistanceIP(), 128);
+    test_gather<svs::Float16, 128>(svs::DistanceL2(), 128);
+}
@@ -0,0 +1,207 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+#include "svs/core/graph/fused.h"
+#include "svs/concepts/graph.h"
+#include "svs/index/vamana/index.h"
+#include "svs/lib/saveload.h"
+
+// test utils
+#include "tests/utils/test_dataset.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stdlib
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using Idx = uint32_t;
+using Store = svs::graphs::FusedStore<Idx, float>;
+
+static_assert(svs::graphs::MemoryGraph<Store::graph_type>);
+static_assert(svs::data::MemoryDataset<Store::data_type>);
+
+template <typename Graph, typename Data>
+void check_equal(const Store& store, const Graph& graph, const Data& data) {
+    CATCH_REQUIRE(store.size() == data.size());
+    CATCH_REQUIRE(store.dimensions() == data.dimensions());
+    CATCH_REQUIRE(store.max_degree() == graph.max_degree());
+
+    auto fused_graph = store.graph();
+    auto fused_data = store.data();
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto expected = graph.get_node(i);
+        auto got = fused_graph.get_node(i);
+        CATCH_REQUIRE(std::equal(expected.begin(), expected.end(), got.begin(), got.end()));
+
+        auto expected_datum = data.get_datum(i);
+        auto datum = fused_data.get_datum(i);
+        CATCH_REQUIRE(std::equal(
+            expected_datum.begin(), expected_datum.end(), datum.begin(), datum.end()
+        ));
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Fused Graph and Data", "[graphs][fused]") {
+    CATCH_SECTION("Layout") {
+        auto layout = svs::graphs::FusedLayout::make<uint32_t, float>(31, 10);
+        CATCH_REQUIRE(layout.data_offset == 128);
+        CATCH_REQUIRE(layout.record_bytes == 192);
+
+        layout = svs::graphs::FusedLayout::make<uint32_t, svs::Float16>(4, 3);
+        CATCH_REQUIRE(layout.data_offset == 20);
+        CATCH_REQUIRE(layout.record_bytes == 64);
+
+        layout = svs::graphs::FusedLayout::make<uint16_t, double>(2, 1);
+        CATCH_REQUIRE(layout.data_offset == 8);
+        CATCH_REQUIRE(layout.record_bytes == 64);
+    }
+
+    CATCH_SECTION("Basic Operations") {
+        const size_t num_nodes = 10;
+        const size_t max_degree = 5;
+        const size_t dims = 7;
+        auto store = Store(num_nodes, max_degree, dims);
+        CATCH_REQUIRE(store.size() == num_nodes);
+        CATCH_REQUIRE(store.max_degree() == max_degree);
+        CATCH_REQUIRE(store.dimensions() == dims);
+
+        auto graph = store.graph();
+        auto data = store.data();
+        for (Idx i = 0; i < num_nodes; ++i) {
+            CATCH_REQUIRE(graph.get_node_degree(i) == 0);
+        }
+
+        // Writing through one view must not disturb the other.
+        auto v = std::vector<float>(dims);
+        for (Idx i = 0; i < num_nodes; ++i) {
+            std::fill(v.begin(), v.end(), static_cast<float>(i));
+            data.set_datum(i, v);
+            for (Idx j = 1; j <= max_degree; ++j) {
+                graph.add_edge(i, (i + j) % num_nodes);
+            }
+        }
+        // Adding past the maximum degree is a no-op.
+        CATCH_REQUIRE(graph.add_edge(0, 9) == max_degree);
+
+        for (Idx i = 0; i < num_nodes; ++i) {
+            auto neighbors = store.graph().get_node(i);
+            CATCH_REQUIRE(neighbors.size() == max_degree);
+            for (Idx j = 0; j < max_degree; ++j) {
+                CATCH_REQUIRE(neighbors[j] == (i + j + 1) % num_nodes);
+            }
+            auto datum = store.data().get_datum(i);
+            CATCH_REQUIRE(std::all_of(datum.begin(), datum.end(), [&](float x) {
+                return x == static_cast<float>(i);
+            }));
+        }
+
+        graph.clear_node(3);
+        CATCH_REQUIRE(graph.get_node_degree(3) == 0);
+        CATCH_REQUIRE(data.get_datum(3)[0] == 3.0f);
+
+        CATCH_REQUIRE_THROWS_AS(
+            data.set_datum(0, std::vector<float>(dims + 1)), svs::ANNException
+        );
+    }
+
+    CATCH_SECTION("Convert and Search") {
+        auto graph = test_dataset::graph();
+        auto data = test_dataset::data_f32();
+        auto queries = test_dataset::queries();
+        auto store = Store::convert(graph, data);
+        check_equal(store, graph, data);
+
+        // Searching the fused layout returns exactly the same results.
+        const size_t num_neighbors = 10;
+        auto dist = svs::distance::DistanceL2();
+        auto index = svs::index::vamana::VamanaIndex{
+            std::move(graph), std::move(data), Idx{0}, dist, 1};
+        auto fused = svs::index::vamana::VamanaIndex{
+            store.graph(), store.data(), Idx{0}, dist, 1};
+        index.set_search_window_size(20);
+        fused.set_search_window_size(20);
+
+        auto expected = index.search(queries, num_neighbors);
+        auto got = fused.search(queries, num_neighbors);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(expected.index(i, j) == got.index(i, j));
+            }
+        }
+    }
+
+    CATCH_SECTION("Build") {
+        auto data = test_dataset::data_f32();
+        auto store = Store::build(data, 32);
+        CATCH_REQUIRE(store.graph().get_node_degree(0) == 0);
+
+        auto parameters = svs::index::vamana::VamanaBuildParameters{1.2, 32, 64, 500, 2};
+        auto index = svs::index::vamana::VamanaIndex{
+            parameters,
+            store.graph(),
+            store.data(),
+            Idx{0},
+            svs::distance::DistanceL2(),
+            svs::threads::NativeThreadPool(1)};
+        // Construction populates the shared records.
+        CATCH_REQUIRE(store.graph().get_node_degree(0) > 0);
+    }
+
+    CATCH_SECTION("Save and Load") {
+        auto graph = test_dataset::graph();
+        auto data = test_dataset::data_f32();
+        auto store = Store::convert(graph, data);
+
+        svs_test::prepare_temp_directory();
+        auto temp = svs_test::temp_directory();
+        svs::lib::save(store, temp / "fused");
+        auto reloaded = svs::lib::load<Store>(temp / "fused");
+        CATCH_REQUIRE(reloaded.layout() == store.layout());
+        check_equal(reloaded, graph, data);
+
+        // Memory mapped records.
+        auto builder = svs::data::MemoryMapBuilder(svs::MemoryMapper());
+        auto mapped = svs::lib::load(
+            svs::lib::LoadOverride{[&](const toml::table& table,
+                                       const svs::lib::LoadContext& ctx,
+                                       const svs::lib::Version& version) {
+                return Store::load(table, ctx, version, builder);
+            }},
+            temp / "fused"
+        );
+        check_equal(mapped, graph, data);
+
+        // The views save in the standard formats.
+        auto fused_graph = store.graph();
+        auto fused_data = store.data();
+        svs::lib::save(fused_graph, temp / "graph");
+        svs::lib::save(fused_data, temp / "data");
+        auto reloaded_graph = svs::GraphLoader(temp / "graph").load();
+        auto reloaded_data = svs::VectorDataLoader<float>(temp / "data").load();
+        check_equal(store, reloaded_graph, reloaded_data);
+
+        // Mismatched types are detected.
+        CATCH_REQUIRE_THROWS_AS(
+            (svs::lib::load<svs::graphs::FusedStore<Idx, uint8_t>>(temp / "fused")),
+            svs::ANNException
+        );
+        svs_test::cleanup_temp_directory();
+    }
+}
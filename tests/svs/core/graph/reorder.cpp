@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+#include "svs/core/graph/reorder.h"
+#include "svs/core/graph/graph.h"
+#include "svs/index/vamana/index.h"
+
+// test utils
+#include "tests/utils/test_dataset.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stdlib
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using Idx = uint32_t;
+
+// Check that ``reordered`` is ``original`` with vertices renumbered by ``reordering``.
+template <typename Graph>
+void check_permuted(
+    const Graph& original,
+    const svs::graphs::SimpleGraph<Idx>& reordered,
+    const svs::graphs::Reordering<Idx>& reordering
+) {
+    for (Idx i = 0; i < reordered.n_nodes(); ++i) {
+        auto expected = std::vector<Idx>();
+        for (auto j : original.get_node(reordering.old_id(i))) {
+            expected.push_back(reordering.new_id(j));
+        }
+        std::sort(expected.begin(), expected.end());
+
+        auto got = reordered.get_node(i);
+        CATCH_REQUIRE(std::equal(expected.begin(), expected.end(), got.begin(), got.end()));
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Graph Reordering", "[graphs][reorder]") {
+    CATCH_SECTION("Reordering") {
+        auto reordering = svs::graphs::Reordering<Idx>({2, 0, 3, 1});
+        CATCH_REQUIRE(reordering.size() == 4);
+        CATCH_REQUIRE(reordering.old_id(0) == 2);
+        CATCH_REQUIRE(reordering.new_id(2) == 0);
+        CATCH_REQUIRE(reordering.new_id(1) == 3);
+
+        auto translator = reordering.translator();
+        for (Idx i = 0; i < reordering.size(); ++i) {
+            CATCH_REQUIRE(translator.get_internal(reordering.old_id(i)) == i);
+        }
+
+        // Compose with a non-trivial translation.
+        auto previous = svs::IDTranslator();
+        previous.insert(std::vector<size_t>{10, 11, 12, 13}, std::vector<Idx>{3, 2, 1, 0});
+        auto composed = reordering.translator(previous);
+        CATCH_REQUIRE(composed.get_internal(10) == reordering.new_id(3));
+        CATCH_REQUIRE(composed.get_internal(13) == reordering.new_id(0));
+
+        CATCH_REQUIRE_THROWS_AS(
+            svs::graphs::Reordering<Idx>({0, 0, 1}), svs::ANNException
+        );
+        CATCH_REQUIRE_THROWS_AS(svs::graphs::Reordering<Idx>({0, 3}), svs::ANNException);
+
+        CATCH_REQUIRE(
+            svs::graphs::parse_vertex_order("rcm") == svs::graphs::VertexOrder::RCM
+        );
+        CATCH_REQUIRE_THROWS_AS(svs::graphs::parse_vertex_order("xyz"), svs::ANNException);
+    }
+
+    CATCH_SECTION("Orders") {
+        // 0 -> {3, 1}, 1 -> {2}, 2 -> {}, 3 -> {1, 2, 0}, 4 is disconnected.
+        auto graph = svs::graphs::SimpleGraph<Idx>(5, 3);
+        graph.replace_node(0, std::vector<Idx>{3, 1});
+        graph.replace_node(1, std::vector<Idx>{2});
+        graph.replace_node(3, std::vector<Idx>{1, 2, 0});
+
+        using Order = std::vector<Idx>;
+        CATCH_REQUIRE(svs::graphs::bfs_order(graph, Idx{0}) == Order{0, 3, 1, 2, 4});
+        CATCH_REQUIRE(svs::graphs::bfs_order(graph, Idx{2}) == Order{2, 0, 3, 1, 4});
+        // Neighbors of 0 are visited by increasing degree: 1 (degree 1) before 3.
+        CATCH_REQUIRE(svs::graphs::rcm_order(graph, Idx{0}) == Order{4, 2, 3, 1, 0});
+
+        CATCH_REQUIRE_THROWS_AS(svs::graphs::bfs_order(graph, Idx{5}), svs::ANNException);
+    }
+
+    CATCH_SECTION("Permute Index") {
+        auto graph = test_dataset::graph();
+        auto data = test_dataset::data_f32();
+        auto queries = test_dataset::queries();
+        auto threadpool = svs::threads::NativeThreadPool(2);
+        const Idx entry_point = 0;
+        double span = svs::graphs::mean_edge_span(graph);
+
+        auto index = svs::index::vamana::VamanaIndex{
+            test_dataset::graph(),
+            test_dataset::data_f32(),
+            entry_point,
+            svs::distance::DistanceL2(),
+            1};
+        index.set_search_window_size(20);
+        auto expected = index.search(queries, 10);
+
+        using svs::graphs::VertexOrder;
+        for (auto strategy : {VertexOrder::BFS, VertexOrder::RCM}) {
+            auto reordering = svs::graphs::compute_reordering(graph, entry_point, strategy);
+            CATCH_REQUIRE(reordering.size() == graph.n_nodes());
+
+            auto new_graph =
+                svs::graphs::SimpleGraph<Idx>(graph.n_nodes(), graph.max_degree());
+            svs::graphs::permute_graph(graph, new_graph, reordering, threadpool);
+            check_permuted(graph, new_graph, reordering);
+
+            auto new_data = svs::data::SimpleData<float>(data.size(), data.dimensions());
+            svs::graphs::permute_data(data, new_data, reordering, threadpool);
+            for (Idx i = 0; i < new_data.size(); ++i) {
+                auto x = new_data.get_datum(i);
+                auto y = data.get_datum(reordering.old_id(i));
+                CATCH_REQUIRE(std::equal(x.begin(), x.end(), y.begin(), y.end()));
+            }
+
+            // Neighbors should be closer together after reordering.
+            double new_span = svs::graphs::mean_edge_span(new_graph);
+            CATCH_REQUIRE(new_span < span);
+
+            // The reordered index returns the same neighbors once translated.
+            auto reordered_index = svs::index::vamana::VamanaIndex{
+                std::move(new_graph),
+                std::move(new_data),
+                reordering.new_id(entry_point),
+                svs::distance::DistanceL2(),
+                1};
+            reordered_index.set_search_window_size(20);
+            auto result = reordered_index.search(queries, 10);
+            size_t mismatches = 0;
+            for (size_t i = 0; i < queries.size(); ++i) {
+                for (size_t j = 0; j < 10; ++j) {
+                    mismatches += reordering.old_id(result.index(i, j)) !=
+                                  expected.index(i, j);
+                }
+            }
+            CATCH_REQUIRE(mismatches == 0);
+
+            auto wrong_size = svs::graphs::SimpleGraph<Idx>(10, graph.max_degree());
+            CATCH_REQUIRE_THROWS_AS(
+                svs::graphs::permute_graph(graph, wrong_size, reordering, threadpool),
+                svs::ANNException
+            );
+        }
+    }
+
+    CATCH_SECTION("Reorder Index") {
+        auto graph = test_dataset::graph();
+        auto data = test_dataset::data_f32();
+        auto queries = test_dataset::queries();
+        auto threadpool = svs::threads::NativeThreadPool(2);
+        auto entry_points = std::vector<size_t>{0, 17, 42};
+
+        auto index = svs::index::vamana::VamanaIndex{
+            test_dataset::graph(),
+            test_dataset::data_f32(),
+            Idx{0},
+            svs::distance::DistanceL2(),
+            1};
+        index.set_entry_points(entry_points);
+        index.set_search_window_size(20);
+        auto expected = index.search(queries, 10);
+
+        auto reordered = svs::graphs::reorder(
+            graph, data, entry_points, svs::graphs::VertexOrder::BFS, threadpool
+        );
+        const auto& translator = reordered.translator;
+        CATCH_REQUIRE(translator.size() == graph.n_nodes());
+        CATCH_REQUIRE(reordered.entry_points.size() == entry_points.size());
+        for (size_t i = 0; i < entry_points.size(); ++i) {
+            CATCH_REQUIRE(
+                reordered.entry_points[i] == translator.get_internal(entry_points[i])
+            );
+        }
+        // Breadth-first traversal numbers the first entry point first.
+        CATCH_REQUIRE(reordered.entry_points.front() == 0);
+        for (Idx i = 0; i < graph.n_nodes(); ++i) {
+            auto x = reordered.data.get_datum(translator.get_internal(i));
+            auto y = data.get_datum(i);
+            CATCH_REQUIRE(std::equal(x.begin(), x.end(), y.begin(), y.end()));
+        }
+        CATCH_REQUIRE(
+            svs::graphs::mean_edge_span(reordered.graph) <
+            svs::graphs::mean_edge_span(graph)
+        );
+
+        // Save in the static format and reload as a static index.
+        auto parameters = svs::index::vamana::VamanaConfigParameters{
+            graph.max_degree(),
+            reordered.entry_points.front(),
+            1.2F,
+            1000,
+            200,
+            true,
+            20,
+            false,
+            std::vector<size_t>(
+                reordered.entry_points.begin(), reordered.entry_points.end()
+            )};
+        svs_test::prepare_temp_directory();
+        auto dir = svs_test::temp_directory();
+        svs::lib::save(parameters, dir / "config");
+        svs::lib::save(reordered.graph, dir / "graph");
+        svs::lib::save(reordered.data, dir / "data");
+        svs::lib::save(reordered.translator, dir / "translation");
+
+        auto reloaded = svs::index::vamana::auto_assemble(
+            dir / "config",
+            svs::GraphLoader(dir / "graph"),
+            svs::VectorDataLoader<float>(dir / "data"),
+            svs::distance::DistanceL2(),
+            1
+        );
+        auto reloaded_translator = svs::lib::load<svs::IDTranslator>(dir / "translation");
+        CATCH_REQUIRE(reloaded.get_entry_points().size() == entry_points.size());
+
+        // Results match the original index once translated.
+        auto result = reloaded.search(queries, 10);
+        size_t mismatches = 0;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < 10; ++j) {
+                mismatches += reloaded_translator.get_external(result.index(i, j)) !=
+                              expected.index(i, j);
+            }
+        }
+        CATCH_REQUIRE(mismatches == 0);
+    }
+}
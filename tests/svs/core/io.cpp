@@ -96,6 +96,46 @@ CATCH_TEST_CASE("Testing Dataset Loading and Writing", "[core][integrated_io]")
         }
     }
 
+    CATCH_SECTION("Chunked Loading") {
+        const size_t chunk_size = 3;
+        auto check_chunks = [&](const auto& file) {
+            size_t num_chunks = 0;
+            size_t num_vectors = 0;
+            svs::io::for_each_chunk<float, EXPECTED_EXTENT>(
+                file,
+                chunk_size,
+                [&](const auto& chunk, size_t start) {
+                    CATCH_REQUIRE(start == num_vectors);
+                    CATCH_REQUIRE(chunk.size() <= chunk_size);
+                    CATCH_REQUIRE(chunk.dimensions() == reference_ndims);
+                    CATCH_REQUIRE(chunk.get_datum(0).extent == reference_ndims);
+                    for (size_t i = 0; i < chunk.size(); ++i) {
+                        auto span = chunk.get_datum(i);
+                        const auto& expected = reference.at(start + i);
+                        CATCH_REQUIRE(
+                            std::equal(span.begin(), span.end(), expected.begin())
+                        );
+                    }
+                    num_vectors += chunk.size();
+                    ++num_chunks;
+                }
+            );
+            CATCH_REQUIRE(num_vectors == reference_nvectors);
+            CATCH_REQUIRE(num_chunks == (reference_nvectors + chunk_size - 1) / chunk_size);
+        };
+
+        check_chunks(svs::io::vecs::VecsFile<float>{vecs_file});
+        check_chunks(svs::io::NativeFile{native_file_reference});
+
+        // Chunks must be non-empty.
+        CATCH_REQUIRE_THROWS_AS(
+            svs::io::auto_for_each_chunk<float>(
+                vecs_file, 0, [](const auto&, size_t) {}
+            ),
+            svs::ANNException
+        );
+    }
+
     // Save directly to file.
     CATCH_SECTION("Standard Saving") {
         svs::io::save(index_data, svs::io::v1::NativeFile{native_file_test});
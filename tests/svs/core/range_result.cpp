@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/core/range_result.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <functional>
+#include <vector>
+
+namespace {
+using Neighbor = svs::Neighbor<size_t>;
+}
+
+CATCH_TEST_CASE("Range Search Result", "[core][range_result]") {
+    CATCH_SECTION("Within Radius") {
+        CATCH_REQUIRE(svs::within_radius<std::less<>>(1.0f, 2.0f));
+        CATCH_REQUIRE(svs::within_radius<std::less<>>(2.0f, 2.0f));
+        CATCH_REQUIRE(!svs::within_radius<std::less<>>(3.0f, 2.0f));
+        CATCH_REQUIRE(svs::within_radius<std::greater<>>(3.0f, 2.0f));
+        CATCH_REQUIRE(svs::within_radius<std::greater<>>(2.0f, 2.0f));
+        CATCH_REQUIRE(!svs::within_radius<std::greater<>>(1.0f, 2.0f));
+    }
+
+    CATCH_SECTION("Assembly") {
+        auto result = svs::RangeSearchResult<size_t>();
+        CATCH_REQUIRE(result.n_queries() == 0);
+        CATCH_REQUIRE(result.size() == 0);
+        CATCH_REQUIRE(result.offsets() == std::vector<size_t>{0});
+
+        const void* storage = nullptr;
+        for (size_t iteration = 0; iteration < 2; ++iteration) {
+            result.prepare(4, 2);
+            // Query 0 is split across both partials and arrives out of order.
+            auto& a = result.partial(0);
+            a.push_back(0, Neighbor{10, 3.0f});
+            a.push_back(0, Neighbor{11, 1.0f});
+            a.push_back(2, Neighbor{20, 5.0f});
+            a.push_back(0, Neighbor{12, 0.5f});
+            auto& b = result.partial(1);
+            b.push_back(3, Neighbor{30, 2.0f});
+            b.push_back(0, Neighbor{13, 2.0f});
+            CATCH_REQUIRE(a.size() == 4);
+            result.finish(std::less<>());
+
+            CATCH_REQUIRE(result.n_queries() == 4);
+            CATCH_REQUIRE(result.size() == 6);
+            CATCH_REQUIRE(result.offsets() == std::vector<size_t>{0, 4, 4, 5, 6});
+            CATCH_REQUIRE(result.n_neighbors(0) == 4);
+            CATCH_REQUIRE(result.n_neighbors(1) == 0);
+            CATCH_REQUIRE(result.n_neighbors(2) == 1);
+            CATCH_REQUIRE(result.n_neighbors(3) == 1);
+
+            // Neighbors are sorted within each query.
+            auto expected = std::vector<size_t>{12, 11, 13, 10};
+            for (size_t j = 0; j < expected.size(); ++j) {
+                CATCH_REQUIRE(result.index(0, j) == expected[j]);
+            }
+            CATCH_REQUIRE(result.distance(0, 0) == 0.5f);
+            CATCH_REQUIRE(result.index(2, 0) == 20);
+            CATCH_REQUIRE(result.index(3, 0) == 30);
+            CATCH_REQUIRE(result.neighbors(1).empty());
+
+            // Partials are cleared and storage is reused.
+            CATCH_REQUIRE(result.partial(0).size() == 0);
+            if (iteration == 1) {
+                CATCH_REQUIRE(result.neighbors().data() == storage);
+            }
+            storage = result.neighbors().data();
+        }
+
+        // Similarities sort in decreasing order.
+        result.prepare(1, 1);
+        result.partial(0).push_back(0, Neighbor{1, 1.0f});
+        result.partial(0).push_back(0, Neighbor{2, 3.0f});
+        result.finish(std::greater<>());
+        CATCH_REQUIRE(result.index(0, 0) == 2);
+        CATCH_REQUIRE(result.index(0, 1) == 1);
+    }
+
+    CATCH_SECTION("Errors") {
+        auto result = svs::RangeSearchResult<size_t>();
+        result.prepare(2, 1);
+        result.partial(0).push_back(2, Neighbor{0, 0.0f});
+        CATCH_REQUIRE_THROWS_AS(result.finish(std::less<>()), svs::ANNException);
+        CATCH_REQUIRE_THROWS_AS(result.partial(1), std::out_of_range);
+    }
+}
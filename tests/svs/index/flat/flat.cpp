@@ -0,0 +1,171 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/flat/flat.h"
+
+// svs
+#include "svs/core/data.h"
+#include "svs/core/distance.h"
+#include "svs/core/range_result.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// tests
+#include "tests/utils/test_dataset.h"
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+CATCH_TEST_CASE("Flat Index Scratch Reuse", "[index][flat]") {
+    namespace flat = svs::index::flat;
+    auto queries = test_dataset::queries();
+    auto head = [&](size_t count) {
+        auto subset = svs::data::SimpleData<float>(count, queries.dimensions());
+        for (size_t i = 0; i < count; ++i) {
+            subset.set_datum(i, queries.get_datum(i));
+        }
+        return subset;
+    };
+    auto index =
+        flat::auto_assemble(test_dataset::data_f32(), svs::distance::DistanceL2(), 2);
+    CATCH_REQUIRE(index.get_inserter_kind() == flat::InserterKind::heap);
+
+    // Search with a fresh index to obtain the expected results.
+    auto expected = [&](size_t num_queries, size_t num_neighbors) {
+        auto fresh =
+            flat::auto_assemble(test_dataset::data_f32(), svs::distance::DistanceL2(), 2);
+        auto subset = head(num_queries);
+        auto result = svs::QueryResult<size_t>(num_queries, num_neighbors);
+        fresh.search(subset.cview(), num_neighbors, result.view());
+        return result;
+    };
+
+    // Vary the shape of the search so cached scratch space must be resized or rebuilt.
+    struct Setup {
+        size_t num_queries;
+        size_t num_neighbors;
+        flat::InserterKind kind;
+    };
+    auto setups = std::vector<Setup>{
+        {10, 5, flat::InserterKind::buffered},
+        {10, 5, flat::InserterKind::buffered},
+        {50, 5, flat::InserterKind::buffered},
+        {3, 10, flat::InserterKind::buffered},
+        {50, 10, flat::InserterKind::heap},
+        {20, 10, flat::InserterKind::linear},
+    };
+    for (const auto& setup : setups) {
+        index.set_inserter_kind(setup.kind);
+        auto subset = head(setup.num_queries);
+        auto result = svs::QueryResult<size_t>(setup.num_queries, setup.num_neighbors);
+        index.search(subset.cview(), setup.num_neighbors, result.view());
+
+        auto reference = expected(setup.num_queries, setup.num_neighbors);
+        for (size_t i = 0; i < setup.num_queries; ++i) {
+            for (size_t j = 0; j < setup.num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i, j) == reference.index(i, j));
+            }
+        }
+    }
+
+    // Searches keep working after the scratch space is released, either explicitly or
+    // because a search was too large to cache.
+    auto check = [&](size_t num_queries, size_t num_neighbors) {
+        auto subset = head(num_queries);
+        auto result = svs::QueryResult<size_t>(num_queries, num_neighbors);
+        index.search(subset.cview(), num_neighbors, result.view());
+        auto reference = expected(num_queries, num_neighbors);
+        for (size_t i = 0; i < num_queries; ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i, j) == reference.index(i, j));
+            }
+        }
+    };
+    // Far neighbors may tie, so use the same inserter as the reference.
+    index.set_inserter_kind(flat::InserterKind::heap);
+    index.clear_scratch();
+    check(10, 5);
+    const size_t large_num_neighbors =
+        decltype(index)::max_cached_neighbors / queries.size() + 1;
+    CATCH_REQUIRE(large_num_neighbors < index.size());
+    check(queries.size(), large_num_neighbors);
+    check(10, 5);
+}
+
+namespace {
+
+// Check range search against k-nearest neighbor search.
+template <typename Distance> void check_range_search(Distance distance) {
+    using compare = svs::distance::compare_t<Distance>;
+    const size_t num_neighbors = 64;
+    auto index = svs::index::flat::auto_assemble(test_dataset::data_f32(), distance, 2);
+    auto queries = test_dataset::queries();
+    auto knn = index.search(queries, num_neighbors);
+
+    // Choose a radius that includes about 10 neighbors per query.
+    auto tenth = std::vector<float>();
+    for (size_t i = 0; i < queries.size(); ++i) {
+        tenth.push_back(knn.distance(i, 9));
+    }
+    std::nth_element(tenth.begin(), tenth.begin() + tenth.size() / 2, tenth.end());
+    float radius = tenth.at(tenth.size() / 2);
+
+    auto result = svs::RangeSearchResult<size_t>();
+    // Search twice to exercise reuse of the result.
+    for (size_t iteration = 0; iteration < 2; ++iteration) {
+        index.range_search(queries, radius, result);
+        CATCH_REQUIRE(result.n_queries() == queries.size());
+        size_t total = 0;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto expected = std::vector<size_t>();
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                if (svs::within_radius<compare>(knn.distance(i, j), radius)) {
+                    expected.push_back(knn.index(i, j));
+                }
+            }
+
+            auto neighbors = result.neighbors(i);
+            total += neighbors.size();
+            auto found = std::vector<size_t>();
+            for (size_t j = 0; j < neighbors.size(); ++j) {
+                CATCH_REQUIRE(svs::within_radius<compare>(neighbors[j].distance(), radius));
+                if (j > 0) {
+                    CATCH_REQUIRE(!compare{}(
+                        neighbors[j].distance(), neighbors[j - 1].distance()
+                    ));
+                }
+                found.push_back(neighbors[j].id());
+            }
+
+            // The k-nearest neighbors only cover the radius if some were outside it.
+            if (expected.size() < num_neighbors) {
+                std::sort(expected.begin(), expected.end());
+                std::sort(found.begin(), found.end());
+                CATCH_REQUIRE(found == expected);
+            }
+        }
+        CATCH_REQUIRE(total == result.size());
+        CATCH_REQUIRE(total > 0);
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Flat Index Range Search", "[index][flat]") {
+    CATCH_SECTION("Euclidean") { check_range_search(svs::distance::DistanceL2()); }
+    CATCH_SECTION("Cosine") {
+        check_range_search(svs::distance::DistanceCosineSimilarity());
+    }
+}
@@ -11,10 +11,12 @@
 
 // stdlib
 #include <functional>
+#include <numeric>
 #include <type_traits>
 
 // svs
 #include "svs/index/flat/inserters.h"
+#include "svs/lib/neighbor.h"
 
 // catch2
 #include "catch2/catch_test_macros.hpp"
@@ -156,9 +158,39 @@ CATCH_TEST_CASE("Sorters", "[core][sorters]") {
         }
     }
 
+    CATCH_SECTION("Buffered Inserter") {
+        // Two results followed by a buffer for two candidates.
+        std::vector<int> x(4);
+        size_t size = 0;
+        int sentinel = std::numeric_limits<int>::max();
+        auto inserter =
+            svs::index::flat::BufferedInserter(x.begin(), x.end(), 2, size, std::less<>{});
+        inserter.prepare();
+        CATCH_REQUIRE(size == 2);
+        CATCH_REQUIRE(inserter.threshold() == sentinel);
+
+        // Filling the buffer triggers a selection, tightening the threshold.
+        inserter.insert(10);
+        inserter.insert(3);
+        CATCH_REQUIRE(size == 2);
+        CATCH_REQUIRE(inserter.threshold() == 10);
+
+        // Rejected by the threshold.
+        inserter.insert(11);
+        CATCH_REQUIRE(size == 2);
+
+        for (auto i : {7, 1, 8}) {
+            inserter.insert(i);
+        }
+        inserter.cleanup();
+        CATCH_REQUIRE(x.at(0) == 1);
+        CATCH_REQUIRE(x.at(1) == 3);
+    }
+
     CATCH_SECTION("Bulk Inserter") {
         auto inserter =
             svs::index::flat::BulkInserter<float, std::less<>>{200, 50, std::less{}};
+        CATCH_REQUIRE(inserter.kind() == svs::index::flat::InserterKind::heap);
         CATCH_REQUIRE(inserter.batch_size() == 200);
         CATCH_REQUIRE(inserter.num_neighbors() == 50);
         test_bulk_inserter(inserter);
@@ -187,4 +219,63 @@ CATCH_TEST_CASE("Sorters", "[core][sorters]") {
         CATCH_REQUIRE(inserter.num_neighbors() == 70);
         test_bulk_inserter(inserter);
     }
+
+    CATCH_SECTION("Bulk Inserter Kinds") {
+        using svs::index::flat::InserterKind;
+        auto kinds = {InserterKind::linear, InserterKind::heap, InserterKind::buffered};
+        for (auto kind : kinds) {
+            auto inserter = svs::index::flat::BulkInserter<float, std::greater<>>{
+                20, 50, std::greater{}, kind};
+            CATCH_REQUIRE(inserter.kind() == kind);
+            test_bulk_inserter(inserter);
+
+            inserter.resize_neighbors(1);
+            CATCH_REQUIRE(inserter.num_neighbors() == 1);
+            test_bulk_inserter(inserter);
+
+            inserter.resize(10, 200);
+            CATCH_REQUIRE(inserter.batch_size() == 10);
+            CATCH_REQUIRE(inserter.num_neighbors() == 200);
+            test_bulk_inserter(inserter);
+        }
+    }
+
+    CATCH_SECTION("Batched Insertion") {
+        using svs::index::flat::InserterKind;
+        using Neighbor = svs::Neighbor<size_t>;
+        auto generator = svs_test::make_generator<float>(0, 100);
+        auto distances = std::vector<float>();
+        svs_test::populate(distances, generator, 1000);
+        auto ids = std::vector<size_t>(distances.size());
+        std::iota(ids.begin(), ids.end(), 0);
+
+        auto expected = std::vector<Neighbor>();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            expected.push_back({ids[i], distances[i]});
+        }
+        std::sort(expected.begin(), expected.end(), std::less<>());
+
+        auto kinds = {InserterKind::linear, InserterKind::heap, InserterKind::buffered};
+        for (auto kind : kinds) {
+            for (size_t batch : {1, 7, 16, 100}) {
+                auto inserter = svs::index::flat::BulkInserter<Neighbor, std::less<>>{
+                    2, 10, std::less{}, kind};
+                inserter.prepare();
+                for (size_t j = 0; j < ids.size(); j += batch) {
+                    size_t count = std::min(batch, ids.size() - j);
+                    inserter.insert(
+                        1,
+                        std::span<const size_t>(ids.data() + j, count),
+                        std::span<const float>(distances.data() + j, count)
+                    );
+                }
+                inserter.cleanup();
+                auto result = inserter.result(1);
+                CATCH_REQUIRE(result.size() == 10);
+                for (size_t j = 0; j < result.size(); ++j) {
+                    CATCH_REQUIRE(result[j].id() == expected[j].id());
+                }
+            }
+        }
+    }
 }
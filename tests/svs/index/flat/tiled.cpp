@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// stdlib
+#include <span>
+#include <vector>
+
+// svs
+#include "svs/core/data.h"
+#include "svs/core/distance.h"
+#include "svs/index/flat/tiled.h"
+
+// catch2
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// test
+#include "tests/utils/generators.h"
+
+namespace {
+
+namespace flat = svs::index::flat;
+namespace dist = svs::distance;
+
+void test_inner_product_tile(size_t nq, size_t nx, size_t ndims) {
+    auto generator = svs_test::make_generator<float>(-1, 1);
+    auto make = [&](size_t count) {
+        auto vectors = std::vector<std::vector<float>>(count);
+        for (auto& v : vectors) {
+            svs_test::populate(v, generator, ndims);
+        }
+        return vectors;
+    };
+    auto pointers = [](const auto& vectors) {
+        auto ptrs = std::vector<const float*>();
+        for (const auto& v : vectors) {
+            ptrs.push_back(v.data());
+        }
+        return ptrs;
+    };
+
+    auto q = make(nq);
+    auto x = make(nx);
+    auto qptrs = pointers(q);
+    auto xptrs = pointers(x);
+
+    // Pad the leading dimension to check that it is honored.
+    const size_t ldo = nx + 3;
+    auto out = std::vector<float>(nq * ldo);
+    auto workspace = std::vector<float>();
+    auto approx = [](float v) { return Catch::Approx(v).epsilon(1e-4).margin(1e-4); };
+
+    const auto original = dist::active_isa();
+    for (auto isa :
+         {dist::ISA::generic, dist::ISA::avx2, dist::ISA::avx512f, dist::ISA::avx512vnni}) {
+        if (dist::set_active_isa(isa) != isa) {
+            break;
+        }
+        flat::inner_product_tile(qptrs, xptrs, ndims, out.data(), ldo, workspace);
+        for (size_t i = 0; i < nq; ++i) {
+            for (size_t j = 0; j < nx; ++j) {
+                auto expected = dist::IP::compute(q[i].data(), x[j].data(), ndims);
+                CATCH_REQUIRE(out[i * ldo + j] == approx(expected));
+            }
+        }
+    }
+    dist::set_active_isa(original);
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Tiled Flat Search", "[index][flat][tiled]") {
+    CATCH_SECTION("Traits") {
+        using Data = svs::data::SimpleData<float>;
+        using Data16 = svs::data::SimpleData<svs::Float16>;
+        static_assert(flat::use_tiled_search_v<Data, float, dist::DistanceL2>);
+        static_assert(flat::use_tiled_search_v<Data, float, dist::DistanceIP>);
+        using Cosine = dist::DistanceCosineSimilarity;
+        static_assert(!flat::use_tiled_search_v<Data, float, Cosine>);
+        static_assert(!flat::use_tiled_search_v<Data, svs::Float16, dist::DistanceL2>);
+        static_assert(!flat::use_tiled_search_v<Data16, float, dist::DistanceL2>);
+    }
+
+    CATCH_SECTION("Tile Sizes") {
+        for (size_t ndims : {1, 96, 128, 960, 100'000}) {
+            auto tile = flat::data_tile_size(ndims);
+            CATCH_REQUIRE(tile >= 32);
+            CATCH_REQUIRE(tile <= 256);
+            CATCH_REQUIRE(tile % 32 == 0);
+            CATCH_REQUIRE(flat::query_tile_size(ndims) >= 4);
+        }
+    }
+
+    CATCH_SECTION("Inner Product Tile") {
+        // Include shapes with ragged edges in both the query and data dimension.
+        for (size_t ndims : {3, 16, 43, 128}) {
+            test_inner_product_tile(1, 1, ndims);
+            test_inner_product_tile(4, 4, ndims);
+            test_inner_product_tile(7, 13, ndims);
+            test_inner_product_tile(16, 33, ndims);
+            test_inner_product_tile(17, 70, ndims);
+        }
+    }
+
+    CATCH_SECTION("Data Norms") {
+        const size_t ndims = 43;
+        auto data = svs::data::SimpleData<float>(100, ndims);
+        auto generator = svs_test::make_generator<float>(-1, 1);
+        auto buffer = std::vector<float>();
+        for (size_t i = 0; i < data.size(); ++i) {
+            svs_test::populate(buffer, generator, ndims);
+            data.set_datum(i, buffer);
+        }
+
+        // Norms are indexed relative to the start of the range.
+        auto range = svs::threads::UnitRange<size_t>(17, 80);
+        auto norms = std::vector<float>(range.size());
+        flat::compute_data_norms(data, range, std::span<float>(norms));
+        for (size_t i = 0; i < range.size(); ++i) {
+            auto datum = data.get_datum(range[i]);
+            CATCH_REQUIRE(norms[i] == dist::IP::compute(datum.data(), datum.data(), ndims));
+        }
+    }
+}
@@ -67,3 +67,30 @@ CATCH_TEST_CASE("Graph Consolidation", "[graph_index]") {
         check_post_conditions(graph, predicate);
     }
 }
+
+CATCH_TEST_CASE("Incremental Consolidation Hints", "[graph_index]") {
+    auto graph = test_dataset::graph();
+    auto data = test_dataset::data_f32();
+    auto consolidator = svs::index::vamana::IncrementalConsolidator<uint32_t>(100);
+    CATCH_REQUIRE(consolidator.max_hints() == 100);
+
+    // Hints beyond the limit are dropped.
+    for (uint32_t i = 0; i < 1000; ++i) {
+        consolidator.hint(i);
+    }
+    CATCH_REQUIRE(consolidator.num_hints() == 100);
+
+    // Repairing the hinted vertices consumes the hints, even without an active pass.
+    auto predicate = [](size_t i) { return (i % 10) == 0; };
+    auto progress = consolidator.step(
+        graph,
+        data,
+        svs::distance::DistanceL2(),
+        svs::index::vamana::ConsolidationParameters{0, graph.max_degree(), 1.2f},
+        svs::index::vamana::ConsolidationBudget{},
+        predicate
+    );
+    CATCH_REQUIRE(progress.visited == 100);
+    CATCH_REQUIRE(!progress.pass_complete);
+    CATCH_REQUIRE(consolidator.num_hints() == 0);
+}
@@ -0,0 +1,284 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+#include "svs/core/recall.h"
+#include "svs/index/vamana/dynamic_index.h"
+
+// tests
+#include "tests/utils/test_dataset.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t NUM_NEIGHBORS = 10;
+const size_t NUM_POINTS = 4000;
+// Every `CHURN_STRIDE`-th point is repeatedly deleted and re-inserted.
+const size_t CHURN_STRIDE = 10;
+
+template <typename Data> auto build_index(const Data& all_data) {
+    auto data = svs::data::BlockedData<float>(NUM_POINTS, all_data.dimensions());
+    auto ids = std::vector<size_t>(NUM_POINTS);
+    for (size_t i = 0; i < NUM_POINTS; ++i) {
+        data.set_datum(i, all_data.get_datum(i));
+        ids[i] = i;
+    }
+
+    auto parameters = svs::index::vamana::VamanaBuildParameters{1.2, 32, 64, 500, 2};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), ids, svs::distance::DistanceL2(), 2
+    );
+    index.set_search_window_size(40);
+    return index;
+}
+
+std::vector<size_t> churn_ids() {
+    auto churn = std::vector<size_t>();
+    for (size_t i = 0; i < NUM_POINTS; i += CHURN_STRIDE) {
+        churn.push_back(i);
+    }
+    return churn;
+}
+
+template <typename Data> svs::data::SimpleData<float> churn_points(const Data& all_data) {
+    auto churn = churn_ids();
+    auto points = svs::data::SimpleData<float>(churn.size(), all_data.dimensions());
+    for (size_t i = 0; i < churn.size(); ++i) {
+        points.set_datum(i, all_data.get_datum(churn[i]));
+    }
+    return points;
+}
+
+template <typename Index, typename Queries>
+svs::QueryResult<size_t> groundtruth(Index& index, const Queries& queries) {
+    auto result = svs::QueryResult<size_t>(queries.size(), NUM_NEIGHBORS);
+    index.exhaustive_search(queries.cview(), NUM_NEIGHBORS, result.view());
+    return result;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Concurrent Search and Mutation", "[graph_index][dynamic_index]") {
+    auto all_data = test_dataset::data_f32();
+    auto queries = test_dataset::queries();
+    auto churn = churn_ids();
+    auto churn_data = churn_points(all_data);
+    auto index = build_index(all_data);
+
+    // Groundtruth over the full dataset.
+    auto gt = groundtruth(index, queries);
+    auto recall = [&](const svs::QueryResult<size_t>& result) {
+        return svs::k_recall_at_n(gt, result, NUM_NEIGHBORS, NUM_NEIGHBORS);
+    };
+    const double baseline = recall(index.search(queries, NUM_NEIGHBORS));
+    std::cout << "Baseline recall: " << baseline << '\n';
+
+    CATCH_REQUIRE(!index.concurrent_mutation_enabled());
+    // Give each searcher its own partition of two threads.
+    index.enable_concurrent_mutation(4, 2);
+    CATCH_REQUIRE(index.concurrent_mutation_enabled());
+
+    std::atomic<bool> done = false;
+    std::mutex stats_mutex{};
+    double min_recall = 1.0;
+    size_t num_searches = 0;
+    bool ids_ok = true;
+
+    auto searcher = [&](bool own_pool) {
+        auto pool = svs::threads::SequentialThreadPool();
+        while (!done.load()) {
+            auto result = svs::QueryResult<size_t>(queries.size(), NUM_NEIGHBORS);
+            if (own_pool) {
+                index.search(queries.cview(), NUM_NEIGHBORS, result.view(), pool);
+            } else {
+                index.search(queries.cview(), NUM_NEIGHBORS, result.view());
+            }
+            double this_recall = recall(result);
+
+            bool this_ids_ok = true;
+            for (size_t i = 0; i < result.n_queries(); ++i) {
+                for (size_t j = 0; j < NUM_NEIGHBORS; ++j) {
+                    auto id = result.index(i, j);
+                    if (id >= NUM_POINTS && id != std::numeric_limits<size_t>::max()) {
+                        this_ids_ok = false;
+                    }
+                }
+            }
+
+            std::lock_guard lock{stats_mutex};
+            min_recall = std::min(min_recall, this_recall);
+            ids_ok = ids_ok && this_ids_ok;
+            ++num_searches;
+        }
+    };
+
+    auto searchers = std::vector<std::thread>();
+    for (size_t i = 0; i < 3; ++i) {
+        searchers.emplace_back(searcher, i == 2);
+    }
+
+    // Mutate while the searchers are running.
+    const size_t num_rounds = 4;
+    for (size_t round = 0; round < num_rounds; ++round) {
+        index.delete_entries(churn);
+        if (round % 2 == 0) {
+            index.consolidate();
+        }
+        index.add_points(churn_data, churn);
+    }
+    index.consolidate();
+    index.compact();
+    done.store(true);
+    for (auto& thread : searchers) {
+        thread.join();
+    }
+
+    std::cout << "Concurrent searches: " << num_searches << ", minimum recall "
+              << min_recall << '\n';
+    CATCH_REQUIRE(num_searches > 0);
+    CATCH_REQUIRE(ids_ok);
+    // At most a tenth of the dataset is missing at any one time.
+    CATCH_REQUIRE(min_recall > baseline - 0.15);
+
+    // Once the mutations have finished, the index should be as good as before.
+    index.debug_check_invariants(false);
+    CATCH_REQUIRE(index.size() == NUM_POINTS);
+    double final_recall = recall(index.search(queries, NUM_NEIGHBORS));
+    std::cout << "Final recall: " << final_recall << '\n';
+    CATCH_REQUIRE(final_recall > baseline - 0.05);
+
+    // Results should not depend on the search mode.
+    index.disable_concurrent_mutation();
+    CATCH_REQUIRE(recall(index.search(queries, NUM_NEIGHBORS)) == final_recall);
+}
+
+CATCH_TEST_CASE("Incremental Consolidation", "[graph_index][dynamic_index]") {
+    auto all_data = test_dataset::data_f32();
+    auto queries = test_dataset::queries();
+    auto churn = churn_ids();
+    auto churn_data = churn_points(all_data);
+    auto index = build_index(all_data);
+
+    auto gt = groundtruth(index, queries);
+    auto recall = [&](const svs::QueryResult<size_t>& result) {
+        return svs::k_recall_at_n(gt, result, NUM_NEIGHBORS, NUM_NEIGHBORS);
+    };
+    const double baseline = recall(index.search(queries, NUM_NEIGHBORS));
+
+    CATCH_SECTION("Bounded Steps") {
+        // Nothing to do.
+        CATCH_REQUIRE(index.consolidate_step());
+
+        index.delete_entries(churn);
+        auto budget = svs::index::vamana::ConsolidationBudget{.max_visited = 500};
+        size_t num_steps = 0;
+        while (!index.consolidate_step(budget)) {
+            ++num_steps;
+            // Deleted slots are only reclaimed once the whole pass completes.
+            index.debug_check_invariants(true);
+        }
+        // One sweep over the graph with at most 500 vertices per step.
+        CATCH_REQUIRE(num_steps >= NUM_POINTS / budget.max_visited);
+        index.debug_check_invariants(false);
+        CATCH_REQUIRE(index.size() == NUM_POINTS - churn.size());
+
+        // Reinsertion reuses the reclaimed slots.
+        auto slots = index.add_points(churn_data, churn);
+        CATCH_REQUIRE(std::all_of(slots.begin(), slots.end(), [](size_t slot) {
+            return slot < NUM_POINTS;
+        }));
+        index.debug_check_invariants(false);
+        CATCH_REQUIRE(recall(index.search(queries, NUM_NEIGHBORS)) > baseline - 0.05);
+    }
+
+    CATCH_SECTION("Deletes Between Steps") {
+        // Start a pass with the churn points as targets.
+        index.delete_entries(churn);
+        auto budget = svs::index::vamana::ConsolidationBudget{.max_visited = 50};
+        CATCH_REQUIRE(!index.consolidate_step(budget));
+
+        // Delete more points while the pass is running. These are not targets of the
+        // current pass, but remain reachable through the graph until the next pass and
+        // must not keep edges into slots reclaimed by this one.
+        auto late = std::vector<size_t>();
+        for (size_t i = CHURN_STRIDE / 2; i < NUM_POINTS; i += CHURN_STRIDE) {
+            late.push_back(i);
+        }
+        auto next = late.begin();
+        size_t num_steps = 0;
+        while (!index.consolidate_step(budget)) {
+            if (next != late.end()) {
+                auto stop = std::min(next + 20, late.end());
+                index.delete_entries(std::vector<size_t>(next, stop));
+                next = stop;
+            }
+            // No valid or deleted vertex may point at a reclaimed (empty) slot.
+            index.debug_check_invariants(true);
+            ++num_steps;
+        }
+        // The late deletions are reclaimed by a second pass.
+        CATCH_REQUIRE(next == late.end());
+        CATCH_REQUIRE(num_steps > 1);
+        index.debug_check_invariants(false);
+        CATCH_REQUIRE(index.size() == NUM_POINTS - churn.size() - late.size());
+
+        index.add_points(churn_data, churn);
+        index.debug_check_invariants(false);
+    }
+
+    CATCH_SECTION("Background Thread") {
+        // Background consolidation relies on the concurrent mutation mode.
+        CATCH_REQUIRE_THROWS_AS(index.start_background_consolidation(), svs::ANNException);
+
+        index.enable_concurrent_mutation();
+        index.start_background_consolidation(
+            svs::index::vamana::ConsolidationBudget{.max_visited = 200},
+            std::chrono::milliseconds(1)
+        );
+        CATCH_REQUIRE(index.background_consolidation_running());
+
+        double min_recall = 1.0;
+        for (size_t round = 0; round < 3; ++round) {
+            index.delete_entries(churn);
+            min_recall = std::min(min_recall, recall(index.search(queries, NUM_NEIGHBORS)));
+
+            // Wait for the background thread to reclaim every deleted slot so the points
+            // can be added back without growing the index.
+            auto no_work = svs::index::vamana::ConsolidationBudget{.max_visited = 0};
+            while (!index.consolidate_step(no_work)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            index.add_points(churn_data, churn);
+            min_recall = std::min(min_recall, recall(index.search(queries, NUM_NEIGHBORS)));
+        }
+        index.stop_background_consolidation();
+        CATCH_REQUIRE(!index.background_consolidation_running());
+
+        std::cout << "Minimum recall with background consolidation: " << min_recall
+                  << '\n';
+        CATCH_REQUIRE(min_recall > baseline - 0.15);
+        index.debug_check_invariants(false);
+        CATCH_REQUIRE(index.view_data().size() == NUM_POINTS);
+        CATCH_REQUIRE(recall(index.search(queries, NUM_NEIGHBORS)) > baseline - 0.05);
+    }
+}
@@ -27,8 +27,11 @@
 // stl
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <random>
 #include <sstream>
+#include <vector>
 
 using Idx = uint32_t;
 using Eltype = float;
@@ -320,10 +323,41 @@ CATCH_TEST_CASE("Testing Graph Index", "[graph_index][dynamic_index]") {
 
     test_loop(index, reference, queries, div(reference.size(), modify_fraction), 2, 6);
 
+    // Leave some deleted entries in the index to make sure they survive saving.
+    auto to_delete = std::vector<Idx>();
+    index.on_ids([&](size_t e) {
+        if (to_delete.size() < 10) {
+            to_delete.push_back(e);
+        }
+    });
+    auto deleted_internal = index.translate_external_id(to_delete.front());
+    index.delete_entries(to_delete);
+    auto num_slots = index.view_data().size();
+
+    // Use several entry points to make sure they all survive saving.
+    auto entry_points = std::vector<size_t>{index.entry_point()};
+    index.on_ids([&](size_t e) {
+        auto i = index.translate_external_id(e);
+        if (entry_points.size() < 4 && i != entry_points.front()) {
+            entry_points.push_back(i);
+        }
+    });
+    CATCH_REQUIRE_THROWS_AS(
+        index.set_entry_points(std::vector<size_t>{}), svs::ANNException
+    );
+    CATCH_REQUIRE_THROWS_AS(
+        index.set_entry_points(std::vector<size_t>{deleted_internal}), svs::ANNException
+    );
+    index.set_entry_points(entry_points);
+    CATCH_REQUIRE(index.get_entry_points().size() == 4);
+
     // Try saving the index.
     svs_test::prepare_temp_directory();
     auto tmp = svs_test::temp_directory();
     index.save(tmp / "config", tmp / "graph", tmp / "data");
+    // Saving should not consolidate or compact the index.
+    CATCH_REQUIRE(index.view_data().size() == num_slots);
+    index.debug_check_invariants(true);
 
     auto reloaded = svs::index::vamana::auto_dynamic_assemble(
         tmp / "config",
@@ -340,6 +374,128 @@ CATCH_TEST_CASE("Testing Graph Index", "[graph_index][dynamic_index]") {
         index.get_construction_window_size() == reloaded.get_construction_window_size()
     );
     CATCH_REQUIRE(index.size() == reloaded.size());
+    CATCH_REQUIRE(reloaded.view_data().size() == num_slots);
+    reloaded.debug_check_invariants(true);
     // ID's preserved across runs.
     index.on_ids([&](size_t e) { CATCH_REQUIRE(reloaded.has_id(e)); });
+    for (auto e : to_delete) {
+        CATCH_REQUIRE(!reloaded.has_id(e));
+    }
+
+    CATCH_REQUIRE(reloaded.get_entry_points() == index.get_entry_points());
+
+    // Deleted entries are reclaimed by the reloaded index. Deleted entry points other
+    // than the first are dropped.
+    reloaded.delete_entries(
+        std::vector<size_t>{reloaded.translate_internal_id(entry_points.back())}
+    );
+    reloaded.consolidate();
+    reloaded.compact();
+    reloaded.debug_check_invariants(false);
+    CATCH_REQUIRE(reloaded.size() == index.size() - 1);
+    CATCH_REQUIRE(reloaded.get_entry_points().size() == 3);
+}
+
+CATCH_TEST_CASE("Dynamic Index Early Termination", "[graph_index][dynamic_index]") {
+    const size_t num_points = 1000;
+    const size_t num_neighbors = 200;
+    const size_t offset = 1'000'000;
+    auto all_data = test_dataset::data_f32();
+    auto queries = test_dataset::queries();
+
+    // Offset the external IDs so results must be translated.
+    auto data = svs::data::BlockedData<float>(num_points, all_data.dimensions());
+    auto ids = std::vector<size_t>(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+        data.set_datum(i, all_data.get_datum(i));
+        ids[i] = offset + i;
+    }
+    auto parameters = svs::index::vamana::VamanaBuildParameters{1.2, 32, 64, 500, 2};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), ids, Distance(), 2
+    );
+    index.set_search_window_size(num_neighbors);
+
+    // Stopping after the first expansion finds at most `max_degree + 1` candidates.
+    index.set_early_termination({.max_distance_computations = 1});
+    auto check = [&]() {
+        auto result = index.search(queries, num_neighbors);
+        const auto invalid = std::numeric_limits<size_t>::max();
+        const auto worst = svs::type_traits::sentinel_v<float, std::less<>>;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            size_t found = 0;
+            while (found < num_neighbors && result.index(i, found) != invalid) {
+                CATCH_REQUIRE(result.index(i, found) >= offset);
+                CATCH_REQUIRE(result.index(i, found) < offset + num_points);
+                ++found;
+            }
+            CATCH_REQUIRE(found > 0);
+            CATCH_REQUIRE(found < num_neighbors);
+            for (size_t j = found; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i, j) == invalid);
+                CATCH_REQUIRE(result.distance(i, j) == worst);
+            }
+        }
+    };
+
+    check();
+    index.enable_concurrent_mutation();
+    check();
+    index.disable_concurrent_mutation();
+
+    // With fewer valid entries than requested neighbors, exhaustive search pads with the
+    // maximum of the result's ID type, which must survive translation.
+    const size_t num_kept = 100;
+    index.delete_entries(std::vector<size_t>(ids.begin() + num_kept, ids.end()));
+    auto result = svs::QueryResult<uint32_t>(queries.size(), num_neighbors);
+    index.exhaustive_search(queries.cview(), num_neighbors, result.view());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_kept; ++j) {
+            CATCH_REQUIRE(result.index(i, j) >= offset);
+            CATCH_REQUIRE(result.index(i, j) < offset + num_kept);
+        }
+        for (size_t j = num_kept; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == std::numeric_limits<uint32_t>::max());
+        }
+    }
+}
+
+CATCH_TEST_CASE("Dynamic Index Multiple Entry Points", "[graph_index][dynamic_index]") {
+    const size_t num_points = 1000;
+    auto all_data = test_dataset::data_f32();
+    auto queries = test_dataset::queries();
+
+    auto data = svs::data::BlockedData<float>(num_points, all_data.dimensions());
+    auto ids = std::vector<size_t>(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+        data.set_datum(i, all_data.get_datum(i));
+        ids[i] = i;
+    }
+    auto parameters = svs::index::vamana::VamanaBuildParameters{1.2, 32, 64, 500, 2};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), ids, Distance(), 2
+    );
+    index.set_search_window_size(NUM_NEIGHBORS);
+
+    auto groundtruth = svs::QueryResult<size_t>(queries.size(), NUM_NEIGHBORS);
+    index.exhaustive_search(queries.cview(), NUM_NEIGHBORS, groundtruth.view());
+    auto single_recall =
+        svs::k_recall_at_n(groundtruth, index.search(queries, NUM_NEIGHBORS));
+
+    // Use many more entry points than the search window holds. Each search starts from
+    // the nearest one, so recall should not degrade.
+    auto entry_points = std::vector<size_t>{index.entry_point()};
+    for (size_t i = 0; i < num_points && entry_points.size() < 64; i += 15) {
+        if (i != entry_points.front()) {
+            entry_points.push_back(i);
+        }
+    }
+    index.set_entry_points(entry_points);
+    auto result = index.search(queries, NUM_NEIGHBORS);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < NUM_NEIGHBORS; ++j) {
+            CATCH_REQUIRE(result.index(i, j) < num_points);
+        }
+    }
+    CATCH_REQUIRE(svs::k_recall_at_n(groundtruth, result) >= 0.95 * single_recall);
 }
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+// Distance implementations must be visible before the qualified ``distance::compute``
+// calls in the header under test.
+#include "svs/core/distance.h"
+#include "svs/index/vamana/greedy_search.h"
+#include "svs/index/vamana/search_tracker.h"
+
+// tests
+#include "tests/utils/test_dataset.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <array>
+#include <vector>
+
+namespace vamana = svs::index::vamana;
+
+CATCH_TEST_CASE("Greedy Search", "[vamana][greedy_search]") {
+    static_assert(vamana::GreedySearchTracker<vamana::SearchTracker<uint32_t>, uint32_t>);
+    static_assert(vamana::GreedySearchSkipTracker<vamana::SearchTracker<uint32_t>>);
+    static_assert(!vamana::GreedySearchSkipTracker<vamana::NullTracker>);
+
+    CATCH_SECTION("Scored Neighbors Are Skipped") {
+        auto graph = test_dataset::graph();
+        auto data = test_dataset::data_f32();
+        const auto queries = test_dataset::queries();
+        auto distance = svs::distance::DistanceL2();
+        auto entry_point = std::array<uint32_t, 1>{0};
+
+        const size_t window_size = 20;
+        auto baseline = vamana::SearchBuffer<uint32_t>(window_size);
+        auto buffer = vamana::SearchBuffer<uint32_t>(window_size, std::less<>(), true);
+        buffer.reserve_visited(data.size());
+
+        size_t total_skipped = 0;
+        for (size_t i = 0; i < 50; ++i) {
+            auto query = queries.get_datum(i);
+            auto baseline_tracker = vamana::SearchTracker<uint32_t>();
+            vamana::greedy_search(
+                graph,
+                data,
+                query,
+                distance,
+                baseline,
+                entry_point,
+                vamana::NeighborBuilder(),
+                baseline_tracker
+            );
+            // Without the visited set, nothing can be skipped.
+            CATCH_REQUIRE(baseline_tracker.n_skipped_distance_computations() == 0);
+            CATCH_REQUIRE(baseline_tracker.n_skipped_prefetches() == 0);
+
+            auto tracker = vamana::SearchTracker<uint32_t>();
+            vamana::greedy_search(
+                graph,
+                data,
+                query,
+                distance,
+                buffer,
+                entry_point,
+                vamana::NeighborBuilder(),
+                tracker
+            );
+            total_skipped += tracker.n_skipped_distance_computations();
+
+            // Skipping previously scored neighbors must not change the results.
+            CATCH_REQUIRE(baseline.size() == buffer.size());
+            for (size_t j = 0; j < buffer.size(); ++j) {
+                CATCH_REQUIRE(baseline[j].id() == buffer[j].id());
+                CATCH_REQUIRE(baseline[j].distance() == buffer[j].distance());
+            }
+            CATCH_REQUIRE(tracker.accessed_points() == baseline_tracker.accessed_points());
+            // Skipped neighbors do not count as distance computations.
+            CATCH_REQUIRE(
+                tracker.n_distance_computations() +
+                    tracker.n_skipped_distance_computations() ==
+                baseline_tracker.n_distance_computations()
+            );
+        }
+        CATCH_REQUIRE(total_skipped > 0);
+    }
+}
@@ -0,0 +1,862 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/index.h"
+#include "svs/index/vamana/search_tracker.h"
+
+// svs
+#include "svs/core/range_result.h"
+#include "svs/core/recall.h"
+#include "svs/lib/bitset.h"
+#include "svs/lib/saveload.h"
+
+// tests
+#include "tests/utils/test_dataset.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vamana = svs::index::vamana;
+
+CATCH_TEST_CASE("Vamana Work Stealing", "[vamana][index]") {
+    const size_t num_neighbors = 10;
+    auto queries = test_dataset::queries();
+    auto groundtruth = test_dataset::groundtruth_euclidean();
+    auto build = [&](bool work_stealing) {
+        auto parameters =
+            vamana::VamanaBuildParameters{1.2, 32, 64, 500, 3, true, work_stealing};
+        CATCH_REQUIRE(parameters.work_stealing == work_stealing);
+        auto index = vamana::auto_build(
+            parameters,
+            test_dataset::data_f32(),
+            svs::distance::DistanceL2(),
+            3,
+            svs::HugepageAllocator()
+        );
+        index.set_search_window_size(num_neighbors);
+        return index;
+    };
+    auto recall = [&](const auto& result) {
+        return svs::k_recall_at_n(groundtruth, result, num_neighbors, num_neighbors);
+    };
+
+    auto index = build(false);
+    auto expected = index.search(queries, num_neighbors);
+
+    // Scheduling does not change the results of the search.
+    CATCH_REQUIRE(!index.get_work_stealing());
+    index.set_work_stealing(true);
+    CATCH_REQUIRE(index.get_work_stealing());
+    auto result = index.search(queries, num_neighbors);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+        }
+    }
+
+    // Threads insert vertices in a different order, so only require similar quality.
+    auto stolen = build(true);
+    double baseline = recall(expected);
+    CATCH_REQUIRE(recall(stolen.search(queries, num_neighbors)) > baseline - 0.05);
+}
+
+CATCH_TEST_CASE("Vamana Concurrent Search", "[vamana][index]") {
+    const size_t num_neighbors = 10;
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    index.set_search_window_size(20);
+    auto expected = index.search(queries, num_neighbors);
+
+    auto check = [&](const auto& result, size_t start, size_t stop) {
+        for (size_t i = start; i < stop; ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i - start, j) == expected.index(i, j));
+            }
+        }
+    };
+
+    CATCH_SECTION("Caller Threaded") {
+        auto buffer = index.scratchspace(num_neighbors);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            index.search_single(queries.get_datum(i), buffer);
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(buffer[j].id() == expected.index(i, j));
+            }
+        }
+
+        auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        auto pool = svs::threads::SequentialThreadPool();
+        index.search(queries, num_neighbors, result.view(), pool);
+        check(result, 0, queries.size());
+    }
+
+    CATCH_SECTION("Concurrent Batches") {
+        // Split the queries into batches searched concurrently from several threads
+        // sharing one partitioned thread pool.
+        const size_t num_callers = 4;
+        auto pool = svs::threads::PartitionedThreadPool(4, 2);
+        auto results = std::vector<svs::QueryResult<size_t>>();
+        auto batches = std::vector<svs::data::SimpleData<float>>();
+        for (size_t i = 0; i < num_callers; ++i) {
+            auto range = svs::threads::balance(queries.size(), num_callers, i);
+            auto& batch = batches.emplace_back(range.size(), queries.dimensions());
+            for (auto j : range) {
+                batch.set_datum(j - range.start(), queries.get_datum(j));
+            }
+            results.emplace_back(range.size(), num_neighbors);
+        }
+
+        auto callers = std::vector<std::thread>();
+        for (size_t i = 0; i < num_callers; ++i) {
+            callers.emplace_back([&, i]() {
+                auto lease = pool.acquire();
+                index.search(batches.at(i), num_neighbors, results.at(i).view(), lease);
+            });
+        }
+        for (auto& thread : callers) {
+            thread.join();
+        }
+        for (size_t i = 0; i < num_callers; ++i) {
+            auto range = svs::threads::balance(queries.size(), num_callers, i);
+            check(results.at(i), range.start(), range.stop());
+        }
+    }
+}
+
+CATCH_TEST_CASE("Vamana Scratch Reuse", "[vamana][index]") {
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+
+    // Scratch space cached by earlier searches must pick up changes to the search
+    // parameters.
+    for (size_t window_size : {20, 40, 10}) {
+        for (bool visited_set : {false, true}) {
+            index.set_search_window_size(window_size);
+            visited_set ? index.enable_visited_set() : index.disable_visited_set();
+            for (size_t num_neighbors : {size_t{10}, window_size + 5}) {
+                auto result = index.search(queries, num_neighbors);
+                auto buffer = index.scratchspace(num_neighbors);
+                CATCH_REQUIRE(buffer.capacity() == std::max(window_size, num_neighbors));
+                CATCH_REQUIRE(buffer.visited_set_enabled() == visited_set);
+                for (size_t i = 0; i < queries.size(); ++i) {
+                    index.search_single(queries.get_datum(i), buffer);
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        CATCH_REQUIRE(result.index(i, j) == buffer[j].id());
+                    }
+                }
+            }
+        }
+    }
+
+    // Bring an old buffer up to date.
+    index.set_search_window_size(30);
+    index.disable_visited_set();
+    auto buffer = index.scratchspace();
+    index.set_search_window_size(50);
+    index.enable_visited_set();
+    index.update_scratchspace(buffer);
+    CATCH_REQUIRE(buffer.capacity() == 50);
+    CATCH_REQUIRE(buffer.visited_set_enabled());
+}
+
+CATCH_TEST_CASE("Vamana Early Termination", "[vamana][index]") {
+    const size_t num_neighbors = 10;
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    index.set_search_window_size(50);
+    auto expected = index.search(queries, num_neighbors);
+
+    auto terminations = std::vector<vamana::SearchTermination>(queries.size());
+    auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    auto search = [&]() {
+        std::fill(
+            terminations.begin(), terminations.end(), vamana::SearchTermination::stalled
+        );
+        index.search(queries, num_neighbors, result.view(), terminations);
+    };
+    // Return the number of searches that ended for reason ``reason``.
+    auto count = [&](vamana::SearchTermination reason) {
+        return std::count(terminations.begin(), terminations.end(), reason);
+    };
+    auto num_queries = static_cast<ptrdiff_t>(queries.size());
+
+    // By default, every search runs to convergence.
+    CATCH_REQUIRE(!index.get_early_termination().enabled());
+    search();
+    CATCH_REQUIRE(count(vamana::SearchTermination::converged) == num_queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+        }
+    }
+
+    CATCH_SECTION("Stalled") {
+        index.set_early_termination({.max_stalled_expansions = 2});
+        CATCH_REQUIRE(index.get_early_termination().max_stalled_expansions == 2);
+        search();
+        auto stalled = count(vamana::SearchTermination::stalled);
+        CATCH_REQUIRE(stalled > 0);
+        CATCH_REQUIRE(stalled + count(vamana::SearchTermination::converged) == num_queries);
+
+        // Stopping early loses some, but not most, of the recall.
+        auto groundtruth = test_dataset::groundtruth_euclidean();
+        double baseline =
+            svs::k_recall_at_n(groundtruth, expected, num_neighbors, num_neighbors);
+        double recall =
+            svs::k_recall_at_n(groundtruth, result, num_neighbors, num_neighbors);
+        CATCH_REQUIRE(recall <= baseline);
+        CATCH_REQUIRE(recall > baseline / 2);
+    }
+
+    CATCH_SECTION("Distance Budget") {
+        index.set_early_termination({.max_distance_computations = 100});
+        search();
+        CATCH_REQUIRE(count(vamana::SearchTermination::distance_budget) == num_queries);
+
+        // The budget is overshot by at most one expansion.
+        auto buffer = index.scratchspace(num_neighbors);
+        auto tracker = vamana::NullTracker();
+        auto data = test_dataset::data_f32();
+        auto distance = svs::distance::DistanceL2();
+        auto graph = test_dataset::graph();
+        auto termination = vamana::greedy_search(
+            graph,
+            data,
+            queries.get_datum(0),
+            distance,
+            buffer,
+            std::vector<uint32_t>{0},
+            vamana::NeighborBuilder(),
+            tracker,
+            vamana::EarlyTermination{.max_distance_computations = 1},
+            num_neighbors
+        );
+        CATCH_REQUIRE(termination == vamana::SearchTermination::distance_budget);
+        CATCH_REQUIRE(buffer.size() <= graph.max_degree() + 1);
+    }
+
+    CATCH_SECTION("Partial Results") {
+        // Stopping after the first expansion finds at most `max_degree + 1` candidates,
+        // fewer than the number of requested neighbors.
+        const size_t many_neighbors = 200;
+        CATCH_REQUIRE(test_dataset::graph().max_degree() + 1 < many_neighbors);
+        index.set_early_termination({.max_distance_computations = 1});
+        auto partial = svs::QueryResult<size_t>(queries.size(), many_neighbors);
+        index.search(queries, many_neighbors, partial.view());
+
+        // Slots past the candidates found hold the invalid ID and the worst distance.
+        const auto invalid = std::numeric_limits<size_t>::max();
+        const auto worst = svs::type_traits::sentinel_v<float, std::less<>>;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            size_t found = 0;
+            while (found < many_neighbors && partial.index(i, found) != invalid) {
+                CATCH_REQUIRE(partial.index(i, found) < index.size());
+                ++found;
+            }
+            CATCH_REQUIRE(found > 0);
+            CATCH_REQUIRE(found < many_neighbors);
+            for (size_t j = found; j < many_neighbors; ++j) {
+                CATCH_REQUIRE(partial.index(i, j) == invalid);
+                CATCH_REQUIRE(partial.distance(i, j) == worst);
+            }
+        }
+    }
+
+    CATCH_SECTION("Time Budget") {
+        index.set_early_termination({.max_time = std::chrono::microseconds(1)});
+        search();
+        auto timed_out = count(vamana::SearchTermination::time_budget);
+        CATCH_REQUIRE(timed_out > 0);
+        CATCH_REQUIRE(
+            timed_out + count(vamana::SearchTermination::converged) == num_queries
+        );
+    }
+
+    CATCH_SECTION("Single Query") {
+        index.set_early_termination({.max_distance_computations = 100});
+        auto buffer = index.scratchspace(num_neighbors);
+        auto termination = index.search_single(queries.get_datum(0), buffer);
+        CATCH_REQUIRE(termination == vamana::SearchTermination::distance_budget);
+        CATCH_REQUIRE(vamana::terminated_early(termination));
+        CATCH_REQUIRE(vamana::search_termination_name(termination) == "distance_budget");
+    }
+
+    CATCH_SECTION("Errors") {
+        auto wrong_size = std::vector<vamana::SearchTermination>(queries.size() - 1);
+        CATCH_REQUIRE_THROWS_AS(
+            index.search(queries, num_neighbors, result.view(), wrong_size),
+            svs::ANNException
+        );
+    }
+
+    // Disabling the criteria restores the original results.
+    index.set_early_termination({});
+    search();
+    CATCH_REQUIRE(count(vamana::SearchTermination::converged) == num_queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+        }
+    }
+}
+
+CATCH_TEST_CASE("Vamana Filtered Search", "[vamana][index]") {
+    const size_t num_neighbors = 10;
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    index.set_search_window_size(30);
+    auto exhaustive = svs::index::flat::auto_assemble(
+        test_dataset::data_f32(), svs::distance::DistanceL2(), 2
+    );
+
+    auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    auto check = [&](const auto& filter, double min_recall) {
+        auto groundtruth = exhaustive.search(queries, num_neighbors, [&](size_t i) {
+            return filter(i);
+        });
+        index.search(queries, num_neighbors, result.view(), filter);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                // The bounded window may miss accepted elements for selective filters.
+                auto id = result.index(i, j);
+                CATCH_REQUIRE((id == std::numeric_limits<size_t>::max() || filter(id)));
+            }
+        }
+        auto recall =
+            svs::k_recall_at_n(groundtruth, result, num_neighbors, num_neighbors);
+        CATCH_REQUIRE(recall >= min_recall);
+    };
+
+    // Filters of decreasing selectivity. The search window grows to find enough
+    // accepted elements, so recall holds up even when few elements pass the filter.
+    for (size_t stride : {2, 10, 100}) {
+        auto bits = svs::lib::Bitset(index.size());
+        for (size_t i = 0; i < bits.size(); i += stride) {
+            bits.set(i);
+        }
+        check(bits, 0.9);
+    }
+
+    // Arbitrary predicates.
+    auto predicate = [](size_t i) { return i % 3 == 1; };
+    check(predicate, 0.9);
+
+    // Searching on an explicit thread pool gives the same results and reports how each
+    // search ended.
+    auto sequential = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    auto pool = svs::threads::SequentialThreadPool();
+    auto terminations = std::vector<vamana::SearchTermination>(
+        queries.size(), vamana::SearchTermination::stalled
+    );
+    index.search(queries, num_neighbors, sequential.view(), predicate, pool, terminations);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(sequential.index(i, j) == result.index(i, j));
+        }
+    }
+    CATCH_REQUIRE(std::all_of(terminations.begin(), terminations.end(), [](auto t) {
+        return t == vamana::SearchTermination::converged;
+    }));
+    CATCH_REQUIRE_THROWS_AS(
+        index.search(
+            queries,
+            num_neighbors,
+            sequential.view(),
+            predicate,
+            std::span(terminations).first(1)
+        ),
+        svs::ANNException
+    );
+
+    // Fewer accepted elements than requested neighbors. Finding all of them requires
+    // exploring the whole graph, so lift the limit on the window.
+    const size_t default_factor = index.get_filtered_window_factor();
+    CATCH_REQUIRE(default_factor == decltype(index)::default_filtered_window_factor);
+    index.set_filtered_window_factor(std::numeric_limits<size_t>::max());
+    auto bits = svs::lib::Bitset(index.size());
+    for (size_t i : {5, 50, 500}) {
+        bits.set(i);
+    }
+    index.search(queries, num_neighbors, result.view(), bits);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto found = std::vector<size_t>();
+        for (size_t j = 0; j < 3; ++j) {
+            found.push_back(result.index(i, j));
+        }
+        std::sort(found.begin(), found.end());
+        CATCH_REQUIRE(found == std::vector<size_t>{5, 50, 500});
+        for (size_t j = 3; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == std::numeric_limits<size_t>::max());
+        }
+    }
+
+    // A filter accepting nothing must not explore the whole graph.
+    index.set_filtered_window_factor(0);
+    CATCH_REQUIRE(index.get_filtered_window_factor() == 1);
+    index.set_filtered_window_factor(default_factor);
+    auto nothing = svs::lib::Bitset(index.size());
+    index.search(queries, num_neighbors, result.view(), nothing);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == std::numeric_limits<size_t>::max());
+        }
+    }
+
+    // The number of vertices expanded is bounded by the size of the window rather than
+    // the size of the graph.
+    auto graph = test_dataset::graph();
+    auto data = test_dataset::data_f32();
+    auto expansions = [&](size_t limit) {
+        auto buffer = vamana::MutableBuffer<uint32_t>(num_neighbors, std::less<>(), true);
+        buffer.set_size_limit(limit);
+        buffer.reserve_visited(data.size());
+        auto tracker = vamana::SearchTracker<uint32_t>();
+        auto distance = svs::distance::DistanceL2();
+        vamana::greedy_search(
+            graph,
+            data,
+            queries.get_datum(0),
+            distance,
+            buffer,
+            std::vector<uint32_t>{0},
+            vamana::FilterBuilder{nothing},
+            tracker
+        );
+        CATCH_REQUIRE(buffer.size() <= std::max(limit, num_neighbors));
+        return tracker.n_hops();
+    };
+    auto unlimited = expansions(std::numeric_limits<size_t>::max());
+    auto limited = expansions(20 * num_neighbors);
+    CATCH_REQUIRE(unlimited > data.size() / 2);
+    CATCH_REQUIRE(limited < unlimited / 4);
+
+    // The visited set and search window of unfiltered search are unaffected.
+    CATCH_REQUIRE(index.get_search_window_size() == 30);
+    CATCH_REQUIRE(!index.visited_set_enabled());
+}
+
+CATCH_TEST_CASE("Vamana Range Search", "[vamana][index]") {
+    using compare = std::less<>;
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    index.set_search_window_size(20);
+    auto exhaustive = svs::index::flat::auto_assemble(
+        test_dataset::data_f32(), svs::distance::DistanceL2(), 2
+    );
+
+    // Choose a radius that includes about 50 neighbors per query, more than fit in the
+    // search window.
+    auto knn = exhaustive.search(queries, 50);
+    auto radii = std::vector<float>();
+    for (size_t i = 0; i < queries.size(); ++i) {
+        radii.push_back(knn.distance(i, 49));
+    }
+    std::nth_element(radii.begin(), radii.begin() + radii.size() / 2, radii.end());
+    float radius = radii.at(radii.size() / 2);
+
+    auto expected = svs::RangeSearchResult<size_t>();
+    exhaustive.range_search(queries, radius, expected);
+
+    auto result = svs::RangeSearchResult<size_t>();
+    const size_t max_neighbors = 1'000;
+    index.range_search(queries, radius, max_neighbors, result);
+    CATCH_REQUIRE(result.n_queries() == queries.size());
+    size_t num_found = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto neighbors = result.neighbors(i);
+        auto reference = expected.neighbors(i);
+        CATCH_REQUIRE(neighbors.size() <= reference.size());
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            CATCH_REQUIRE(svs::within_radius<compare>(neighbors[j].distance(), radius));
+            if (j > 0) {
+                CATCH_REQUIRE(neighbors[j - 1].distance() <= neighbors[j].distance());
+                CATCH_REQUIRE(neighbors[j - 1].id() != neighbors[j].id());
+            }
+        }
+        num_found += neighbors.size();
+    }
+    // Most of the neighbors within the radius are found, well beyond the search window.
+    CATCH_REQUIRE(num_found > 0.95 * expected.size());
+    CATCH_REQUIRE(expected.size() > 20 * queries.size());
+
+    // The limit stops the expansion early and caps the number of neighbors per query.
+    auto capped = svs::RangeSearchResult<size_t>();
+    index.range_search(queries, radius, 5, capped);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CATCH_REQUIRE(capped.n_neighbors(i) == std::min<size_t>(result.n_neighbors(i), 5));
+        for (size_t j = 0; j < capped.n_neighbors(i); ++j) {
+            CATCH_REQUIRE(svs::within_radius<compare>(capped.distance(i, j), radius));
+        }
+    }
+
+    // Searching on another thread pool finds the same neighbors.
+    auto pool = svs::threads::SequentialThreadPool();
+    auto sequential = svs::RangeSearchResult<size_t>();
+    index.range_search(queries, radius, max_neighbors, sequential, pool);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CATCH_REQUIRE(sequential.n_neighbors(i) == result.n_neighbors(i));
+        for (size_t j = 0; j < sequential.n_neighbors(i); ++j) {
+            CATCH_REQUIRE(sequential.index(i, j) == result.index(i, j));
+            CATCH_REQUIRE(sequential.distance(i, j) == result.distance(i, j));
+        }
+    }
+
+    CATCH_REQUIRE_THROWS_AS(
+        index.range_search(queries, radius, 0, result), svs::ANNException
+    );
+}
+
+CATCH_TEST_CASE("Vamana Entry Points", "[vamana][index]") {
+    auto queries = test_dataset::queries();
+    auto groundtruth = test_dataset::groundtruth_euclidean();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    index.set_search_window_size(10);
+    const size_t num_neighbors = 10;
+
+    // Return the mean number of hops per query and the recall.
+    auto measure = [&]() {
+        auto buffer = index.scratchspace();
+        auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        size_t hops = 0;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto tracker = vamana::SearchTracker<uint32_t>();
+            index.search_single(queries.get_datum(i), buffer, tracker);
+            hops += tracker.n_hops();
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                result.index(i, j) = buffer[j].id();
+                result.distance(i, j) = buffer[j].distance();
+            }
+        }
+        return std::make_pair(
+            static_cast<double>(hops) / queries.size(),
+            svs::k_recall_at_n(groundtruth, result, num_neighbors, num_neighbors)
+        );
+    };
+
+    CATCH_REQUIRE(index.get_entry_points() == std::vector<uint32_t>{0});
+    auto [hops_single, recall_single] = measure();
+    CATCH_REQUIRE(hops_single > 0);
+
+    index.learn_entry_points(svs::KMeansParameters{64, 1'000, 2});
+    const auto& entry_points = index.get_entry_points();
+    CATCH_REQUIRE(entry_points.size() > 1);
+    CATCH_REQUIRE(entry_points.size() <= 65);
+    CATCH_REQUIRE(entry_points.front() == 0);
+    for (auto id : entry_points) {
+        CATCH_REQUIRE(id < index.size());
+    }
+
+    // Starting near the query shortens the walk through the graph.
+    auto [hops_learned, recall_learned] = measure();
+    CATCH_REQUIRE(hops_learned < hops_single);
+    CATCH_REQUIRE(recall_learned > recall_single - 0.02);
+
+    // Batch search picks the entry points up as well.
+    auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    index.search(queries, num_neighbors, result.view());
+    CATCH_REQUIRE(
+        svs::k_recall_at_n(groundtruth, result, num_neighbors, num_neighbors) ==
+        recall_learned
+    );
+
+    index.set_entry_points(std::vector<size_t>{0});
+    CATCH_REQUIRE(measure().first == hops_single);
+
+    CATCH_REQUIRE_THROWS_AS(
+        index.set_entry_points(std::vector<size_t>{}), svs::ANNException
+    );
+    CATCH_REQUIRE_THROWS_AS(
+        index.set_entry_points(std::vector<size_t>{0, index.size()}), svs::ANNException
+    );
+    CATCH_REQUIRE(index.get_entry_points() == std::vector<uint32_t>{0});
+}
+
+CATCH_TEST_CASE("Vamana Interleaved Search", "[vamana][index]") {
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    const size_t num_neighbors = 10;
+    index.set_search_window_size(20);
+    CATCH_REQUIRE(index.get_interleaved_queries() == 1);
+
+    // Interleaving only changes the order of work, so results must match exactly.
+    auto check = [&]() {
+        auto expected = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        auto expected_terminations =
+            std::vector<vamana::SearchTermination>(queries.size());
+        index.set_interleaved_queries(1);
+        index.search(queries, num_neighbors, expected.view(), expected_terminations);
+
+        for (size_t count : {2, 4, 16}) {
+            index.set_interleaved_queries(count);
+            CATCH_REQUIRE(index.get_interleaved_queries() == count);
+            auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+            auto terminations = std::vector<vamana::SearchTermination>(queries.size());
+            index.search(queries, num_neighbors, result.view(), terminations);
+            for (size_t i = 0; i < queries.size(); ++i) {
+                for (size_t j = 0; j < num_neighbors; ++j) {
+                    CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+                    CATCH_REQUIRE(result.distance(i, j) == expected.distance(i, j));
+                }
+            }
+            CATCH_REQUIRE(terminations == expected_terminations);
+        }
+    };
+
+    CATCH_SECTION("Default") { check(); }
+    CATCH_SECTION("Visited Set and Work Stealing") {
+        index.enable_visited_set();
+        index.set_work_stealing(true);
+        check();
+    }
+    CATCH_SECTION("Early Termination") {
+        auto criteria = vamana::EarlyTermination{};
+        criteria.max_distance_computations = 200;
+        index.set_early_termination(criteria);
+        check();
+    }
+    CATCH_SECTION("Entry Points") {
+        index.set_entry_points(std::vector<size_t>{0, 100, 1000, 5000});
+        check();
+    }
+
+    index.set_interleaved_queries(0);
+    CATCH_REQUIRE(index.get_interleaved_queries() == 1);
+}
+
+CATCH_TEST_CASE("Vamana Interleaved Search Duplicate Neighbors", "[vamana][index]") {
+    // Repeat the first neighbor of each vertex. With the visited set enabled, repeated
+    // neighbors must be scored (and counted towards the distance budget) only once.
+    auto graph = test_dataset::graph();
+    for (size_t i = 0; i < graph.n_nodes(); ++i) {
+        auto neighbors = std::vector<uint32_t>{};
+        for (auto id : graph.get_node(i)) {
+            neighbors.push_back(id);
+        }
+        if (!neighbors.empty() && neighbors.size() < graph.max_degree()) {
+            neighbors.push_back(neighbors.front());
+            graph.replace_node(i, neighbors);
+        }
+    }
+
+    auto queries = test_dataset::queries();
+    auto index = vamana::VamanaIndex{
+        std::move(graph), test_dataset::data_f32(), 0, svs::distance::DistanceL2(), 2};
+    const size_t num_neighbors = 10;
+    index.set_search_window_size(20);
+    index.enable_visited_set();
+    auto criteria = vamana::EarlyTermination{};
+    criteria.max_distance_computations = 200;
+    index.set_early_termination(criteria);
+
+    auto expected = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    auto expected_terminations = std::vector<vamana::SearchTermination>(queries.size());
+    index.search(queries, num_neighbors, expected.view(), expected_terminations);
+
+    index.set_interleaved_queries(4);
+    auto result = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    auto terminations = std::vector<vamana::SearchTermination>(queries.size());
+    index.search(queries, num_neighbors, result.view(), terminations);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+            CATCH_REQUIRE(result.distance(i, j) == expected.distance(i, j));
+        }
+    }
+    CATCH_REQUIRE(terminations == expected_terminations);
+}
+
+CATCH_TEST_CASE("Vamana Config Entry Points", "[vamana][index][save_load]") {
+    auto index = vamana::VamanaIndex{
+        test_dataset::graph(),
+        test_dataset::data_f32(),
+        0,
+        svs::distance::DistanceL2(),
+        2};
+    auto parameters = vamana::VamanaConfigParameters{
+        64, 100, 1.2f, 750, 200, true, 10, false, {100, 0, 1000, 5000}};
+
+    CATCH_SECTION("Round Trip") {
+        svs_test::prepare_temp_directory();
+        auto temp_directory = svs_test::temp_directory();
+        svs::lib::save(parameters, temp_directory);
+        auto reloaded = svs::lib::load<vamana::VamanaConfigParameters>(temp_directory);
+        CATCH_REQUIRE(reloaded.entry_point == parameters.entry_point);
+        CATCH_REQUIRE(reloaded.entry_points == parameters.entry_points);
+
+        index.apply(reloaded);
+        CATCH_REQUIRE(
+            index.get_entry_points() == std::vector<uint32_t>{100, 0, 1000, 5000}
+        );
+    }
+
+    CATCH_SECTION("Version 0.0.1") {
+        // Configurations prior to v0.0.2 were saved without "entry_points".
+        auto ctx = svs::lib::SaveContext(svs_test::temp_directory());
+        auto table = std::get<0>(parameters.save(ctx));
+        table.erase("entry_points");
+        auto reloaded = vamana::VamanaConfigParameters::load(
+            table,
+            svs::lib::LoadContext(svs_test::temp_directory(), svs::lib::Version(0, 0, 1)),
+            svs::lib::Version(0, 0, 1)
+        );
+        CATCH_REQUIRE(reloaded.entry_point == parameters.entry_point);
+        CATCH_REQUIRE(reloaded.entry_points.empty());
+
+        // Searches start from the single saved entry point.
+        index.set_entry_points(std::vector<size_t>{0, 1000});
+        index.apply(reloaded);
+        CATCH_REQUIRE(index.get_entry_points() == std::vector<uint32_t>{100});
+    }
+}
+
+namespace {
+// Return the file backing the memory mapping containing ``ptr``. Return an empty path if
+// ``ptr`` is not in a file-backed mapping.
+std::filesystem::path mapped_file(const void* ptr) {
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    auto maps = std::ifstream("/proc/self/maps");
+    auto line = std::string();
+    while (std::getline(maps, line)) {
+        // Each line has the form "start-end perms offset dev inode [path]".
+        auto stream = std::istringstream(line);
+        auto range = std::string();
+        auto skip = std::string();
+        auto path = std::string();
+        stream >> range >> skip >> skip >> skip >> skip >> path;
+        auto dash = range.find('-');
+        auto start = std::stoull(range.substr(0, dash), nullptr, 16);
+        auto end = std::stoull(range.substr(dash + 1), nullptr, 16);
+        if (start <= address && address < end) {
+            return path;
+        }
+    }
+    return {};
+}
+
+// Return whether any memory mapping of this process is backed by ``file``.
+bool is_mapped(const std::filesystem::path& file) {
+    auto expected = std::filesystem::canonical(file).string();
+    auto maps = std::ifstream("/proc/self/maps");
+    auto line = std::string();
+    while (std::getline(maps, line)) {
+        if (line.ends_with(expected)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+CATCH_TEST_CASE("Vamana Memory Mapped Assembly", "[vamana][index][save_load]") {
+    using GraphLoader = svs::GraphLoader<uint32_t, svs::data::MemoryMapBuilder>;
+    using DataLoader =
+        svs::VectorDataLoader<float, svs::Dynamic, svs::data::MemoryMapBuilder>;
+    const auto graph_file = std::filesystem::canonical(test_dataset::graph_file());
+    const auto data_file = std::filesystem::canonical(test_dataset::data_svs_file());
+    auto builder = svs::data::MemoryMapBuilder();
+
+    CATCH_SECTION("Graph") {
+        auto expected = test_dataset::graph();
+        auto graph = GraphLoader(graph_file, builder).load();
+        CATCH_REQUIRE(mapped_file(graph.get_node(0).data()) == graph_file);
+        CATCH_REQUIRE(graph.n_nodes() == expected.n_nodes());
+        CATCH_REQUIRE(graph.max_degree() == expected.max_degree());
+        for (size_t i = 0; i < graph.n_nodes(); ++i) {
+            CATCH_REQUIRE(std::ranges::equal(graph.get_node(i), expected.get_node(i)));
+        }
+    }
+
+    CATCH_SECTION("Index") {
+        const size_t num_neighbors = 10;
+        auto queries = test_dataset::queries();
+        auto reference = vamana::auto_assemble(
+            test_dataset::vamana_config_file(),
+            svs::GraphLoader(graph_file),
+            svs::VectorDataLoader<float>(data_file),
+            svs::distance::DistanceL2(),
+            2
+        );
+        auto expected = reference.search(queries, num_neighbors);
+        CATCH_REQUIRE(!is_mapped(graph_file));
+        CATCH_REQUIRE(!is_mapped(data_file));
+
+        // Both the graph and the data are used in place from the files.
+        auto index = vamana::auto_assemble(
+            test_dataset::vamana_config_file(),
+            GraphLoader(graph_file, builder),
+            DataLoader(data_file, builder),
+            svs::distance::DistanceL2(),
+            2
+        );
+        CATCH_REQUIRE(is_mapped(graph_file));
+        CATCH_REQUIRE(is_mapped(data_file));
+
+        auto result = index.search(queries, num_neighbors);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i, j) == expected.index(i, j));
+                CATCH_REQUIRE(result.distance(i, j) == expected.distance(i, j));
+            }
+        }
+    }
+}
@@ -284,6 +284,26 @@ CATCH_TEST_CASE("Testing Search Buffer", "[core][search_buffer]") {
         }
     }
 
+    CATCH_SECTION("Visited Set Reuse") {
+        auto x = svs::index::vamana::SearchBuffer<uint32_t>(10);
+        x.enable_visited_set();
+        x.reserve_visited(100);
+        // Clearing should invalidate all previous entries, including after the
+        // generation counter wraps around.
+        for (size_t iter = 0; iter < 70'000; ++iter) {
+            auto id = svs::lib::narrow_cast<uint32_t>(iter % 100);
+            CATCH_REQUIRE(x.visited(id) == false);
+            x.set_visited(id);
+            CATCH_REQUIRE(x.visited(id) == true);
+            x.clear();
+        }
+
+        // Vertices beyond the reserved size should grow the table.
+        x.set_visited(1000);
+        CATCH_REQUIRE(x.visited(1000) == true);
+        CATCH_REQUIRE(x.visited(999) == false);
+    }
+
     CATCH_SECTION("Shallow Copy") {
         auto x = svs::index::vamana::SearchBuffer<size_t>(10);
         CATCH_REQUIRE(svs::threads::shallow_copyable_v<decltype(x)>);
@@ -348,6 +368,27 @@ template <typename Cmp> void fuzz_test(Cmp cmp) {
     CATCH_REQUIRE(equal == true);
 }
 
+CATCH_TEST_CASE("Generation Table", "[core][search_buffer]") {
+    auto table = svs::index::vamana::GenerationTable<uint32_t>();
+    CATCH_REQUIRE(table.size() == 0);
+    CATCH_REQUIRE(table.contains(0) == false);
+    CATCH_REQUIRE(table.emplace(5) == true);
+    CATCH_REQUIRE(table.emplace(5) == false);
+    CATCH_REQUIRE(table.contains(5) == true);
+    CATCH_REQUIRE(table.size() >= 6);
+
+    // Shallow copies have the same size but none of the contents.
+    auto other = svs::threads::shallow_copy(table);
+    CATCH_REQUIRE(other.size() == table.size());
+    CATCH_REQUIRE(other.contains(5) == false);
+
+    table.clear();
+    CATCH_REQUIRE(table.contains(5) == false);
+    table.reserve(1000);
+    CATCH_REQUIRE(table.size() == 1000);
+    CATCH_REQUIRE(table.contains(999) == false);
+}
+
 CATCH_TEST_CASE("Fuzzing", "[core][search_buffer]") {
     fuzz_test(std::less<>{});
     fuzz_test(std::greater<>{});
@@ -464,6 +505,41 @@ CATCH_TEST_CASE("MutableBuffer", "[core][search_buffer]") {
         CATCH_REQUIRE(buffer.size() == 4);
         CATCH_REQUIRE(buffer.full() == true);
     }
+
+    // With a size limit, skipped candidates no longer accumulate without bound.
+    CATCH_SECTION("Size Limit") {
+        // Limits below the target are raised to the target.
+        buffer.set_size_limit(2);
+        CATCH_REQUIRE(buffer.size_limit() == 4);
+        buffer.set_size_limit(8);
+        CATCH_REQUIRE(buffer.size_limit() == 8);
+        CATCH_REQUIRE(buffer.shallow_copy().size_limit() == 8);
+
+        for (size_t i = 0; i < 100; ++i) {
+            buffer.insert({i, svs::lib::narrow_cast<float>(1000 - i), true});
+            CATCH_REQUIRE(buffer.size() == std::min(i + 1, size_t{8}));
+        }
+        // The best candidates are kept.
+        CATCH_REQUIRE(eq(buffer[0], {99, 901, true}));
+        CATCH_REQUIRE(eq(buffer[7], {92, 908, true}));
+
+        // Worse candidates are rejected once the limit is reached.
+        CATCH_REQUIRE(buffer.can_skip(2000));
+        CATCH_REQUIRE(buffer.insert({200, 2000, false}) == buffer.size());
+
+        // A better valid candidate displaces the worst skipped one.
+        buffer.insert({201, 10, false});
+        CATCH_REQUIRE(buffer.valid() == 1);
+        CATCH_REQUIRE(buffer.size() == 8);
+        CATCH_REQUIRE(eq(buffer[0], {201, 10, false}));
+
+        // Once enough valid candidates are found, skipped ones collapse as before.
+        for (size_t i = 0; i < 3; ++i) {
+            buffer.insert({300 + i, svs::lib::narrow_cast<float>(i), false});
+        }
+        CATCH_REQUIRE(buffer.size() == 4);
+        CATCH_REQUIRE(buffer.full() == true);
+    }
 }
 
 namespace {
@@ -518,6 +594,28 @@ template <typename Cmp> void fuzz_mutable(size_t ntests) {
 
 } // namespace
 
+CATCH_TEST_CASE("MutableBuffer Visited Set", "[core][search_buffer]") {
+    auto buffer = svs::index::vamana::MutableBuffer<uint32_t>(4);
+    CATCH_REQUIRE(buffer.visited_set_enabled() == false);
+    buffer.set_visited(1);
+    CATCH_REQUIRE(buffer.visited(1) == false);
+
+    buffer.enable_visited_set();
+    auto copy = svs::threads::shallow_copy(buffer);
+    CATCH_REQUIRE(copy.visited_set_enabled() == true);
+
+    buffer.push_back({1, 10, false});
+    buffer.push_back({2, 20, true});
+    CATCH_REQUIRE(buffer.next().id() == 1);
+    CATCH_REQUIRE(buffer.visited(1) == true);
+    CATCH_REQUIRE(buffer.visited(2) == false);
+    buffer.clear();
+    CATCH_REQUIRE(buffer.visited(1) == false);
+
+    buffer.disable_visited_set();
+    CATCH_REQUIRE(buffer.visited_set_enabled() == false);
+}
+
 CATCH_TEST_CASE("Fuzzing Mutable", "[core][search_buffer]") {
     fuzz_mutable<std::less<>>(1'000);
     fuzz_mutable<std::greater<>>(2'000);
@@ -14,14 +14,22 @@
 #include "svs/index/vamana/vamana_build.h"
 
 // svs
+#include "svs/core/distance.h"
+#include "svs/core/distance/gather.h"
+#include "svs/core/graph.h"
+#include "svs/core/medioid.h"
 #include "svs/lib/threads.h"
 
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// tests
+#include "tests/utils/test_dataset.h"
+
 // stl
 #include <chrono>
 #include <random>
+#include <span>
 #include <thread>
 
 namespace vamana = svs::index::vamana;
@@ -57,6 +65,34 @@ void test_enabled_tracker(vamana::OptionalTracker<uint32_t>& tracker) {
     CATCH_REQUIRE(std::equal(seen.begin(), seen.end(), unique.begin(), svs::NeighborEqual())
     );
 }
+
+// Identical to the Euclidean distance, but not recognized by the batched kernels of
+// ``compute_gathered``, which then scores candidates one pair at a time.
+struct UnbatchedL2 : svs::distance::DistanceL2 {};
+
+// Build a graph over ``data`` with a single thread so construction is deterministic.
+template <typename Data, typename Dist = svs::distance::DistanceL2>
+svs::graphs::SimpleGraph<uint32_t> build_graph(
+    const Data& data, const vamana::VamanaBuildParameters& parameters, Dist distance = {}
+) {
+    auto threadpool = svs::threads::NativeThreadPool(1);
+    auto graph =
+        svs::graphs::SimpleGraph<uint32_t>(data.size(), parameters.graph_max_degree);
+    auto entry_point = svs::utils::find_medioid(data, threadpool);
+    auto builder = vamana::VamanaBuilder(graph, data, distance, parameters, threadpool);
+    builder.construct(1.0F, entry_point, false);
+    builder.construct(parameters.alpha, entry_point, false);
+    return graph;
+}
+
+template <typename Graph> void require_same_graph(const Graph& x, const Graph& y) {
+    CATCH_REQUIRE(x.n_nodes() == y.n_nodes());
+    for (size_t i = 0, imax = x.n_nodes(); i < imax; ++i) {
+        auto a = x.get_node(i);
+        auto b = y.get_node(i);
+        CATCH_REQUIRE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    }
+}
 } // namespace
 
 CATCH_TEST_CASE("Index Build Utilties", "[vamana][vamana_build]") {
@@ -137,3 +173,41 @@ CATCH_TEST_CASE("Index Build Utilties", "[vamana][vamana_build]") {
         }
     }
 }
+
+CATCH_TEST_CASE("Index Build Visited Set", "[vamana][vamana_build]") {
+    auto data = test_dataset::data_f32();
+    auto parameters = vamana::VamanaBuildParameters{1.2, 32, 64, 500, 1};
+    // The visited set costs memory proportional to the dataset for each thread, so it
+    // is opt-in.
+    CATCH_REQUIRE(!parameters.use_visited_set);
+    auto expected = build_graph(data, parameters);
+
+    // Skipping already scored vertices does not change the graph.
+    parameters.use_visited_set = true;
+    auto graph = build_graph(data, parameters);
+    require_same_graph(expected, graph);
+}
+
+CATCH_TEST_CASE("Index Build Batched Distances", "[vamana][vamana_build]") {
+    namespace dist = svs::distance;
+    auto all_data = test_dataset::data_f32();
+    auto data = svs::data::SimpleData<float>(3000, all_data.dimensions());
+    for (size_t i = 0; i < data.size(); ++i) {
+        data.set_datum(i, all_data.get_datum(i));
+    }
+    auto parameters = vamana::VamanaBuildParameters{1.2, 32, 64, 500, 1};
+    using span_type = std::span<const float>;
+    static_assert(dist::detail::use_batched_kernel<dist::DistanceL2, span_type, span_type>);
+    static_assert(!dist::detail::use_batched_kernel<UnbatchedL2, span_type, span_type>);
+
+    // The batched kernels produce the same distances as the per-pair kernels, so the
+    // graph is identical whether candidates are scored in batches or one at a time.
+    const auto original = dist::active_isa();
+    for (auto isa : {original, dist::ISA::generic}) {
+        dist::set_active_isa(isa);
+        auto batched = build_graph(data, parameters);
+        auto unbatched = build_graph(data, parameters, UnbatchedL2());
+        require_same_graph(batched, unbatched);
+    }
+    dist::set_active_isa(original);
+}
@@ -0,0 +1,78 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+#include "svs/lib/bitset.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <cstddef>
+
+CATCH_TEST_CASE("Bitset", "[lib][bitset]") {
+    CATCH_SECTION("Construction") {
+        auto empty = svs::lib::Bitset();
+        CATCH_REQUIRE(empty.size() == 0);
+        CATCH_REQUIRE(empty.count() == 0);
+
+        // Sizes that are and are not multiples of the word size.
+        for (size_t size : {1, 63, 64, 65, 200}) {
+            auto zeros = svs::lib::Bitset(size);
+            CATCH_REQUIRE(zeros.size() == size);
+            CATCH_REQUIRE(zeros.count() == 0);
+            auto ones = svs::lib::Bitset(size, true);
+            CATCH_REQUIRE(ones.count() == size);
+            for (size_t i = 0; i < size; ++i) {
+                CATCH_REQUIRE(!zeros.test(i));
+                CATCH_REQUIRE(ones(i));
+            }
+            CATCH_REQUIRE(ones.words().size() == (size + 63) / 64);
+        }
+    }
+
+    CATCH_SECTION("Modification") {
+        auto bits = svs::lib::Bitset(130);
+        for (size_t i = 0; i < bits.size(); i += 3) {
+            bits.set(i);
+        }
+        CATCH_REQUIRE(bits.count() == 44);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            CATCH_REQUIRE(bits.at(i) == (i % 3 == 0));
+        }
+
+        bits.reset(0);
+        bits.set(129, true);
+        bits.set(3, false);
+        CATCH_REQUIRE(!bits.test(0));
+        CATCH_REQUIRE(bits.test(129));
+        CATCH_REQUIRE(!bits.test(3));
+        CATCH_REQUIRE(bits.count() == 42);
+
+        auto copy = bits;
+        CATCH_REQUIRE(copy == bits);
+        copy.set(1);
+        CATCH_REQUIRE(copy != bits);
+
+        bits.fill(true);
+        CATCH_REQUIRE(bits.count() == 130);
+        CATCH_REQUIRE(bits == svs::lib::Bitset(130, true));
+        bits.fill(false);
+        CATCH_REQUIRE(bits.count() == 0);
+    }
+
+    CATCH_SECTION("Errors") {
+        auto bits = svs::lib::Bitset(10);
+        CATCH_REQUIRE_THROWS_AS(bits.set(10), svs::ANNException);
+        CATCH_REQUIRE_THROWS_AS(bits.reset(11), svs::ANNException);
+        CATCH_REQUIRE_THROWS_AS(bits.at(10), svs::ANNException);
+    }
+}
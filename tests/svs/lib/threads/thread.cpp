@@ -757,3 +757,76 @@ CATCH_TEST_CASE("Testing Thread", "[core][threads][high_level]") {
         }
     }
 }
+
+CATCH_TEST_CASE("Spin Policy", "[core][threads]") {
+    using namespace std::chrono_literals;
+    CATCH_SECTION("Fixed") {
+        auto policy = svs::threads::SpinPolicy(100);
+        CATCH_REQUIRE(!policy.is_adaptive());
+        CATCH_REQUIRE(policy.spin_count() == 100);
+        policy.update(10ns, 1s);
+        CATCH_REQUIRE(policy.spin_count() == 100);
+        policy.update(1s, 10ns);
+        CATCH_REQUIRE(policy.spin_count() == 100);
+    }
+
+    CATCH_SECTION("Adaptive") {
+        auto policy = svs::threads::SpinPolicy::adaptive(100, 1000);
+        CATCH_REQUIRE(policy.is_adaptive());
+        CATCH_REQUIRE(policy.min_spin_count() == 100);
+        CATCH_REQUIRE(policy.max_spin_count() == 1000);
+        // Start at the maximum.
+        CATCH_REQUIRE(policy.spin_count() == 1000);
+
+        // Long sleeps shrink the spin count down to the minimum.
+        policy.update(1us, 1ms);
+        CATCH_REQUIRE(policy.spin_count() == 500);
+        for (size_t i = 0; i < 10; ++i) {
+            policy.update(1us, 1ms);
+        }
+        CATCH_REQUIRE(policy.spin_count() == 100);
+
+        // Short sleeps grow the spin count back up to the maximum.
+        policy.update(1us, 10ns);
+        CATCH_REQUIRE(policy.spin_count() == 200);
+        for (size_t i = 0; i < 10; ++i) {
+            policy.update(1us, 10ns);
+        }
+        CATCH_REQUIRE(policy.spin_count() == 1000);
+
+        // Bounds are sanitized.
+        auto swapped = svs::threads::SpinPolicy(10, 5);
+        CATCH_REQUIRE(swapped.min_spin_count() == 5);
+        CATCH_REQUIRE(swapped.max_spin_count() == 5);
+        CATCH_REQUIRE(!swapped.is_adaptive());
+    }
+
+    CATCH_SECTION("Wait Telemetry") {
+        // Short spin so the worker goes to sleep between jobs.
+        auto thread = svs::threads::TelemetryThread{svs::threads::SpinPolicy(1)};
+        auto statistics = thread.get_telemetry().statistics();
+        size_t count = 0;
+        auto fn = svs::threads::FunctionType([&](uint64_t /*unused*/) { ++count; });
+        const size_t num_jobs = 5;
+        for (size_t i = 0; i < num_jobs; ++i) {
+            // Give the worker time to fall asleep.
+            std::this_thread::sleep_for(5ms);
+            thread.assign({&fn, 0});
+            thread.wait();
+        }
+        CATCH_REQUIRE(count == num_jobs);
+
+        statistics = thread.get_telemetry().statistics();
+        CATCH_REQUIRE(statistics.sleeps >= num_jobs);
+        CATCH_REQUIRE(statistics.spin_fail >= statistics.sleeps);
+        CATCH_REQUIRE(statistics.sleep_time >= num_jobs * 4ms);
+        CATCH_REQUIRE(statistics.wasted_spin_time <= statistics.spin_time);
+        CATCH_REQUIRE(statistics.mean_wakeup_latency() > 0ns);
+        CATCH_REQUIRE(statistics.mean_wakeup_latency() < 1s);
+
+        thread.get_telemetry().reset();
+        statistics = thread.get_telemetry().statistics();
+        CATCH_REQUIRE(statistics.sleeps == 0);
+        CATCH_REQUIRE(statistics.spin_time == 0ns);
+    }
+}
@@ -11,6 +11,7 @@
 
 // stdlib
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 // svs
@@ -176,3 +177,50 @@ CATCH_TEST_CASE("Sequential TLS", "[core][util]") {
     auto b = std::addressof(tls.at(1));
     CATCH_REQUIRE(address_offset(b, a) == svs::threads::CACHE_LINE_BYTES);
 }
+
+CATCH_TEST_CASE("Scratch Pool", "[core][util]") {
+    auto pool = svs::threads::ScratchPool<std::vector<int>>();
+    const std::vector<int>* address = nullptr;
+    {
+        auto scratch = pool.acquire(2);
+        CATCH_REQUIRE(scratch.cached());
+        CATCH_REQUIRE(scratch.size() == 2);
+        CATCH_REQUIRE(!scratch[0].has_value());
+        CATCH_REQUIRE(!scratch[1].has_value());
+        scratch[1].emplace(10, 1);
+
+        // The cached slots are in use, so a concurrent user gets temporary slots.
+        auto other = pool.acquire(4);
+        CATCH_REQUIRE(!other.cached());
+        CATCH_REQUIRE(other.size() == 4);
+        CATCH_REQUIRE(!other[1].has_value());
+        other[1].emplace(20, 2);
+    }
+
+    // The cached slots are reused and grown if needed.
+    {
+        auto scratch = pool.acquire(4);
+        CATCH_REQUIRE(scratch.cached());
+        CATCH_REQUIRE(scratch.size() == 4);
+        CATCH_REQUIRE(!scratch[0].has_value());
+        CATCH_REQUIRE(scratch[1].has_value());
+        CATCH_REQUIRE(scratch[1]->size() == 10);
+        CATCH_REQUIRE(scratch[1]->at(0) == 1);
+        CATCH_REQUIRE(!scratch[3].has_value());
+        address = std::addressof(*scratch[1]);
+    }
+
+    // Handles never shrink the cache.
+    {
+        auto scratch = pool.acquire(1);
+        CATCH_REQUIRE(scratch.size() == 4);
+        CATCH_REQUIRE(std::addressof(*scratch[1]) == address);
+    }
+
+    // Copies start out empty.
+    auto copy = pool;
+    CATCH_REQUIRE(!copy.acquire(2)[1].has_value());
+
+    pool.clear();
+    CATCH_REQUIRE(!pool.acquire(2)[1].has_value());
+}
@@ -10,13 +10,16 @@
  */
 
 // stdlib
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <numeric>
 // #include <omp.h>
 #include <random>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 // local includes
 #include "svs/lib/exception.h"
@@ -206,3 +209,148 @@ CATCH_TEST_CASE("Thread Pool", "[core][threads][threadpool]") {
         }));
     }
 }
+
+CATCH_TEST_CASE("Work Stealing", "[core][threads][threadpool]") {
+    using namespace std::chrono_literals;
+    const size_t num_elements = 1000;
+    for (size_t num_threads : {1, 2, 3, 4}) {
+        auto pool = svs::threads::NativeThreadPool(num_threads);
+        for (size_t grainsize : {1, 7, 64}) {
+            auto counts = std::vector<std::atomic<size_t>>(num_elements);
+            auto f = [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                for (auto i : is) {
+                    // Make the first elements much more expensive than the rest so the
+                    // first thread falls behind.
+                    if (i < 10) {
+                        std::this_thread::sleep_for(1ms);
+                    }
+                    counts.at(i)++;
+                }
+            };
+            svs::threads::run(
+                pool, svs::threads::StealingPartition{num_elements, grainsize}, f
+            );
+            // Every element should be visited exactly once.
+            CATCH_REQUIRE(std::all_of(counts.begin(), counts.end(), [](const auto& c) {
+                return c.load() == 1;
+            }));
+        }
+    }
+
+    // Iterators over ranges.
+    auto pool = svs::threads::NativeThreadPool(4);
+    auto ids = std::vector<size_t>(100);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::reverse(ids.begin(), ids.end());
+    auto counts = std::vector<std::atomic<size_t>>(ids.size());
+    svs::threads::run(
+        pool,
+        svs::threads::StealingPartition{ids},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                counts.at(i)++;
+            }
+        }
+    );
+    CATCH_REQUIRE(std::all_of(counts.begin(), counts.end(), [](const auto& c) {
+        return c.load() == 1;
+    }));
+}
+
+CATCH_TEST_CASE("Partitioned Thread Pool", "[core][threads][threadpool]") {
+    using namespace std::chrono_literals;
+    CATCH_REQUIRE_THROWS_AS(svs::threads::PartitionedThreadPool(4, 0), svs::ANNException);
+
+    auto pool = svs::threads::PartitionedThreadPool(5, 2);
+    CATCH_REQUIRE(pool.num_partitions() == 2);
+    CATCH_REQUIRE(pool.size() == 5);
+
+    CATCH_SECTION("Leases") {
+        auto a = pool.acquire();
+        auto b = pool.try_acquire();
+        CATCH_REQUIRE(b.has_value());
+        CATCH_REQUIRE(a.partition() != b->partition());
+        CATCH_REQUIRE(a.size() + b->size() == 5);
+        // Every partition is in use.
+        CATCH_REQUIRE(!pool.try_acquire().has_value());
+
+        // Moving a lease does not release the partition.
+        auto c = std::move(a);
+        CATCH_REQUIRE(!pool.try_acquire().has_value());
+        b.reset();
+        auto d = pool.try_acquire();
+        CATCH_REQUIRE(d.has_value());
+    }
+
+    CATCH_SECTION("Concurrent Runs") {
+        // Run jobs from more callers than partitions. Each job should only see the
+        // threads of its own partition.
+        const size_t num_callers = 4;
+        const size_t num_jobs = 20;
+        auto in_use = std::vector<std::atomic<size_t>>(pool.num_partitions());
+        std::atomic<bool> overlap = false;
+        std::atomic<size_t> total = 0;
+        auto caller = [&]() {
+            for (size_t job = 0; job < num_jobs; ++job) {
+                auto lease = pool.acquire();
+                if (in_use.at(lease.partition())++ != 0) {
+                    overlap = true;
+                }
+                auto counts = std::vector<std::atomic<size_t>>(100);
+                svs::threads::run(
+                    lease,
+                    svs::threads::StaticPartition{counts.size()},
+                    [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                        for (auto i : is) {
+                            counts.at(i)++;
+                        }
+                    }
+                );
+                std::this_thread::sleep_for(100us);
+                in_use.at(lease.partition())--;
+                for (const auto& count : counts) {
+                    total += count.load();
+                }
+            }
+        };
+
+        auto callers = std::vector<std::thread>();
+        for (size_t i = 0; i < num_callers; ++i) {
+            callers.emplace_back(caller);
+        }
+        for (auto& thread : callers) {
+            thread.join();
+        }
+        CATCH_REQUIRE(!overlap);
+        CATCH_REQUIRE(total == num_callers * num_jobs * 100);
+    }
+}
+
+CATCH_TEST_CASE("Thread Pool Wait Statistics", "[core][threads][threadpool]") {
+    using namespace std::chrono_literals;
+    // Use a short fixed spin so idle workers are guaranteed to sleep between runs.
+    auto pool = svs::threads::TelemetryThreadPool(3, svs::threads::SpinPolicy(1));
+    auto statistics = pool.wait_statistics();
+
+    auto counts = std::vector<size_t>(pool.size());
+    const size_t num_runs = 4;
+    for (size_t i = 0; i < num_runs; ++i) {
+        std::this_thread::sleep_for(5ms);
+        svs::threads::run(pool, [&](uint64_t tid) { ++counts[tid]; });
+    }
+    CATCH_REQUIRE(std::all_of(counts.begin(), counts.end(), [&](size_t count) {
+        return count == num_runs;
+    }));
+
+    // Statistics are summed over the two worker threads.
+    statistics = pool.wait_statistics();
+    CATCH_REQUIRE(statistics.sleeps >= 2 * num_runs);
+    CATCH_REQUIRE(statistics.spin_success + statistics.spin_fail >= 2 * num_runs);
+    CATCH_REQUIRE(statistics.sleep_time > 0ns);
+    CATCH_REQUIRE(statistics.mean_wakeup_latency() > 0ns);
+
+    pool.reset_wait_statistics();
+    statistics = pool.wait_statistics();
+    CATCH_REQUIRE(statistics.sleeps == 0);
+    CATCH_REQUIRE(statistics.spin_success == 0);
+}
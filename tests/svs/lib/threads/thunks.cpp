@@ -22,6 +22,7 @@
 #include "catch2/catch_test_macros.hpp"
 
 // stdlib
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -229,4 +230,36 @@ CATCH_TEST_CASE("Thread Thunks", "[core][threads]") {
         v.clear();
         u.clear();
     }
+
+    CATCH_SECTION("Work Stealing Partition") {
+        auto f = [&v, &u](const auto& indices, uint64_t id) {
+            for (auto i : indices) {
+                v.push_back(i);
+                u.push_back(id);
+            }
+        };
+        threads::FunctionType wrapped = threads::thunks::wrap(
+            threads::ThreadCount{4}, f, threads::StealingPartition{10, 1}
+        );
+
+        // Thread 1 begins with its own share `[3, 6)` and then steals the remaining work
+        // of the other threads.
+        wrapped(1);
+        CATCH_REQUIRE(v.size() == 10);
+        CATCH_REQUIRE(u.size() == 10);
+        CATCH_REQUIRE(v.at(0) == 3);
+        CATCH_REQUIRE(v.at(1) == 4);
+        CATCH_REQUIRE(v.at(2) == 5);
+        std::sort(v.begin(), v.end());
+        for (size_t i = 0; i < v.size(); ++i) {
+            CATCH_REQUIRE(v.at(i) == i);
+            CATCH_REQUIRE(u.at(i) == 1);
+        }
+
+        // All work has been claimed.
+        v.clear();
+        u.clear();
+        wrapped(0);
+        CATCH_REQUIRE(v.empty());
+    }
 }
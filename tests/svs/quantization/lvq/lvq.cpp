@@ -22,6 +22,10 @@
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <algorithm>
+#include <cmath>
+
 namespace lvq = svs::quantization::lvq;
 using DistanceL2 = svs::distance::DistanceL2;
 using DistanceIP = svs::distance::DistanceIP;
@@ -57,8 +61,47 @@ template <typename T, size_t N, typename Distance> void test_lvq_top() {
     static_assert(std::is_same_v<decltype(lvq_dataset), decltype(reloaded_lvq_dataset)>);
 }
 
+// Compress the test dataset both in memory and by streaming from the file in small chunks
+// and check that the results agree.
+template <typename T> void test_streaming_compression() {
+    auto data = svs::VectorDataLoader<float, 128>{test_dataset::data_svs_file()}.load();
+    auto loader = T{svs::VectorDataLoader<float, 128>{test_dataset::data_svs_file()}};
+
+    // Use a chunk size that does not evenly divide the dataset size.
+    const size_t chunk_size = 999;
+    CATCH_REQUIRE(data.size() % chunk_size != 0);
+    auto reference = loader.compress(data, {}, 2);
+    auto streamed = loader.template compress_file<float>(
+        test_dataset::data_svs_file(), {}, 2, chunk_size
+    );
+    CATCH_REQUIRE(streamed.size() == reference.size());
+    CATCH_REQUIRE(streamed.dimensions() == reference.dimensions());
+
+    // The means are accumulated differently, so the results may differ by rounding.
+    auto reference_decompressor = reference.decompressor();
+    auto streamed_decompressor = streamed.decompressor();
+    double max_error = 0;
+    for (size_t i = 0, imax = data.size(); i < imax; ++i) {
+        auto expected = reference_decompressor(reference.get_datum(i));
+        auto got = streamed_decompressor(streamed.get_datum(i));
+        for (size_t j = 0, jmax = data.dimensions(); j < jmax; ++j) {
+            max_error = std::max(max_error, std::abs(double{expected[j]} - got[j]));
+        }
+    }
+    CATCH_REQUIRE(max_error < 1e-3);
+}
+
 } // namespace
 
+CATCH_TEST_CASE("Streaming Compression", "[quantization][lvq]") {
+    CATCH_SECTION("One Level") {
+        test_streaming_compression<lvq::OneLevelWithBias<8, 128>>();
+    }
+    CATCH_SECTION("Two Level") {
+        test_streaming_compression<lvq::TwoLevelWithBias<4, 8, 128>>();
+    }
+}
+
 CATCH_TEST_CASE("End-to-End Vector Quantization", "[quantization][lvq]") {
     CATCH_SECTION("OnlineCompression") {
         // Make sure we can construct an instance of "OnlineCompression" using one of the
@@ -18,6 +18,7 @@
 #include "tests/utils/generators.h"
 
 // svs
+#include "svs/lib/narrow.h"
 #include "svs/lib/range.h"
 #include "svs/lib/timing.h"
 
@@ -310,6 +311,146 @@ void test_biased_self_distance(
     }
 }
 
+///
+/// Test the integer query path against both a scalar reference for the integer sums and
+/// the floating point path for the biased distances.
+///
+template <typename TestGenerator>
+void test_integer_query(TestGenerator& rhs, size_t num_tests = NUM_TESTS) {
+    auto generator = svs_test::make_generator<float>(-2, 2);
+    auto lhs = std::vector<float>(rhs.size());
+
+    auto bias = std::vector<float>(rhs.size());
+    svs_test::populate(bias, svs_test::make_generator<float>(-10, 10));
+    auto euclidean = lvq::EuclideanBiased(bias);
+    auto inner_product = lvq::InnerProductBiased(bias);
+    auto query = lvq::QuantizedQuery();
+
+    for (size_t i = 0; i < num_tests; ++i) {
+        const auto& [rhs_compressed, rhs_ref] = rhs.generate();
+        svs_test::populate(lhs, generator);
+        auto lhs_span = svs::lib::as_const_span(lhs);
+
+        // The integer codes must reconstruct the compressed vector.
+        auto codes = lvq::integer_codes(rhs_compressed);
+        auto aux = rhs_compressed.prepare_aux();
+        query.assign(lhs_span);
+        CATCH_REQUIRE(query.codes().size() % lvq::QuantizedQuery::padding == 0);
+        auto expected = lvq::IntegerSums{};
+        for (size_t j = 0, jmax = codes.size(); j < jmax; ++j) {
+            int64_t c = codes.get(j);
+            CATCH_REQUIRE(std::abs(c) <= lvq::max_integer_code);
+            CATCH_REQUIRE(
+                aux.scale * c + aux.bias ==
+                Catch::Approx(rhs_compressed.get(j)).epsilon(0.00001).margin(0.00001)
+            );
+            expected.dot += c * query.codes()[j];
+            expected.sum += c;
+            expected.sumsq += c * c;
+        }
+
+        // The vectorized kernels must match the scalar reference exactly.
+        auto sums = lvq::integer_sums<true>(query.codes(), codes);
+        CATCH_REQUIRE(sums.dot == expected.dot);
+        CATCH_REQUIRE(sums.sum == expected.sum);
+        CATCH_REQUIRE(sums.sumsq == expected.sumsq);
+        CATCH_REQUIRE(lvq::integer_sums<false>(query.codes(), codes).dot == expected.dot);
+
+        // Biased distances must agree with the floating point path.
+        lvq::set_integer_query_enabled(false);
+        svs::distance::maybe_fix_argument(euclidean, lhs_span);
+        svs::distance::maybe_fix_argument(inner_product, lhs_span);
+        float l2_float = svs::distance::compute(euclidean, lhs_span, rhs_compressed);
+        float ip_float = svs::distance::compute(inner_product, lhs_span, rhs_compressed);
+
+        lvq::set_integer_query_enabled(true);
+        svs::distance::maybe_fix_argument(euclidean, lhs_span);
+        svs::distance::maybe_fix_argument(inner_product, lhs_span);
+        float l2_int = svs::distance::compute(euclidean, lhs_span, rhs_compressed);
+        float ip_int = svs::distance::compute(inner_product, lhs_span, rhs_compressed);
+        lvq::set_integer_query_enabled(false);
+
+        // The error introduced by quantizing the query is proportional to the product
+        // of the norms of the query and the compressed vector.
+        double lhs_norm = 0;
+        double shifted_norm = 0;
+        double rhs_norm = 0;
+        for (size_t j = 0, jmax = lhs.size(); j < jmax; ++j) {
+            lhs_norm += lhs[j] * lhs[j];
+            shifted_norm += (lhs[j] - bias[j]) * (lhs[j] - bias[j]);
+            rhs_norm += rhs_ref[j] * rhs_ref[j];
+        }
+        double tolerance = 0.0001 * std::sqrt(rhs_norm);
+        CATCH_REQUIRE(
+            l2_int == Catch::Approx(l2_float).epsilon(0.0001).margin(
+                          2 * tolerance * std::sqrt(shifted_norm)
+                      )
+        );
+        CATCH_REQUIRE(
+            ip_int ==
+            Catch::Approx(ip_float).epsilon(0.0001).margin(tolerance * std::sqrt(lhs_norm))
+        );
+    }
+}
+
+///
+/// Test the integer Euclidean distance against the floating point path for queries that
+/// nearly coincide with the compressed vector. The distance is then small compared to the
+/// norms it is assembled from, so the query quantization error dominates.
+///
+template <typename TestGenerator>
+void test_integer_query_near_duplicates(
+    TestGenerator& rhs, size_t num_tests = NUM_TESTS
+) {
+    auto noise = svs_test::make_generator<float>(-0.001, 0.001);
+    auto lhs = std::vector<float>(rhs.size());
+    auto bias = std::vector<float>(rhs.size());
+    svs_test::populate(bias, svs_test::make_generator<float>(-10, 10));
+    auto euclidean = lvq::EuclideanBiased(bias);
+    auto query = lvq::QuantizedQuery();
+
+    for (size_t i = 0; i < num_tests; ++i) {
+        const auto& [rhs_compressed, rhs_ref] = rhs.generate();
+        auto codes = lvq::integer_codes(rhs_compressed);
+        auto aux = rhs_compressed.prepare_aux();
+
+        // Place the query next to the compressed vector, undoing the shift by the bias.
+        double shifted_norm = 0;
+        double rhs_norm = 0;
+        for (size_t j = 0, jmax = lhs.size(); j < jmax; ++j) {
+            float y = rhs_compressed.get(j);
+            float shifted = y + svs_test::generate(noise);
+            lhs[j] = shifted + bias[j];
+            shifted_norm += shifted * shifted;
+            rhs_norm += y * y;
+        }
+        auto lhs_span = svs::lib::as_const_span(lhs);
+        query.assign(lhs_span, bias);
+
+        // The documented bound on the error introduced by quantizing the query.
+        double bound = 0;
+        for (size_t j = 0, jmax = codes.size(); j < jmax; ++j) {
+            bound += std::abs(aux.scale * codes.get(j));
+        }
+        bound *= query.scale();
+
+        lvq::set_integer_query_enabled(false);
+        svs::distance::maybe_fix_argument(euclidean, lhs_span);
+        float l2_float = svs::distance::compute(euclidean, lhs_span, rhs_compressed);
+
+        lvq::set_integer_query_enabled(true);
+        svs::distance::maybe_fix_argument(euclidean, lhs_span);
+        float l2_int = svs::distance::compute(euclidean, lhs_span, rhs_compressed);
+        lvq::set_integer_query_enabled(false);
+
+        CATCH_REQUIRE(l2_float <= 0.00001 * lhs.size());
+        CATCH_REQUIRE(l2_int >= 0);
+        // Allow for rounding when combining the norms in single precision.
+        double margin = 0.000001 * (shifted_norm + rhs_norm);
+        CATCH_REQUIRE(std::abs(l2_int - l2_float) <= bound + margin);
+    }
+}
+
 // reduce visual clutter
 template <size_t N> using Val = svs::meta::Val<N>;
 
@@ -386,3 +527,111 @@ CATCH_TEST_CASE("Compressed Vector Variants", "[quantization][lvq]") {
         timer.print();
     }
 }
+
+CATCH_TEST_CASE("Integer Query", "[quantization][lvq]") {
+    using ISA = svs::distance::ISA;
+    const size_t TEST_DIM = 37;
+    // Large enough to span multiple accumulation blocks and end in a partial tail.
+    const size_t LARGE_DIM = 2 * lvq::integer_block_size + 45;
+
+    CATCH_REQUIRE(!lvq::integer_query_enabled());
+    const auto original_isa = svs::distance::active_isa();
+    for (auto isa : {ISA::generic, ISA::avx512f, ISA::avx512vnni}) {
+        if (svs::distance::set_active_isa(isa) != isa) {
+            continue;
+        }
+        // One level.
+        auto bits = std::make_tuple(Val<8>(), Val<4>());
+        svs::lib::foreach (bits, [&]<size_t N>(Val<N> /*unused*/) {
+            auto generator = test_fixtures::ScaledBiased<N, TEST_DIM>();
+            test_integer_query(generator);
+            test_integer_query_near_duplicates(generator);
+            auto large_dim = svs::lib::MaybeStatic(LARGE_DIM);
+            auto large = test_fixtures::ScaledBiased<N, svs::Dynamic>(large_dim);
+            test_integer_query(large, 10);
+            test_integer_query_near_duplicates(large, 10);
+        });
+
+        // Two level.
+        auto two_level = [&]<size_t N, size_t M>(Val<N> /*unused*/, Val<M> /*unused*/) {
+            auto generator = test_fixtures::ScaledBiasedWithResidual<N, M, TEST_DIM>();
+            test_integer_query(generator);
+            test_integer_query_near_duplicates(generator);
+            auto large = test_fixtures::ScaledBiasedWithResidual<N, M, svs::Dynamic>(
+                svs::lib::MaybeStatic(LARGE_DIM)
+            );
+            test_integer_query(large, 10);
+            test_integer_query_near_duplicates(large, 10);
+        };
+        two_level(Val<4>(), Val<4>());
+        two_level(Val<4>(), Val<8>());
+        two_level(Val<8>(), Val<4>());
+    }
+    svs::distance::set_active_isa(original_isa);
+
+    // Compressions whose combined codes do not fit in 16 bits use the float path.
+    static_assert(!lvq::IntegerQueryable<lvq::ScaledBiasedWithResidual<8, 8, 32>>);
+    static_assert(!lvq::IntegerQueryable<lvq::ScaledBiasedVector<7, 32>>);
+    static_assert(lvq::IntegerQueryable<lvq::ScaledBiasedWithResidual<4, 8, 32>>);
+}
+
+CATCH_TEST_CASE("Lazy Centroid Preprocessing", "[quantization][lvq]") {
+    const size_t TEST_DIM = 37;
+    const size_t NUM_CENTROIDS = 20;
+    auto centroids =
+        std::make_shared<svs::data::SimpleData<float>>(NUM_CENTROIDS, TEST_DIM);
+    auto centroid_generator = svs_test::make_generator<float>(-10, 10);
+    auto centroid = std::vector<float>(TEST_DIM);
+    for (size_t i = 0; i < NUM_CENTROIDS; ++i) {
+        svs_test::populate(centroid, centroid_generator);
+        centroids->set_datum(i, centroid);
+    }
+
+    auto euclidean = lvq::EuclideanBiased(centroids);
+    auto inner_product = lvq::InnerProductBiased(centroids);
+    auto generator = test_fixtures::ScaledBiased<8, TEST_DIM>();
+    auto query_generator = svs_test::make_generator<float>(-2, 2);
+    auto query = std::vector<float>(TEST_DIM);
+    auto reconstructed = std::vector<float>(TEST_DIM);
+
+    for (bool integer : {false, true}) {
+        lvq::set_integer_query_enabled(integer);
+        // Run several queries through the same functors so stale cached entries would be
+        // detected.
+        for (size_t q = 0; q < 5; ++q) {
+            svs_test::populate(query, query_generator);
+            auto query_span = svs::lib::as_const_span(query);
+            svs::distance::maybe_fix_argument(euclidean, query_span);
+            svs::distance::maybe_fix_argument(inner_product, query_span);
+
+            // Visit only a subset of the centroids, some of them more than once.
+            for (size_t i = 0; i < 30; ++i) {
+                auto selector = svs::lib::narrow<lvq::selector_t>(
+                    (7 * i + 3 * q) % (NUM_CENTROIDS / 2)
+                );
+                const auto& [compressed, ref] = generator.generate();
+                auto y = lvq::ScaledBiasedVector<8, TEST_DIM>{
+                    compressed.scale, compressed.bias, selector, compressed.data};
+                auto shift = centroids->get_datum(selector);
+                for (size_t j = 0; j < TEST_DIM; ++j) {
+                    reconstructed[j] = ref[j] + shift[j];
+                }
+
+                auto l2 = svs::distance::DistanceL2();
+                auto ip = svs::distance::DistanceIP();
+                auto expected = svs::lib::as_const_span(reconstructed);
+                float l2_expected = svs::distance::compute(l2, query_span, expected);
+                float ip_expected = svs::distance::compute(ip, query_span, expected);
+                CATCH_REQUIRE(
+                    svs::distance::compute(euclidean, query_span, y) ==
+                    Catch::Approx(l2_expected).epsilon(0.001).margin(0.01)
+                );
+                CATCH_REQUIRE(
+                    svs::distance::compute(inner_product, query_span, y) ==
+                    Catch::Approx(ip_expected).epsilon(0.001).margin(0.01)
+                );
+            }
+        }
+    }
+    lvq::set_integer_query_enabled(false);
+}
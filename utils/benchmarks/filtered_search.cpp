@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include "svs/core/recall.h"
+#include "svs/index/flat/flat.h"
+#include "svs/index/vamana/index.h"
+#include "svs/lib/bitset.h"
+#include "svs/lib/timing.h"
+#include "svs/third-party/fmt.h"
+
+#include "svsmain.h"
+
+// stl
+#include <algorithm>
+#include <limits>
+#include <random>
+
+// Compile-time Settings
+using Eltype = float;
+using QueryEltype = float;
+inline constexpr auto global_distance = svs::distance::DistanceL2();
+const size_t NumNeighbors = 10;
+// The baseline fetches this many times more neighbors and drops rejected ones.
+const size_t OverFetch = 20;
+
+namespace {
+
+struct BenchmarkResult {
+    double selectivity;
+    size_t search_window_size;
+    bool filtered;
+    double qps;
+    double recall;
+};
+
+const std::string HELP =
+    R"(
+   benchmark_filtered_search config graph data queries num_threads
+
+Compare filtered graph search with searching for `10 x 20` neighbors and discarding those
+rejected by the filter. Filters accept a random subset of the dataset with selectivities
+from 50% to 0.1%. Data is expected to be stored as float32 and compared using the L2
+distance.
+)";
+
+svs::lib::Bitset random_filter(size_t size, double selectivity, uint64_t seed) {
+    auto rng = std::mt19937_64(seed);
+    auto accept = std::bernoulli_distribution(selectivity);
+    auto filter = svs::lib::Bitset(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (accept(rng)) {
+            filter.set(i);
+        }
+    }
+    return filter;
+}
+
+// Write the first `NumNeighbors` accepted neighbors of each row of `overfetched` into
+// `result`.
+void post_filter(
+    const svs::QueryResult<size_t>& overfetched,
+    const svs::lib::Bitset& filter,
+    svs::QueryResult<size_t>& result
+) {
+    for (size_t i = 0; i < overfetched.n_queries(); ++i) {
+        size_t k = 0;
+        for (size_t j = 0; j < overfetched.n_neighbors() && k < NumNeighbors; ++j) {
+            auto id = overfetched.index(i, j);
+            if (filter(id)) {
+                result.index(i, k) = id;
+                result.distance(i, k) = overfetched.distance(i, j);
+                ++k;
+            }
+        }
+        for (; k < NumNeighbors; ++k) {
+            result.index(i, k) = std::numeric_limits<size_t>::max();
+            result.distance(i, k) = std::numeric_limits<float>::max();
+        }
+    }
+}
+
+} // namespace
+
+template <> struct fmt::formatter<BenchmarkResult> : svs::format_empty {
+    auto format(const auto& x, auto& ctx) const {
+        return fmt::format_to(
+            ctx.out(),
+            "{{ selectivity = {}, sws = {}, filtered = {}, qps = {}, recall = {} }}",
+            x.selectivity,
+            x.search_window_size,
+            x.filtered,
+            x.qps,
+            x.recall
+        );
+    }
+};
+
+int svs_main(std::vector<std::string> args) {
+    if (args.size() != 6) {
+        std::cout << HELP << std::endl;
+        return 1;
+    }
+
+    size_t i = 1;
+    const auto& config_path = args.at(i++);
+    const auto& graph_path = args.at(i++);
+    const auto& data_path = args.at(i++);
+    const auto& query_path = args.at(i++);
+    auto num_threads = std::stoull(args.at(i++));
+
+    auto timer = svs::lib::Timer();
+    auto load_timer = timer.push_back("loading");
+    auto queries = svs::io::auto_load<QueryEltype>(query_path);
+    auto index = svs::index::vamana::auto_assemble(
+        config_path,
+        svs::GraphLoader(graph_path),
+        svs::VectorDataLoader<Eltype>(data_path),
+        global_distance,
+        num_threads
+    );
+    auto exhaustive = svs::index::flat::auto_assemble(
+        svs::VectorDataLoader<Eltype>(data_path), global_distance, num_threads
+    );
+    load_timer.finish();
+
+    auto selectivities = std::vector<double>{0.5, 0.1, 0.01, 0.001};
+    auto search_window_sizes = std::vector<size_t>{10, 20, 40, 80};
+    auto results = std::vector<BenchmarkResult>();
+    const size_t nloops = 5;
+    for (auto selectivity : selectivities) {
+        auto filter = random_filter(index.size(), selectivity, 0xc0ffee);
+        auto groundtruth_timer = timer.push_back("groundtruth");
+        auto groundtruth = exhaustive.search(queries, NumNeighbors, filter);
+        groundtruth_timer.finish();
+
+        for (auto sws : search_window_sizes) {
+            for (bool filtered : {false, true}) {
+                auto label = fmt::format(
+                    "search (selectivity = {}, sws = {}, filtered = {})",
+                    selectivity,
+                    sws,
+                    filtered
+                );
+                auto result = svs::QueryResult<size_t>(queries.size(), NumNeighbors);
+                auto overfetched =
+                    svs::QueryResult<size_t>(queries.size(), OverFetch * NumNeighbors);
+                auto run = [&]() {
+                    if (filtered) {
+                        index.set_search_window_size(sws);
+                        index.search(queries, NumNeighbors, result.view(), filter);
+                    } else {
+                        index.set_search_window_size(OverFetch * sws);
+                        index.search(
+                            queries, OverFetch * NumNeighbors, overfetched.view()
+                        );
+                        post_filter(overfetched, filter, result);
+                    }
+                };
+
+                // Warm up to avoid measuring first touch page faults.
+                run();
+                auto total = timer.push_back(label);
+                for (size_t j = 0; j < nloops; ++j) {
+                    run();
+                }
+                double elapsed = svs::lib::as_seconds(total.finish());
+                results.push_back(
+                    {selectivity,
+                     sws,
+                     filtered,
+                     (nloops * queries.size()) / elapsed,
+                     svs::k_recall_at_n(groundtruth, result, NumNeighbors, NumNeighbors)}
+                );
+            }
+        }
+    }
+
+    fmt::print("RESULTS\n");
+    for (const auto& result : results) {
+        fmt::print("{}\n", result);
+    }
+    fmt::print("TIMINGS\n");
+    timer.print();
+    return 0;
+}
+
+SVS_DEFINE_MAIN();
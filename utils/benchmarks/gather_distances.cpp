@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/distance/gather.h"
+#include "svs/lib/timing.h"
+#include "svs/third-party/fmt.h"
+
+#include "svsmain.h"
+
+// stl
+#include <random>
+#include <span>
+#include <vector>
+
+// Compile-time Settings
+using Eltype = float;
+inline constexpr auto global_distance = svs::distance::DistanceL2();
+// The number of adjacency lists scored for each configuration.
+const size_t NumLists = 200'000;
+
+namespace {
+
+struct BenchmarkResult {
+    size_t max_degree;
+    bool gathered;
+    double ns_per_distance;
+};
+
+const std::string HELP =
+    R"(
+   benchmark_gather_distances num_elements dimensions
+
+Compare scoring adjacency lists one neighbor at a time with the batched gather kernel for
+graph degrees of 32, 64 and 128. The dataset is random float32 data with `num_elements`
+vectors of `dimensions` components, compared using the L2 distance. Choose `num_elements`
+to make the dataset fit in cache or not.
+)";
+
+} // namespace
+
+template <> struct fmt::formatter<BenchmarkResult> : svs::format_empty {
+    auto format(const auto& x, auto& ctx) const {
+        return fmt::format_to(
+            ctx.out(),
+            "{{ max_degree = {}, gathered = {}, ns_per_distance = {} }}",
+            x.max_degree,
+            x.gathered,
+            x.ns_per_distance
+        );
+    }
+};
+
+int svs_main(std::vector<std::string> args) {
+    if (args.size() != 3) {
+        std::cout << HELP << std::endl;
+        return 1;
+    }
+
+    size_t i = 1;
+    auto num_elements = std::stoull(args.at(i++));
+    auto dimensions = std::stoull(args.at(i++));
+
+    auto rng = std::mt19937_64(0xc0ffee);
+    auto values = std::uniform_real_distribution<Eltype>(-1, 1);
+    auto data = svs::data::SimpleData<Eltype>(num_elements, dimensions);
+    auto buffer = std::vector<Eltype>(dimensions);
+    for (size_t j = 0; j < num_elements; ++j) {
+        for (auto& x : buffer) {
+            x = values(rng);
+        }
+        data.set_datum(j, buffer);
+    }
+    auto query = data.get_datum(0);
+
+    auto timer = svs::lib::Timer();
+    auto results = std::vector<BenchmarkResult>();
+    auto distance = global_distance;
+    for (size_t max_degree : {32, 64, 128}) {
+        auto ids_dist = std::uniform_int_distribution<uint32_t>(0, num_elements - 1);
+        auto adjacency = std::vector<uint32_t>(NumLists * max_degree);
+        for (auto& id : adjacency) {
+            id = ids_dist(rng);
+        }
+        auto distances = std::vector<float>(max_degree);
+
+        for (bool gathered : {false, true}) {
+            auto run = [&]() {
+                float checksum = 0;
+                for (size_t list = 0; list < NumLists; ++list) {
+                    auto ids = std::span<const uint32_t>(
+                        adjacency.data() + list * max_degree, max_degree
+                    );
+                    if (gathered) {
+                        svs::distance::compute_gathered(
+                            distance,
+                            query,
+                            data,
+                            ids,
+                            std::span<float>(distances),
+                            svs::data::fast_access
+                        );
+                    } else {
+                        for (size_t k = 0; k < max_degree; ++k) {
+                            distances[k] = svs::distance::compute(
+                                distance,
+                                query,
+                                data.get_datum(ids[k], svs::data::fast_access)
+                            );
+                        }
+                    }
+                    checksum += distances.back();
+                }
+                return checksum;
+            };
+
+            // Warm up to avoid measuring first touch page faults.
+            float checksum = run();
+            auto label =
+                fmt::format("score (max_degree = {}, gathered = {})", max_degree, gathered);
+            auto total = timer.push_back(label);
+            checksum += run();
+            double elapsed = svs::lib::as_seconds(total.finish());
+            if (checksum == 0) {
+                fmt::print("Unlikely checksum!\n");
+            }
+            results.push_back({max_degree, gathered, 1e9 * elapsed / adjacency.size()});
+        }
+    }
+
+    fmt::print("RESULTS\n");
+    for (const auto& result : results) {
+        fmt::print("{}\n", result);
+    }
+    fmt::print("TIMINGS\n");
+    timer.print();
+    return 0;
+}
+
+SVS_DEFINE_MAIN();
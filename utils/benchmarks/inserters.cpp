@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include "svs/index/flat/inserters.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/timing.h"
+#include "svs/third-party/fmt.h"
+
+#include "svsmain.h"
+
+#include <numeric>
+#include <random>
+
+namespace {
+
+using Neighbor = svs::Neighbor<size_t>;
+using Inserter = svs::index::flat::BulkInserter<Neighbor, std::less<>>;
+using svs::index::flat::InserterKind;
+
+struct BenchmarkResult {
+    size_t num_neighbors;
+    InserterKind kind;
+    bool batched;
+    // Millions of candidates processed per second.
+    double throughput;
+};
+
+std::string_view name(InserterKind kind) {
+    switch (kind) {
+        case InserterKind::linear: {
+            return "linear";
+        }
+        case InserterKind::heap: {
+            return "heap";
+        }
+        case InserterKind::buffered: {
+            return "buffered";
+        }
+    }
+    throw ANNEXCEPTION("Unhandled inserter kind!");
+}
+
+const std::string HELP =
+    R"(
+   benchmark_inserters [num_queries] [num_candidates]
+
+Compare the throughput of the nearest neighbor maintenance strategies used by the flat
+index for k in {1, 10, 100, 1000}. Each of the `num_queries` (default 100) rows receives
+`num_candidates` (default 1000000) uniformly random distances, inserted either one at a
+time or in batches of 256.
+)";
+
+} // namespace
+
+template <> struct fmt::formatter<BenchmarkResult> : svs::format_empty {
+    auto format(const auto& x, auto& ctx) const {
+        return fmt::format_to(
+            ctx.out(),
+            "{{ k = {}, kind = {}, batched = {}, throughput (M/s) = {} }}",
+            x.num_neighbors,
+            name(x.kind),
+            x.batched,
+            x.throughput
+        );
+    }
+};
+
+int svs_main(std::vector<std::string> args) {
+    if (args.size() > 3) {
+        std::cout << HELP << std::endl;
+        return 1;
+    }
+    size_t num_queries = args.size() > 1 ? std::stoull(args.at(1)) : 100;
+    size_t num_candidates = args.size() > 2 ? std::stoull(args.at(2)) : 1'000'000;
+
+    // Candidates are shared across all rows.
+    auto distances = std::vector<float>(num_candidates);
+    auto ids = std::vector<size_t>(num_candidates);
+    auto engine = std::mt19937_64(0x5eed);
+    auto dist = std::uniform_real_distribution<float>(0, 1);
+    std::generate(distances.begin(), distances.end(), [&] { return dist(engine); });
+    std::iota(ids.begin(), ids.end(), 0);
+
+    const size_t batch_size = 256;
+    auto timer = svs::lib::Timer();
+    auto results = std::vector<BenchmarkResult>();
+    auto kinds = {InserterKind::linear, InserterKind::heap, InserterKind::buffered};
+    for (size_t k : {1, 10, 100, 1000}) {
+        for (auto kind : kinds) {
+            for (bool batched : {false, true}) {
+                auto inserter = Inserter(num_queries, k, std::less<>(), kind);
+                auto label =
+                    fmt::format("k = {}, {}, batched = {}", k, name(kind), batched);
+
+                auto total = timer.push_back(label);
+                inserter.prepare();
+                for (size_t q = 0; q < num_queries; ++q) {
+                    if (batched) {
+                        for (size_t j = 0; j < num_candidates; j += batch_size) {
+                            size_t count = std::min(batch_size, num_candidates - j);
+                            inserter.insert(
+                                q,
+                                std::span<const size_t>(ids.data() + j, count),
+                                std::span<const float>(distances.data() + j, count)
+                            );
+                        }
+                    } else {
+                        for (size_t j = 0; j < num_candidates; ++j) {
+                            inserter.insert(q, {ids[j], distances[j]});
+                        }
+                    }
+                }
+                inserter.cleanup();
+                double elapsed = svs::lib::as_seconds(total.finish());
+                double throughput = (num_queries * num_candidates) / elapsed / 1e6;
+                results.push_back({k, kind, batched, throughput});
+            }
+        }
+    }
+
+    fmt::print("RESULTS\n");
+    for (const auto& result : results) {
+        fmt::print("{}\n", result);
+    }
+    fmt::print("TIMINGS\n");
+    timer.print();
+    return 0;
+}
+
+SVS_DEFINE_MAIN();
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include "svs/core/recall.h"
+#include "svs/index/vamana/index.h"
+#include "svs/lib/timing.h"
+#include "svs/third-party/fmt.h"
+
+#include "svsmain.h"
+
+// Compile-time Settings
+using Eltype = float;
+using QueryEltype = float;
+inline constexpr auto global_distance = svs::distance::DistanceL2();
+const size_t NumNeighbors = 10;
+
+namespace {
+
+struct BenchmarkResult {
+    size_t search_window_size;
+    bool visited_set;
+    double qps;
+    double recall;
+};
+
+const std::string HELP =
+    R"(
+   benchmark_visited_set config graph data queries groundtruth num_threads
+
+Compare graph search throughput with the visited set disabled and enabled over a range of
+search window sizes. Data is expected to be stored as float32 and compared using the
+L2 distance.
+)";
+
+} // namespace
+
+template <> struct fmt::formatter<BenchmarkResult> : svs::format_empty {
+    auto format(const auto& x, auto& ctx) const {
+        return fmt::format_to(
+            ctx.out(),
+            "{{ sws = {}, visited_set = {}, qps = {}, recall = {} }}",
+            x.search_window_size,
+            x.visited_set,
+            x.qps,
+            x.recall
+        );
+    }
+};
+
+int svs_main(std::vector<std::string> args) {
+    if (args.size() != 7) {
+        std::cout << HELP << std::endl;
+        return 1;
+    }
+
+    size_t i = 1;
+    const auto& config_path = args.at(i++);
+    const auto& graph_path = args.at(i++);
+    const auto& data_path = args.at(i++);
+    const auto& query_path = args.at(i++);
+    const auto& groundtruth_path = args.at(i++);
+    auto num_threads = std::stoull(args.at(i++));
+
+    auto timer = svs::lib::Timer();
+    auto load_timer = timer.push_back("loading");
+    auto queries = svs::io::auto_load<QueryEltype>(query_path);
+    auto groundtruth = svs::io::auto_load<uint32_t>(groundtruth_path);
+    auto index = svs::index::vamana::auto_assemble(
+        config_path,
+        svs::GraphLoader(graph_path),
+        svs::VectorDataLoader<Eltype>(data_path),
+        global_distance,
+        num_threads
+    );
+    load_timer.finish();
+
+    auto search_window_sizes = std::vector<size_t>{10, 20, 40, 80, 160};
+    auto results = std::vector<BenchmarkResult>();
+    const size_t nloops = 5;
+    for (auto sws : search_window_sizes) {
+        index.set_search_window_size(sws);
+        for (bool visited_set : {false, true}) {
+            visited_set ? index.enable_visited_set() : index.disable_visited_set();
+            auto label = fmt::format("search (sws = {}, visited = {})", sws, visited_set);
+
+            // Warm up to avoid measuring first touch page faults.
+            auto query_result = index.search(queries, NumNeighbors);
+            auto total = timer.push_back(label);
+            for (size_t j = 0; j < nloops; ++j) {
+                query_result = index.search(queries, NumNeighbors);
+            }
+            double elapsed = svs::lib::as_seconds(total.finish());
+            double qps = (nloops * queries.size()) / elapsed;
+            double recall =
+                svs::k_recall_at_n(groundtruth, query_result, NumNeighbors, NumNeighbors);
+            results.push_back({sws, visited_set, qps, recall});
+        }
+    }
+
+    fmt::print("RESULTS\n");
+    for (const auto& result : results) {
+        fmt::print("{}\n", result);
+    }
+    fmt::print("TIMINGS\n");
+    timer.print();
+    return 0;
+}
+
+SVS_DEFINE_MAIN();
@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include "svs/core/recall.h"
+#include "svs/index/vamana/index.h"
+#include "svs/lib/timing.h"
+#include "svs/third-party/fmt.h"
+
+#include "svsmain.h"
+
+// stl
+#include <algorithm>
+
+// Compile-time Settings
+using Eltype = float;
+using QueryEltype = float;
+inline constexpr auto global_distance = svs::distance::DistanceL2();
+const size_t NumNeighbors = 10;
+
+namespace {
+
+struct BenchmarkResult {
+    size_t search_window_size;
+    bool work_stealing;
+    double qps;
+    // Batch latencies in milliseconds.
+    double p50;
+    double p99;
+    double max;
+};
+
+const std::string HELP =
+    R"(
+   benchmark_work_stealing config graph data queries num_threads batch_size
+
+Compare the distribution of batch search times when queries are divided evenly between
+threads up front and when threads steal work from each other. Queries are issued in
+batches of `batch_size`. Data is expected to be stored as float32 and compared using the
+L2 distance.
+)";
+
+// Return the `q`-th quantile of the sorted values `x`.
+double quantile(const std::vector<double>& x, double q) {
+    auto i = static_cast<size_t>(q * static_cast<double>(x.size() - 1));
+    return x.at(i);
+}
+
+} // namespace
+
+template <> struct fmt::formatter<BenchmarkResult> : svs::format_empty {
+    auto format(const auto& x, auto& ctx) const {
+        return fmt::format_to(
+            ctx.out(),
+            "{{ sws = {}, work_stealing = {}, qps = {}, "
+            "p50 = {}ms, p99 = {}ms, max = {}ms }}",
+            x.search_window_size,
+            x.work_stealing,
+            x.qps,
+            x.p50,
+            x.p99,
+            x.max
+        );
+    }
+};
+
+int svs_main(std::vector<std::string> args) {
+    if (args.size() != 7) {
+        std::cout << HELP << std::endl;
+        return 1;
+    }
+
+    size_t i = 1;
+    const auto& config_path = args.at(i++);
+    const auto& graph_path = args.at(i++);
+    const auto& data_path = args.at(i++);
+    const auto& query_path = args.at(i++);
+    auto num_threads = std::stoull(args.at(i++));
+    size_t batch_size = std::stoull(args.at(i++));
+    if (batch_size == 0) {
+        throw ANNEXCEPTION("Batch size must be positive!");
+    }
+
+    auto timer = svs::lib::Timer();
+    auto load_timer = timer.push_back("loading");
+    auto queries = svs::io::auto_load<QueryEltype>(query_path);
+    auto index = svs::index::vamana::auto_assemble(
+        config_path,
+        svs::GraphLoader(graph_path),
+        svs::VectorDataLoader<Eltype>(data_path),
+        global_distance,
+        num_threads
+    );
+    load_timer.finish();
+
+    // Split the queries into batches.
+    auto batches = std::vector<svs::data::SimpleData<QueryEltype>>();
+    for (size_t start = 0; start < queries.size(); start += batch_size) {
+        size_t stop = std::min(start + batch_size, queries.size());
+        auto& batch = batches.emplace_back(stop - start, queries.dimensions());
+        for (size_t j = start; j < stop; ++j) {
+            batch.set_datum(j - start, queries.get_datum(j));
+        }
+    }
+
+    auto search_window_sizes = std::vector<size_t>{20, 40, 80, 160};
+    auto results = std::vector<BenchmarkResult>();
+    const size_t nloops = 5;
+    for (auto sws : search_window_sizes) {
+        index.set_search_window_size(sws);
+        for (bool work_stealing : {false, true}) {
+            index.set_work_stealing(work_stealing);
+            auto label =
+                fmt::format("search (sws = {}, stealing = {})", sws, work_stealing);
+
+            // Warm up to avoid measuring first touch page faults.
+            for (const auto& batch : batches) {
+                index.search(batch, NumNeighbors);
+            }
+
+            auto latencies = std::vector<double>();
+            auto total = timer.push_back(label);
+            for (size_t j = 0; j < nloops; ++j) {
+                for (const auto& batch : batches) {
+                    auto tic = svs::lib::now();
+                    index.search(batch, NumNeighbors);
+                    latencies.push_back(1000 * svs::lib::time_difference(tic));
+                }
+            }
+            double elapsed = svs::lib::as_seconds(total.finish());
+            std::sort(latencies.begin(), latencies.end());
+            results.push_back(
+                {sws,
+                 work_stealing,
+                 (nloops * queries.size()) / elapsed,
+                 quantile(latencies, 0.5),
+                 quantile(latencies, 0.99),
+                 latencies.back()}
+            );
+        }
+    }
+
+    fmt::print("RESULTS\n");
+    for (const auto& result : results) {
+        fmt::print("{}\n", result);
+    }
+    fmt::print("TIMINGS\n");
+    timer.print();
+    return 0;
+}
+
+SVS_DEFINE_MAIN();
@@ -0,0 +1,211 @@
+/**
+ *    Copyright (C) 2023-present, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs
+#include "svs/core/graph/reorder.h"
+#include "svs/index/vamana/dynamic_index.h"
+
+// svsmain
+#include "svsmain.h"
+
+// format
+#include "fmt/core.h"
+
+// stl
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using ReorderFunction = std::function<void(
+    const std::filesystem::path&,
+    const std::filesystem::path&,
+    const std::filesystem::path&,
+    const std::filesystem::path&,
+    const std::filesystem::path&,
+    const std::filesystem::path&,
+    svs::graphs::VertexOrder,
+    size_t,
+    const std::string&,
+    const std::filesystem::path&
+)>;
+
+template <typename T>
+void reorder_index(
+    const std::filesystem::path& config_directory,
+    const std::filesystem::path& graph_directory,
+    const std::filesystem::path& data_directory,
+    const std::filesystem::path& output_config_directory,
+    const std::filesystem::path& output_graph_directory,
+    const std::filesystem::path& output_data_directory,
+    svs::graphs::VertexOrder order,
+    size_t num_threads,
+    const std::string& format,
+    const std::filesystem::path& translation_directory
+) {
+    using Idx = uint32_t;
+    if (format != "static" && format != "dynamic") {
+        throw ANNEXCEPTION("Unknown output format ", format, '!');
+    }
+
+    auto tic = std::chrono::steady_clock::now();
+    auto parameters =
+        svs::lib::load<svs::index::vamana::VamanaConfigParameters>(config_directory);
+    auto graph = svs::GraphLoader<Idx>(graph_directory).load();
+    auto data = svs::VectorDataLoader<T>(data_directory).load();
+    auto threadpool = svs::threads::NativeThreadPool(num_threads);
+
+    // Traversal starts from the primary entry point, followed by any additional ones.
+    auto entry_points = std::vector<size_t>{parameters.entry_point};
+    entry_points.insert(
+        entry_points.end(), parameters.entry_points.begin(), parameters.entry_points.end()
+    );
+    auto update_parameters = [&](const auto& new_entry_points) {
+        parameters.entry_point = new_entry_points.front();
+        parameters.entry_points.assign(
+            new_entry_points.begin() + 1, new_entry_points.end()
+        );
+    };
+    auto report = [&](const auto& new_graph) {
+        auto toc = std::chrono::steady_clock::now();
+        fmt::print(
+            "Reordered with the {} order in {}s\n",
+            svs::graphs::vertex_order_name(order),
+            std::chrono::duration<double>(toc - tic).count()
+        );
+        fmt::print("Mean edge span before: {}\n", svs::graphs::mean_edge_span(graph));
+        fmt::print("Mean edge span after: {}\n", svs::graphs::mean_edge_span(new_graph));
+    };
+
+    if (format == "static") {
+        auto reordered =
+            svs::graphs::reorder(graph, data, entry_points, order, threadpool);
+        report(reordered.graph);
+        update_parameters(reordered.entry_points);
+        svs::lib::save(parameters, output_config_directory);
+        svs::lib::save(reordered.graph, output_graph_directory);
+        svs::lib::save(reordered.data, output_data_directory);
+        svs::lib::save(reordered.translator, translation_directory);
+    } else {
+        auto reordered = svs::graphs::reorder(
+            graph,
+            data,
+            entry_points,
+            order,
+            svs::graphs::SimpleBlockedGraph<Idx>(graph.max_degree(), graph.n_nodes()),
+            svs::data::BlockedData<T>(data.size(), data.dimensions()),
+            threadpool
+        );
+        report(reordered.graph);
+        update_parameters(reordered.entry_points);
+        // The distance function is not part of the saved index, so any choice works.
+        auto index = svs::index::vamana::MutableVamanaIndex<
+            svs::graphs::SimpleBlockedGraph<Idx>,
+            svs::data::BlockedData<T>,
+            svs::distance::DistanceL2>(
+            parameters,
+            std::move(reordered.data),
+            std::move(reordered.graph),
+            svs::distance::DistanceL2(),
+            std::move(reordered.translator),
+            num_threads
+        );
+        index.save(output_config_directory, output_graph_directory, output_data_directory);
+    }
+    auto toc = std::chrono::steady_clock::now();
+    fmt::print("Total time: {}s\n", std::chrono::duration<double>(toc - tic).count());
+}
+
+const std::string HELP =
+    R"(
+Renumber the vertices of a static Vamana index so that neighbors receive nearby IDs,
+improving the memory locality of graph search.
+
+The reordered index can be saved in one of two formats:
+
+* static: A static Vamana index, loadable with `auto_assemble` (or `Vamana::assemble`).
+  Searches return the new IDs. The ID translation back to the original IDs is saved to
+  the translation directory and can be loaded as an `IDTranslator`.
+* dynamic: A dynamic Vamana index, loadable with `auto_dynamic_assemble` (or
+  `DynamicVamana::assemble`). The ID translation is saved with the index, so searches
+  return the original IDs.
+
+The required arguments are as follows:
+
+(1) Data Element Type (string). Options: (int8, uint8, float, float16)
+(2) Config directory of the original index.
+(3) Graph directory of the original index.
+(4) Data directory of the original index.
+(5) Config directory for saving.
+(6) Graph directory for saving.
+(7) Data directory for saving.
+(8) Vertex order (string). Options: (bfs, rcm)
+(9) Number of threads (integer).
+(10) Output format (string). Options: (static, dynamic)
+(11) Translation directory for saving. Required for the static format only.
+)";
+
+int svs_main(std::vector<std::string> args) {
+    const bool is_static = args.size() > 10 && args[10] == "static";
+    const size_t expected_args = is_static ? 12 : 11;
+    if (args.size() != expected_args) {
+        fmt::print(
+            "Expected {} arguments. Instead, got {}. The required positional arguments are "
+            "given below.\n{}\n",
+            expected_args - 1,
+            args.size() - 1,
+            HELP
+        );
+        return 1;
+    }
+
+    size_t i = 1;
+    const auto& data_type(args[i++]);
+    const auto& config_directory(args[i++]);
+    const auto& graph_directory(args[i++]);
+    const auto& data_directory(args[i++]);
+    const auto& output_config_directory(args[i++]);
+    const auto& output_graph_directory(args[i++]);
+    const auto& output_data_directory(args[i++]);
+    const auto order = svs::graphs::parse_vertex_order(args[i++]);
+    const size_t num_threads = std::stoull(args[i++]);
+    const auto& format(args[i++]);
+    const auto translation_directory =
+        is_static ? std::filesystem::path(args[i++]) : std::filesystem::path();
+
+    const auto dispatcher = std::unordered_map<std::string, ReorderFunction>{
+        {"int8", reorder_index<int8_t>},
+        {"uint8", reorder_index<uint8_t>},
+        {"float", reorder_index<float>},
+        {"float16", reorder_index<svs::Float16>}};
+
+    auto it = dispatcher.find(data_type);
+    if (it == dispatcher.end()) {
+        throw ANNEXCEPTION("Unsupported data type: ", data_type, '.');
+    }
+    it->second(
+        config_directory,
+        graph_directory,
+        data_directory,
+        output_config_directory,
+        output_graph_directory,
+        output_data_directory,
+        order,
+        num_threads,
+        format,
+        translation_directory
+    );
+    return 0;
+}
+
+SVS_DEFINE_MAIN();